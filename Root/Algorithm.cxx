@@ -1,5 +1,8 @@
 #include <xAODAnaHelpers/Algorithm.h>
 
+// EL include(s):
+#include <EventLoop/Worker.h>
+
 // RCU include for throwing an exception+message
 #include <RootCoreUtils/ThrowMsg.h>
 
@@ -41,6 +44,10 @@ StatusCode xAH::Algorithm::algFinalize(){
     return StatusCode::SUCCESS;
 }
 
+std::string xAH::Algorithm::declaredInputs() const {
+    return "*";
+}
+
 StatusCode xAH::Algorithm::parseSystValVector(){
 
     std::stringstream ss(m_systValVectorString);
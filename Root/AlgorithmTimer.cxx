@@ -0,0 +1,181 @@
+// EL include(s):
+#include <EventLoop/Job.h>
+#include <EventLoop/Worker.h>
+#include "EventLoop/OutputStream.h"
+
+#include <xAODAnaHelpers/AlgorithmTimer.h>
+
+// ROOT include(s):
+#include <TFile.h>
+#include <TTree.h>
+
+// this is needed to distribute the algorithm to the workers
+ClassImp(AlgorithmTimer)
+
+xAH::TimingRegistry::clock::time_point AlgorithmTimer::s_executeMark;
+xAH::TimingRegistry::clock::time_point AlgorithmTimer::s_postExecuteMark;
+unsigned long long AlgorithmTimer::s_nEvents = 0;
+bool   AlgorithmTimer::s_sampleEvent = false;
+double AlgorithmTimer::s_heapMark = 0.;
+double AlgorithmTimer::s_eventHeapStart = 0.;
+
+AlgorithmTimer :: AlgorithmTimer () :
+    Algorithm("AlgorithmTimer")
+{
+}
+
+
+EL::StatusCode AlgorithmTimer :: setupJob (EL::Job& job)
+{
+  job.useXAOD();
+  xAOD::Init("AlgorithmTimer").ignore(); // call before opening first file
+
+  if ( m_doMemory && m_writeSummary && !m_cutFlowStreamName.empty() ) {
+    EL::OutputStream outForCFlow(m_cutFlowStreamName);
+    if(!job.outputHas(m_cutFlowStreamName) ){ job.outputAdd ( outForCFlow ); }
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode AlgorithmTimer :: histInitialize ()
+{
+  ANA_CHECK( xAH::Algorithm::algInitialize());
+  if ( m_doMemory ) this->accountHeap( "histInitialize" );
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode AlgorithmTimer :: fileExecute () { return EL::StatusCode::SUCCESS; }
+EL::StatusCode AlgorithmTimer :: changeInput (bool /*firstFile*/) { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode AlgorithmTimer :: initialize ()
+{
+  if ( m_doTiming ) {
+    xAH::TimingRegistry::enable();
+
+    if ( !m_timedAlgorithm.empty() ) {
+      ANA_MSG_DEBUG( "Timing algorithm " << m_timedAlgorithm );
+      m_executeStats     = xAH::TimingRegistry::stats( m_timedAlgorithm, "execute" );
+      m_postExecuteStats = xAH::TimingRegistry::stats( m_timedAlgorithm, "postExecute" );
+    }
+  }
+
+  if ( m_doMemory ) {
+    if ( m_memorySampleInterval < 1 ) {
+      ANA_MSG_ERROR( "m_memorySampleInterval must be positive, got " << m_memorySampleInterval );
+      return EL::StatusCode::FAILURE;
+    }
+    if ( !m_timedAlgorithm.empty() ) m_executeMemory = xAH::MemoryRegistry::entry( m_timedAlgorithm, "execute" );
+    this->accountHeap( "initialize" );
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode AlgorithmTimer :: execute ()
+{
+  const auto now = xAH::TimingRegistry::clock::now();
+  if ( m_executeStats ) m_executeStats->add( std::chrono::duration<double>( now - s_executeMark ).count() );
+
+  if ( m_doMemory ) {
+    // the first probe of the sequence decides whether the event is sampled
+    if ( m_timedAlgorithm.empty() ) { s_sampleEvent = ( s_nEvents++ % m_memorySampleInterval == 0 ); }
+
+    if ( s_sampleEvent ) {
+      const double heap = xAH::MemoryRegistry::heapInUse();
+      if ( m_timedAlgorithm.empty() ) { s_eventHeapStart = heap; }
+      else                            { xAH::MemoryRegistry::add( m_executeMemory, heap - s_heapMark ); }
+
+      if ( m_writeSummary ) {
+        xAH::MemoryRegistry::EventSample sample;
+        sample.event     = s_nEvents - 1;
+        sample.rss       = xAH::MemoryRegistry::rss();
+        sample.heap      = heap;
+        sample.storeHeap = heap - s_eventHeapStart;
+        xAH::MemoryRegistry::addEvent( sample );
+      }
+      s_heapMark = xAH::MemoryRegistry::heapInUse();
+    }
+  }
+
+  s_executeMark = xAH::TimingRegistry::clock::now();
+  if ( m_doTiming ) xAH::TimingRegistry::overhead().add( std::chrono::duration<double>( s_executeMark - now ).count() );
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode AlgorithmTimer :: postExecute ()
+{
+  const auto now = xAH::TimingRegistry::clock::now();
+  if ( m_postExecuteStats ) m_postExecuteStats->add( std::chrono::duration<double>( now - s_postExecuteMark ).count() );
+  s_postExecuteMark = xAH::TimingRegistry::clock::now();
+  if ( m_doTiming ) xAH::TimingRegistry::overhead().add( std::chrono::duration<double>( s_postExecuteMark - now ).count() );
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode AlgorithmTimer :: finalize ()
+{
+  if ( !m_writeSummary ) return EL::StatusCode::SUCCESS;
+
+  if ( m_doTiming ) {
+    ANA_MSG_INFO( "Time spent per event in each algorithm:\n" << xAH::TimingRegistry::summary() );
+
+    TTree* timingTree = new TTree( "xAH_timing", "time spent per event in each algorithm [s]" );
+    timingTree->SetDirectory( nullptr ); // kept in memory until written in the histogram output
+    xAH::TimingRegistry::fillTree( timingTree );
+    wk()->addOutput( timingTree );
+
+    if ( !m_jsonFile.empty() ) {
+      if ( xAH::TimingRegistry::writeJSON( m_jsonFile ) ) {
+        ANA_MSG_INFO( "Timing summary written to " << m_jsonFile );
+      } else {
+        ANA_MSG_WARNING( "Could not write the timing summary to " << m_jsonFile );
+      }
+    }
+  }
+
+  if ( m_doMemory ) {
+    ANA_MSG_INFO( "Heap allocated by each algorithm:\n" << xAH::MemoryRegistry::summary() );
+
+    // write the memory summary together with the cutflow
+    TFile *fileCF = ( m_cutFlowStreamName.empty() ) ? nullptr : wk()->getOutputFile( m_cutFlowStreamName );
+
+    TTree* memoryTree = new TTree( "xAH_memory", "heap allocated by each algorithm [B]" );
+    xAH::MemoryRegistry::fillTree( memoryTree );
+    TTree* memoryEventTree = new TTree( "xAH_memory_events", "memory usage in the sampled events [B]" );
+    xAH::MemoryRegistry::fillEventTree( memoryEventTree );
+
+    if ( fileCF ) {
+      memoryTree->SetDirectory( fileCF );
+      memoryEventTree->SetDirectory( fileCF );
+    } else {
+      memoryTree->SetDirectory( nullptr );
+      memoryEventTree->SetDirectory( nullptr );
+      wk()->addOutput( memoryTree );
+      wk()->addOutput( memoryEventTree );
+    }
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+void AlgorithmTimer :: accountHeap( const std::string& step )
+{
+  const double heap = xAH::MemoryRegistry::heapInUse();
+  if ( !m_timedAlgorithm.empty() ) {
+    xAH::MemoryRegistry::add( xAH::MemoryRegistry::entry( m_timedAlgorithm, step ), heap - s_heapMark );
+  }
+  s_heapMark = xAH::MemoryRegistry::heapInUse();
+}
+
+EL::StatusCode AlgorithmTimer :: histFinalize ()
+{
+  ANA_CHECK( xAH::Algorithm::algFinalize());
+  return EL::StatusCode::SUCCESS;
+}
+
+std::string AlgorithmTimer :: declaredInputs () const
+{
+  return "";
+}
@@ -459,3 +459,8 @@ EL::StatusCode BJetEfficiencyCorrector :: histFinalize ()
 
   return EL::StatusCode::SUCCESS;
 }
+
+std::string BJetEfficiencyCorrector :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " BTagging_*";
+}
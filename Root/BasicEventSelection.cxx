@@ -1,3 +1,6 @@
+// c++ include(s):
+#include <algorithm>
+
 // EL include(s):
 #include <EventLoop/Job.h>
 #include <EventLoop/Worker.h>
@@ -27,6 +30,7 @@
 #include "TTree.h"
 #include "TTreeFormula.h"
 #include "TSystem.h"
+#include "TString.h"
 #include "xAODCore/tools/IOStats.h"
 #include "xAODCore/tools/ReadStats.h"
 
@@ -67,6 +71,11 @@ EL::StatusCode BasicEventSelection :: setupJob (EL::Job& job)
   EL::OutputStream outForDuplicates(m_duplicatesStreamName);
   if(!job.outputHas(m_duplicatesStreamName) ){ job.outputAdd ( outForDuplicates ); }
 
+  if ( m_writeEventIndex ) {
+    EL::OutputStream outForEventIndex(m_eventIndexStreamName);
+    if(!job.outputHas(m_eventIndexStreamName) ){ job.outputAdd ( outForEventIndex ); }
+  }
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -315,6 +324,14 @@ EL::StatusCode BasicEventSelection :: changeInput (bool /*firstFile*/)
   // Here you do everything you need to do when we change input files,
   // e.g. resetting branch addresses on trees.  If you are using
   // D3PDReader or a similar service this method is not needed.
+
+  if ( m_writeEventIndex ) {
+    // the hash of the name identifies the file in indices merged from several jobs as well
+    const std::string fileName = wk()->inputFile()->GetName();
+    m_eventIndexFileId = TString(fileName).Hash();
+    m_eventIndexFiles[m_eventIndexFileId] = fileName;
+  }
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -658,6 +675,10 @@ EL::StatusCode BasicEventSelection :: execute ()
   const xAOD::EventInfo* eventInfo(nullptr);
   ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
 
+  if ( m_writeEventIndex ) {
+    m_eventIndex.push_back( { eventInfo->runNumber(), eventInfo->eventNumber(), m_eventIndexFileId, wk()->treeEntry() } );
+  }
+
   //------------------------------------------------------------------------------------------
   // Declare an 'eventInfo' decorator with the MC event weight
   //------------------------------------------------------------------------------------------
@@ -1232,6 +1253,49 @@ StatusCode BasicEventSelection::autoconfigurePileupRWTool()
 }
 
 
+StatusCode BasicEventSelection::writeEventIndex()
+{
+  std::sort( m_eventIndex.begin(), m_eventIndex.end() );
+
+  TFile *fileIndex = wk()->getOutputFile (m_eventIndexStreamName);
+  fileIndex->cd();
+
+  uint32_t runNumber(0), fileId(0);
+  unsigned long long eventNumber(0);
+  long long entry(0);
+  TTree* indexTree = new TTree("eventIndex", "Input file and entry of each event, sorted by run and event number");
+  indexTree->Branch("runNumber",   &runNumber,   "runNumber/i");
+  indexTree->Branch("eventNumber", &eventNumber, "eventNumber/l");
+  indexTree->Branch("fileId",      &fileId,      "fileId/i");
+  indexTree->Branch("entry",       &entry,       "entry/L");
+  for ( const auto& indexEntry : m_eventIndex ) {
+    runNumber   = indexEntry.runNumber;
+    eventNumber = indexEntry.eventNumber;
+    fileId      = indexEntry.fileId;
+    entry       = indexEntry.entry;
+    indexTree->Fill();
+  }
+  // the TTreeIndex is written out with the tree, for GetEntryWithIndex(runNumber, eventNumber)
+  indexTree->BuildIndex("runNumber", "eventNumber");
+
+  std::string fileName;
+  TTree* filesTree = new TTree("eventIndexFiles", "Input files of the event index");
+  filesTree->Branch("fileId",   &fileId);
+  filesTree->Branch("fileName", &fileName);
+  for ( const auto& file : m_eventIndexFiles ) {
+    fileId   = file.first;
+    fileName = file.second;
+    filesTree->Fill();
+  }
+
+  ANA_MSG_INFO( "Wrote the index of " << m_eventIndex.size() << " events in " << m_eventIndexFiles.size() << " files to " << m_eventIndexStreamName);
+  m_eventIndex.clear();
+  m_eventIndexFiles.clear();
+
+  return StatusCode::SUCCESS;
+}
+
+
 EL::StatusCode BasicEventSelection :: postExecute ()
 {
   // Here you do everything that needs to be done after the main event
@@ -1259,6 +1323,8 @@ EL::StatusCode BasicEventSelection :: finalize ()
 
   m_RunNr_VS_EvtNr.clear();
 
+  if ( m_writeEventIndex ) { ANA_CHECK( this->writeEventIndex() ); }
+
   if ( m_trigDecTool_handle.isInitialized() )  m_trigDecTool_handle->finalize();
 
   //after execution loop
@@ -1286,3 +1352,13 @@ EL::StatusCode BasicEventSelection :: histFinalize ()
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
+
+std::string BasicEventSelection :: declaredInputs () const
+{
+  std::string inputs = m_eventInfoContainerName + " " + m_vertexContainerName;
+  // the truth jets of the Sherpa 2.2 reweighting, turned on for the samples that need it
+  inputs += " AntiKt4TruthWZJets AntiKt4TruthJets";
+  if ( !m_triggerSelection.empty() || m_applyTriggerCut || m_storeTrigDecisions || m_storePassL1 || m_storePassHLT || m_storeTrigKeys )
+    inputs += HelperClasses::TriggerInfoSwitch("basic").inputs();
+  return inputs;
+}
@@ -84,3 +84,8 @@ EL::StatusCode ClusterHistsAlgo :: histFinalize ()
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
+
+std::string ClusterHistsAlgo :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName;
+}
@@ -178,6 +178,8 @@ EL::StatusCode ElectronCalibrator :: initialize ()
   m_systList = HelperFunctions::getListofSystematics( recSyst, m_systName, m_systVal, msg() );
 
   ANA_MSG_INFO("Will be using EgammaCalibrationAndSmearingTool systematic:");
+  this->setSystematicTimers( m_systList );
+
   std::vector< std::string >* SystElectronsNames = new std::vector< std::string >;
   for ( const auto& syst_it : m_systList ) {
     if ( m_systName.empty() ) {
@@ -244,7 +246,9 @@ EL::StatusCode ElectronCalibrator :: execute ()
   //
   std::vector< std::string >* vecOutContainerNames = new std::vector< std::string >;
 
-  for ( const auto& syst_it : m_systList ) {
+  for ( std::size_t iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
+    const auto& syst_it = m_systList[iSyst];
+    auto systTimer = this->timeSystematic( iSyst );
 
     // discard photon systematics
     //
@@ -395,3 +399,8 @@ EL::StatusCode ElectronCalibrator :: histFinalize ()
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
+
+std::string ElectronCalibrator :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " egamma*Clusters *TrackParticles *ConversionVertices";
+}
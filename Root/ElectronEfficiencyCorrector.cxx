@@ -953,3 +953,8 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF ( const xAOD::ElectronCo
 
   return EL::StatusCode::SUCCESS;
 }
+
+std::string ElectronEfficiencyCorrector :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " egamma*Clusters";
+}
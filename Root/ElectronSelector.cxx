@@ -146,39 +146,45 @@ EL::StatusCode ElectronSelector :: initialize ()
     // retrieve the object cutflow
     //
     m_el_cutflowHist_1 = (TH1D*)file->Get("cutflow_electrons_1");
-
-    m_el_cutflow_all             = m_el_cutflowHist_1->GetXaxis()->FindBin("all");
-    m_el_cutflow_author_cut      = m_el_cutflowHist_1->GetXaxis()->FindBin("author_cut");
-    m_el_cutflow_OQ_cut          = m_el_cutflowHist_1->GetXaxis()->FindBin("OQ_cut");
-    m_el_cutflow_ptmax_cut       = m_el_cutflowHist_1->GetXaxis()->FindBin("ptmax_cut");
-    m_el_cutflow_ptmin_cut       = m_el_cutflowHist_1->GetXaxis()->FindBin("ptmin_cut");
-    m_el_cutflow_eta_cut         = m_el_cutflowHist_1->GetXaxis()->FindBin("eta_cut"); // including crack veto, if applied
-    m_el_cutflow_z0sintheta_cut  = m_el_cutflowHist_1->GetXaxis()->FindBin("z0sintheta_cut");
-    m_el_cutflow_d0_cut          = m_el_cutflowHist_1->GetXaxis()->FindBin("d0_cut");
-    m_el_cutflow_d0sig_cut       = m_el_cutflowHist_1->GetXaxis()->FindBin("d0sig_cut");
-    m_el_cutflow_BL_cut          = m_el_cutflowHist_1->GetXaxis()->FindBin("BL_cut");
-    m_el_cutflow_PID_cut         = m_el_cutflowHist_1->GetXaxis()->FindBin("PID_cut");
-    m_el_cutflow_iso_cut         = m_el_cutflowHist_1->GetXaxis()->FindBin("iso_cut");
-
     if ( m_isUsedBefore ) {
       m_el_cutflowHist_2 = (TH1D*)file->Get("cutflow_electrons_2");
+    }
 
-      m_el_cutflow_all       = m_el_cutflowHist_2->GetXaxis()->FindBin("all");
-      m_el_cutflow_author_cut    = m_el_cutflowHist_2->GetXaxis()->FindBin("author_cut");
-      m_el_cutflow_OQ_cut    = m_el_cutflowHist_2->GetXaxis()->FindBin("OQ_cut");
-      m_el_cutflow_ptmax_cut     = m_el_cutflowHist_2->GetXaxis()->FindBin("ptmax_cut");
-      m_el_cutflow_ptmin_cut     = m_el_cutflowHist_2->GetXaxis()->FindBin("ptmin_cut");
-      m_el_cutflow_eta_cut     = m_el_cutflowHist_2->GetXaxis()->FindBin("eta_cut"); // including crack veto, if applied
-      m_el_cutflow_z0sintheta_cut  = m_el_cutflowHist_2->GetXaxis()->FindBin("z0sintheta_cut");
-      m_el_cutflow_d0_cut    = m_el_cutflowHist_2->GetXaxis()->FindBin("d0_cut");
-      m_el_cutflow_d0sig_cut     = m_el_cutflowHist_2->GetXaxis()->FindBin("d0sig_cut");
-      m_el_cutflow_BL_cut    = m_el_cutflowHist_2->GetXaxis()->FindBin("BL_cut");
-      m_el_cutflow_PID_cut     = m_el_cutflowHist_2->GetXaxis()->FindBin("PID_cut");
-      m_el_cutflow_iso_cut     = m_el_cutflowHist_2->GetXaxis()->FindBin("iso_cut");
+    // the counts go to the last histogram set (see xAH::CutflowCounter)
+    for ( TH1D* hist : { m_el_cutflowHist_1, m_el_cutflowHist_2 } ) {
+      if ( !hist ) continue;
+      m_el_cutflow.setHist( hist );
+      m_el_cutflow.bookBin( ElectronCut::all,        "all" );
+      m_el_cutflow.bookBin( ElectronCut::author,     "author_cut" );
+      m_el_cutflow.bookBin( ElectronCut::OQ,         "OQ_cut" );
+      m_el_cutflow.bookBin( ElectronCut::ptmax,      "ptmax_cut" );
+      m_el_cutflow.bookBin( ElectronCut::ptmin,      "ptmin_cut" );
+      m_el_cutflow.bookBin( ElectronCut::eta,        "eta_cut" ); // including crack veto, if applied
+      m_el_cutflow.bookBin( ElectronCut::z0sintheta, "z0sintheta_cut" );
+      m_el_cutflow.bookBin( ElectronCut::d0,         "d0_cut" );
+      m_el_cutflow.bookBin( ElectronCut::d0sig,      "d0sig_cut" );
+      m_el_cutflow.bookBin( ElectronCut::BL,         "BL_cut" );
+      m_el_cutflow.bookBin( ElectronCut::PID,        "PID_cut" );
+      m_el_cutflow.bookBin( ElectronCut::iso,        "iso_cut" );
     }
 
   }
 
+  // default order of the object cuts: they can be reordered only if no cutflow is filled (the cuts do not decorate the electron, see passCuts())
+  //
+  m_el_cutOrder.setOrder( { ElectronCut::author, ElectronCut::OQ, ElectronCut::ptmax, ElectronCut::ptmin, ElectronCut::eta,
+                            ElectronCut::z0sintheta, ElectronCut::d0, ElectronCut::d0sig, ElectronCut::BL, ElectronCut::PID, ElectronCut::iso },
+                          { "author_cut", "OQ_cut", "ptmax_cut", "ptmin_cut", "eta_cut",
+                            "z0sintheta_cut", "d0_cut", "d0sig_cut", "BL_cut", "PID_cut", "iso_cut" } );
+  if ( m_adaptiveCutOrder ) {
+    if ( m_useCutFlow ) {
+      ANA_MSG_WARNING( "m_adaptiveCutOrder is ignored when filling the cutflow: the cuts will be applied in the default order");
+    } else {
+      ANA_MSG_INFO( "Cuts will be reordered after " << m_nAdaptiveCutOrderEvents << " events to minimise the time spent per electron");
+      m_el_cutOrder.setLearningEvents( m_nAdaptiveCutOrderEvents );
+    }
+  }
+
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
 
@@ -262,6 +268,7 @@ EL::StatusCode ElectronSelector :: initialize ()
     } else {
       ANA_MSG_INFO( "Reading Electron cut-based ID from CP Tool ..." );
       ANA_CHECK( m_el_CutBased_PIDManager->setupWPs( true, this->m_name ));
+      if ( m_nestedPIDWPs ) { ANA_MSG_INFO( "\t Evaluating the cut-based WPs as nested: stop at the first failing WP" ); }
     }
   }// if m_doCutBasedPID
 
@@ -290,6 +297,7 @@ EL::StatusCode ElectronSelector :: initialize ()
     } else {
       ANA_MSG_INFO( "Reading Electron LH ID from CP Tool ..." );
       ANA_CHECK( m_el_LH_PIDManager->setupWPs( true, this->m_name));
+      if ( m_nestedPIDWPs ) { ANA_MSG_INFO( "\t Evaluating the LH WPs as nested: stop at the first failing WP" ); }
     }
   }// if m_doLHPID
 
@@ -402,6 +410,10 @@ EL::StatusCode ElectronSelector :: execute ()
 
   m_numEvent++;
 
+  if ( m_el_cutOrder.nextEvent() ) {
+    ANA_MSG_INFO( "Electron cuts reordered after " << m_numEvent << " events:\n" << m_el_cutOrder.summary() );
+  }
+
   // QUESTION: why this must be done in execute(), and does not work in initialize()?
   //
   if ( m_numEvent == 1 && m_trigDecTool_handle.isInitialized() ) {
@@ -453,7 +465,7 @@ EL::StatusCode ElectronSelector :: execute ()
 
     // find the selected electrons, and return if event passes object selection
     //
-    eventPass = executeSelection( inElectrons, mcEvtWeight, countPass, selectedElectrons );
+    eventPass = executeSelection( inElectrons, mcEvtWeight, countPass, selectedElectrons, eventInfo );
 
     if ( m_createSelectedContainer) {
       if ( eventPass ) {
@@ -494,7 +506,7 @@ EL::StatusCode ElectronSelector :: execute ()
 
       // find the selected electrons, and return if event passes object selection
       //
-      eventPassThisSyst = executeSelection( inElectrons, mcEvtWeight, countPass, selectedElectrons );
+      eventPassThisSyst = executeSelection( inElectrons, mcEvtWeight, countPass, selectedElectrons, eventInfo );
 
       if ( countPass ) { countPass = false; } // only count objects/events for 1st syst collection in iteration (i.e., nominal)
 
@@ -543,7 +555,7 @@ EL::StatusCode ElectronSelector :: execute ()
 }
 
 bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inElectrons, float mcEvtWeight, bool countPass,
-              ConstDataVector<xAOD::ElectronContainer>* selectedElectrons )
+              ConstDataVector<xAOD::ElectronContainer>* selectedElectrons, const xAOD::EventInfo* eventInfo )
 {
 
   const xAOD::VertexContainer* vertices(nullptr);
@@ -567,7 +579,7 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
     }
 
     nObj++;
-    bool passSel = this->passCuts( el_itr, pvx );
+    bool passSel = this->passCuts( el_itr, pvx, eventInfo );
     if ( m_decorateSelectedObjects ) {
       passSelDecor( *el_itr ) = passSel;
     }
@@ -661,9 +673,6 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
 
       ANA_MSG_DEBUG( "Doing di-electron trigger matching...");
 
-      const xAOD::EventInfo* eventInfo(nullptr);
-      ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
-
       typedef std::pair< std::pair<unsigned int,unsigned int>, char>     dielectron_trigmatch_pair;
       typedef std::multimap< std::string, dielectron_trigmatch_pair >    dielectron_trigmatch_pair_map;
       static SG::AuxElement::Decorator< dielectron_trigmatch_pair_map >  diElectronTrigMatchPairMapDecor( "diElectronTrigMatchPairMap" );
@@ -745,6 +754,7 @@ EL::StatusCode ElectronSelector :: finalize ()
     ANA_MSG_INFO( "Filling cutflow");
     m_cutflowHist ->SetBinContent( m_cutflow_bin, m_numEventPass        );
     m_cutflowHistW->SetBinContent( m_cutflow_bin, m_weightNumEventPass  );
+    m_el_cutflow.flush();
   }
 
   return EL::StatusCode::SUCCESS;
@@ -771,353 +781,422 @@ EL::StatusCode ElectronSelector :: histFinalize ()
   return EL::StatusCode::SUCCESS;
 }
 
-int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Vertex *primaryVertex ) {
+int ElectronSelector :: passCuts( const xAOD::Electron* electron, const xAOD::Vertex *primaryVertex, const xAOD::EventInfo* eventInfo ) {
+
+  // fill cutflow bin 'all' before any cut
+  if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::all );
+
+  // the decorations are set outside of the cuts, so that they do not depend on the order the cuts are applied in:
+  // the track variables on every electron before the cuts, the PID and isolation decisions on the selected electrons after them
+  //
+  this->decorateTrackVariables( electron, primaryVertex, eventInfo );
+  m_el_toolDecisions.clear();
+
+  // the cuts are applied in the default order, unless the adaptive ordering has been requested (and no cutflow is filled)
+  //
+  for ( auto cut : m_el_cutOrder.order() ) {
+    auto start = m_el_cutOrder.start();
+    bool pass  = this->applyCut( cut, electron );
+    m_el_cutOrder.record( cut, pass, start );
+    if ( !pass ) { return 0; }
+  }
+
+  for ( const auto& decision : m_el_toolDecisions ) {
+    ANA_MSG_DEBUG( "Decorating electron with " << decision.first << " : " << static_cast<int>( decision.second ) );
+    electron->auxdecor<char>( decision.first ) = decision.second;
+  }
+
+  return 1;
+}
+
+void ElectronSelector :: decorateTrackVariables( const xAOD::Electron* electron, const xAOD::Vertex *primaryVertex, const xAOD::EventInfo* eventInfo ) {
+
+  static SG::AuxElement::Decorator< float > z0sinthetaDecor("z0sintheta");
+  static SG::AuxElement::Decorator< float > d0SigDecor("d0sig");
+  static SG::AuxElement::Decorator< bool >  bLayerDecor("bLayerPass");
+
+  // set default values for *this* electron PID decorations
+  //
+  if ( m_doLHPID )       m_el_LH_PIDManager->setDecorations( electron );
+  if ( m_doCutBasedPID ) m_el_CutBased_PIDManager->setDecorations( electron );
+
+  m_el_track = TrackVariables();
+  const xAOD::TrackParticle* tp  = electron->trackParticle();
+  if ( !tp ) {
+    ANA_MSG_DEBUG("Electron has no TrackParticle. Won't be selected.");
+    return;
+  }
+  m_el_track.hasTrack = true;
+
+  // Take distance between z0 and zPV ( after referring the PV z coordinate to the beamspot position, given by vz() ), multiplied by sin(theta)
+  // see https://twiki.cern.ch/twiki/bin/view/AtlasProtected/InDetTrackingDC14 for further reference
+  //
+  if (primaryVertex) m_el_track.z0sintheta = ( tp->z0() + tp->vz() - primaryVertex->z() ) * sin( tp->theta() );
+  z0sinthetaDecor( *electron ) = m_el_track.z0sintheta;
+
+  m_el_track.d0sig = xAOD::TrackingHelpers::d0significance( tp, eventInfo->beamPosSigmaX(), eventInfo->beamPosSigmaY(), eventInfo->beamPosSigmaXY() );
+  d0SigDecor( *electron ) = m_el_track.d0sig;
+
+  // this is taken from ElectronPhotonSelectorTools/Root/AsgElectronLikelihoodTool.cxx
+  uint8_t expectBlayer(true);
+  uint8_t nBlayerHits(0);
+  uint8_t nBlayerOutliers(0);
+
+  tp->summaryValue(expectBlayer,    xAOD::expectBLayerHit);
+  tp->summaryValue(nBlayerHits,     xAOD::numberOfBLayerHits);
+  tp->summaryValue(nBlayerOutliers, xAOD::numberOfBLayerOutliers);
 
-  float et    = electron->pt();
+  m_el_track.bLayerPass = expectBlayer && (nBlayerHits+nBlayerOutliers) >= 1;
+  bLayerDecor( *electron ) = m_el_track.bLayerPass;
+}
+
+bool ElectronSelector :: applyCut( ElectronCut cut, const xAOD::Electron* electron ) {
 
   // all the eta cuts are done using the measurement of the cluster position with the 2nd layer cluster,
   // as for Egamma CP  recommendation
   //
-  float eta   = ( electron->caloCluster() ) ? electron->caloCluster()->etaBE(2) : -999.0;
-
-  // fill cutflow bin 'all' before any cut
-  if( !m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_all, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_all, 1 ); }
+  // an electron w/o TrackParticle fails all the tracking cuts (in case of derivation reduction)
+  //
+  switch ( cut ) {
 
   // *********************************************************************************************************************************************************************
   //
   // author cut
   //
-  if ( m_doAuthorCut ) {
-    if ( !( electron->author(xAOD::EgammaParameters::AuthorElectron) || electron->author(xAOD::EgammaParameters::AuthorAmbiguous) ) ) {
-      ANA_MSG_DEBUG( "Electron failed author kinematic cut." );
-      return 0;
+  case ElectronCut::author : {
+    if ( m_doAuthorCut ) {
+      if ( !( electron->author(xAOD::EgammaParameters::AuthorElectron) || electron->author(xAOD::EgammaParameters::AuthorAmbiguous) ) ) {
+        ANA_MSG_DEBUG( "Electron failed author kinematic cut." );
+        return false;
+      }
     }
+    if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::author );
+    return true;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_author_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_author_cut, 1 ); }
 
   // *********************************************************************************************************************************************************************
   //
   // Object Quality cut
   //
-  if ( m_doOQCut ) {
-    if( !electron->isGoodOQ(xAOD::EgammaParameters::BADCLUSELECTRON) ){
-      ANA_MSG_DEBUG( "Electron failed Object Quality cut BADCLUSELECTRON." );
-      return 0;
+  case ElectronCut::OQ : {
+    if ( m_doOQCut ) {
+      if( !electron->isGoodOQ(xAOD::EgammaParameters::BADCLUSELECTRON) ){
+        ANA_MSG_DEBUG( "Electron failed Object Quality cut BADCLUSELECTRON." );
+        return false;
+      }
     }
+    if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::OQ );
+    return true;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_OQ_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_OQ_cut, 1 ); }
 
   // *********************************************************************************************************************************************************************
   //
   // pT max cut
   //
-  if ( m_pT_max != 1e8 ) {
-    if ( et > m_pT_max ) {
-      ANA_MSG_DEBUG( "Electron failed pT max cut." );
-      return 0;
+  case ElectronCut::ptmax : {
+    if ( m_pT_max != 1e8 ) {
+      if ( electron->pt() > m_pT_max ) {
+        ANA_MSG_DEBUG( "Electron failed pT max cut." );
+        return false;
+      }
     }
+    if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::ptmax );
+    return true;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_ptmax_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_ptmax_cut, 1 ); }
 
   // *********************************************************************************************************************************************************************
   //
   // pT min cut
   //
-  if ( m_pT_min != 1e8 ) {
-    if ( et < m_pT_min ) {
-      ANA_MSG_DEBUG( "Electron failed pT min cut." );
-      return 0;
+  case ElectronCut::ptmin : {
+    if ( m_pT_min != 1e8 ) {
+      if ( electron->pt() < m_pT_min ) {
+        ANA_MSG_DEBUG( "Electron failed pT min cut." );
+        return false;
+      }
     }
+    if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::ptmin );
+    return true;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_ptmin_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_ptmin_cut, 1 ); }
 
   // *********************************************************************************************************************************************************************
   //
   // eta cuts
   //
+  case ElectronCut::eta : {
+    float eta = ( electron->caloCluster() ) ? electron->caloCluster()->etaBE(2) : -999.0;
 
-  // |eta| max cut
-  //
-  if ( m_eta_max != 1e8 ) {
-    if ( fabs(eta) > m_eta_max ) {
-      ANA_MSG_DEBUG( "Electron failed |eta| max cut." );
-      return 0;
+    // |eta| max cut
+    //
+    if ( m_eta_max != 1e8 ) {
+      if ( fabs(eta) > m_eta_max ) {
+        ANA_MSG_DEBUG( "Electron failed |eta| max cut." );
+        return false;
+      }
     }
-  }
-  // |eta| crack veto
-  //
-  if ( m_vetoCrack ) {
-    if ( fabs( eta ) > 1.37 && fabs( eta ) < 1.52 ) {
-      ANA_MSG_DEBUG( "Electron failed |eta| crack veto cut." );
-      return 0;
+    // |eta| crack veto
+    //
+    if ( m_vetoCrack ) {
+      if ( fabs( eta ) > 1.37 && fabs( eta ) < 1.52 ) {
+        ANA_MSG_DEBUG( "Electron failed |eta| crack veto cut." );
+        return false;
+      }
     }
+    if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::eta );
+    return true;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_eta_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_eta_cut, 1 ); }
-
 
   // *********************************************************************************************************************************************************************
   //
-  // Tracking cuts AFTER acceptance, in case of derivation reduction.
-  //
-
-  const xAOD::TrackParticle* tp  = electron->trackParticle();
-  if ( !tp ) {
-    ANA_MSG_DEBUG("Electron has no TrackParticle. Won't be selected.");
-    return 0;
-  }
-
-  const xAOD::EventInfo* eventInfo(nullptr);
-  ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
-
-  double d0_significance = xAOD::TrackingHelpers::d0significance( tp, eventInfo->beamPosSigmaX(), eventInfo->beamPosSigmaY(), eventInfo->beamPosSigmaXY() );
-
-  // Take distance between z0 and zPV ( after referring the PV z coordinate to the beamspot position, given by vz() ), multiplied by sin(theta)
-  // see https://twiki.cern.ch/twiki/bin/view/AtlasProtected/InDetTrackingDC14 for further reference
-  //
-  float z0sintheta = 1e8;
-  if (primaryVertex) z0sintheta = ( tp->z0() + tp->vz() - primaryVertex->z() ) * sin( tp->theta() );
-
   // z0*sin(theta) cut
   //
-  if ( m_z0sintheta_max != 1e8 ) {
-    if ( !( fabs(z0sintheta) < m_z0sintheta_max ) ) {
-      ANA_MSG_DEBUG( "Electron failed z0*sin(theta) cut." );
-      return 0;
+  case ElectronCut::z0sintheta : {
+    if ( !m_el_track.hasTrack ) { return false; }
+
+    if ( m_z0sintheta_max != 1e8 ) {
+      if ( !( fabs(m_el_track.z0sintheta) < m_z0sintheta_max ) ) {
+        ANA_MSG_DEBUG( "Electron failed z0*sin(theta) cut." );
+        return false;
+      }
     }
+    if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::z0sintheta );
+    return true;
   }
-  if ( !m_isUsedBefore && m_useCutFlow ) m_el_cutflowHist_1->Fill( m_el_cutflow_z0sintheta_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_z0sintheta_cut, 1 ); }
-
-  // decorate electron w/ z0*sin(theta) info
-  static SG::AuxElement::Decorator< float > z0sinthetaDecor("z0sintheta");
-  z0sinthetaDecor( *electron ) = z0sintheta;
 
+  // *********************************************************************************************************************************************************************
+  //
   // d0 cut
   //
-  if ( m_d0_max != 1e8 ) {
-    if ( !( tp->d0() < m_d0_max ) ) {
-      ANA_MSG_DEBUG( "Electron failed d0 cut.");
-      return 0;
+  case ElectronCut::d0 : {
+    const xAOD::TrackParticle* tp  = electron->trackParticle();
+    if ( !tp ) { return false; }
+
+    if ( m_d0_max != 1e8 ) {
+      if ( !( tp->d0() < m_d0_max ) ) {
+        ANA_MSG_DEBUG( "Electron failed d0 cut.");
+        return false;
+      }
     }
+    if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::d0 );
+    return true;
   }
-  if ( !m_isUsedBefore && m_useCutFlow ) m_el_cutflowHist_1->Fill( m_el_cutflow_d0_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_d0_cut, 1 ); }
 
+  // *********************************************************************************************************************************************************************
+  //
   // d0sig cut
   //
-  if ( m_d0sig_max != 1e8 ) {
-    if ( !( fabs(d0_significance) < m_d0sig_max ) ) {
-      ANA_MSG_DEBUG( "Electron failed d0 significance cut.");
-      return 0;
+  case ElectronCut::d0sig : {
+    if ( !m_el_track.hasTrack ) { return false; }
+
+    if ( m_d0sig_max != 1e8 ) {
+      if ( !( fabs(m_el_track.d0sig) < m_d0sig_max ) ) {
+        ANA_MSG_DEBUG( "Electron failed d0 significance cut.");
+        return false;
+      }
     }
+    if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::d0sig );
+    return true;
   }
-  if ( !m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_d0sig_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_d0sig_cut, 1 ); }
-
-  // decorate electron w/ d0sig info
-  static SG::AuxElement::Decorator< float > d0SigDecor("d0sig");
-  d0SigDecor( *electron ) = static_cast<float>(d0_significance);
-
 
+  // *********************************************************************************************************************************************************************
+  //
   // BLayer track quality
-  static SG::AuxElement::Decorator< bool > bLayerDecor("bLayerPass");
-
-  // this is taken from ElectronPhotonSelectorTools/Root/AsgElectronLikelihoodTool.cxx
-  uint8_t expectBlayer(true);
-  uint8_t nBlayerHits(0);
-  uint8_t nBlayerOutliers(0);
-
-  tp->summaryValue(expectBlayer,    xAOD::expectBLayerHit);
-  tp->summaryValue(nBlayerHits,     xAOD::numberOfBLayerHits);
-  tp->summaryValue(nBlayerOutliers, xAOD::numberOfBLayerOutliers);
+  //
+  case ElectronCut::BL : {
+    if ( !m_el_track.hasTrack ) { return false; }
 
-  bool bLayerPass = expectBlayer && (nBlayerHits+nBlayerOutliers) >= 1;
-  bLayerDecor( *electron ) = bLayerPass;
+    if ( m_doBLTrackQualityCut ) {
+      if ( !m_el_track.bLayerPass ) {
+        ANA_MSG_DEBUG( "Electron failed BL track quality cut.");
+        return false;
+      }
 
-  if ( m_doBLTrackQualityCut ) {
-    if ( !bLayerPass ) {
-      ANA_MSG_DEBUG( "Electron failed BL track quality cut.");
-      return 0;
+      if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::BL );
     }
-
-    if ( !m_isUsedBefore && m_useCutFlow ) m_el_cutflowHist_1->Fill( m_el_cutflow_BL_cut, 1 );
-    if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_BL_cut, 1 ); }
+    return true;
   }
 
   // *********************************************************************************************************************************************************************
   //
   // electron PID cuts
   //
-
-  //
-  // likelihood PID
-  //
-
-  // set default values for *this* electron decorations
+  // the decisions for all the valid WPs are kept in m_el_toolDecisions, and decorated by passCuts() if the electron is selected
   //
-  if( m_doLHPID ) {
-    m_el_LH_PIDManager->setDecorations( electron );
+  case ElectronCut::PID : {
+    if( m_doLHPID ) {
 
-    if ( m_readIDFlagsFromDerivation ) {
+      if ( m_readIDFlagsFromDerivation ) {
 
-      if ( m_doLHPIDcut ) {
+        if ( m_doLHPIDcut ) {
 
-        bool passSelID(false);
-        static SG::AuxElement::ConstAccessor< char > LHDecision( "DFCommonElectronsLH" + m_LHOperatingPoint );
-        if( LHDecision.isAvailable( *electron ) )
-            passSelID = LHDecision( *electron );
+          bool passSelID(false);
+          static SG::AuxElement::ConstAccessor< char > LHDecision( "DFCommonElectronsLH" + m_LHOperatingPoint );
+          if( LHDecision.isAvailable( *electron ) )
+              passSelID = LHDecision( *electron );
 
-        if ( !passSelID ) {
-          ANA_MSG_DEBUG( "Electron failed likelihood PID cut w/ operating point " << m_LHOperatingPoint );
-          return 0;
+          if ( !passSelID ) {
+            ANA_MSG_DEBUG( "Electron failed likelihood PID cut w/ operating point " << m_LHOperatingPoint );
+            return false;
+          }
         }
-      }
 
-      const std::set<std::string> myLHWPs = m_el_LH_PIDManager->getValidWPs();
-      for ( auto it : (myLHWPs) ) {
+        const std::set<std::string> myLHWPs = m_el_LH_PIDManager->getValidWPs();
+        for ( auto it : (myLHWPs) ) {
 
-        const std::string decorWP =  "LH"+it;
+          const std::string decorWP =  "LH"+it;
 
-        bool passThisID(false);
-        SG::AuxElement::ConstAccessor< char > LHDecisionAll( "DFCommonElectrons" + decorWP );
-        if( LHDecisionAll.isAvailable( *electron ) )
-            passThisID = LHDecisionAll( *electron );
+          bool passThisID(false);
+          SG::AuxElement::ConstAccessor< char > LHDecisionAll( "DFCommonElectrons" + decorWP );
+          if( LHDecisionAll.isAvailable( *electron ) )
+              passThisID = LHDecisionAll( *electron );
 
-        ANA_MSG_DEBUG( "Decorating electron with decision for LH WP : " << decorWP );
-        ANA_MSG_DEBUG( "\t does electron pass " << decorWP << "? " << passThisID );
-        electron->auxdecor<char>(decorWP) = static_cast<char>( passThisID );
+          m_el_toolDecisions.emplace_back( decorWP, static_cast<char>( passThisID ) );
 
-      }
+        }
 
-    } else {
+      } else if ( m_nestedPIDWPs ) {
 
-      // retrieve only tools with WP >= selected WP, cut electrons if not satisfying selected WP, and decorate w/ tool decision all the others
-      //
-      typedef std::multimap< std::string, AsgElectronLikelihoodTool* > LHToolsMap;
-      LHToolsMap myLHTools = m_el_LH_PIDManager->getValidWPTools();
+        // evaluate the WPs >= selected WP from the loosest to the tightest: the electron passes the first nPassed of them
+        //
+        const std::vector<std::string>& myLHWPs = m_el_LH_PIDManager->getValidWPsByTightness();
+        const unsigned int nPassed = m_el_LH_PIDManager->acceptNested( electron );
 
-      if ( m_doLHPIDcut && !( ( myLHTools.find( m_LHOperatingPoint )->second )->accept( electron ) ) ) {
-        ANA_MSG_DEBUG( "Electron failed likelihood PID cut w/ operating point " << m_LHOperatingPoint );
-        return 0;
-      }
+        if ( m_doLHPIDcut && m_el_LH_PIDManager->getSelectedWPIndex() >= nPassed ) {
+          ANA_MSG_DEBUG( "Electron failed likelihood PID cut w/ operating point " << m_LHOperatingPoint );
+          return false;
+        }
+
+        for ( unsigned int iWP = 0; iWP < myLHWPs.size(); ++iWP ) {
+          m_el_toolDecisions.emplace_back( "LH" + myLHWPs.at(iWP), static_cast<char>( iWP < nPassed ) );
+        }
+
+      } else {
 
-      for ( auto it : (myLHTools) ) {
+        // retrieve only tools with WP >= selected WP, cut electrons if not satisfying selected WP, and keep the tool decision for all the others
+        //
+        typedef std::multimap< std::string, AsgElectronLikelihoodTool* > LHToolsMap;
+        LHToolsMap myLHTools = m_el_LH_PIDManager->getValidWPTools();
+
+        if ( m_doLHPIDcut && !( ( myLHTools.find( m_LHOperatingPoint )->second )->accept( electron ) ) ) {
+          ANA_MSG_DEBUG( "Electron failed likelihood PID cut w/ operating point " << m_LHOperatingPoint );
+          return false;
+        }
 
-        const std::string decorWP =  "LH" + it.first;
-        ANA_MSG_DEBUG( "Decorating electron with decision for LH WP : " << decorWP );
-        ANA_MSG_DEBUG( "\t does electron pass " << decorWP << " ? " << static_cast<int>( it.second->accept( electron ) ) );
-        electron->auxdecor<char>(decorWP) = static_cast<char>( it.second->accept( electron ) );
+        for ( auto it : (myLHTools) ) {
+          m_el_toolDecisions.emplace_back( "LH" + it.first, static_cast<char>( bool( it.second->accept( electron ) ) ) );
+        }
 
       }
+    }// if m_doLHPID
 
-    }
-  }// if m_doLHPID
+    //
+    // cut-based PID
+    //
 
-  //
-  // cut-based PID
-  //
+    if( m_doCutBasedPID ) {
 
-  // set default values for *this* electron decorations
-  //
-  if( m_doCutBasedPID ) {
-    m_el_CutBased_PIDManager->setDecorations( electron );
+      if ( m_readIDFlagsFromDerivation ) {
 
-    if ( m_readIDFlagsFromDerivation ) {
+        if ( m_doCutBasedPIDcut ) {
 
-      if ( m_doCutBasedPIDcut ) {
+          bool passSelID(false);
+          static SG::AuxElement::ConstAccessor< char > CutDecision( "DFCommonElectronsIsEM" + m_CutBasedOperatingPoint );
+          if( CutDecision.isAvailable( *electron ) )
+              passSelID = CutDecision( *electron );
 
-        bool passSelID(false);
-        static SG::AuxElement::ConstAccessor< char > CutDecision( "DFCommonElectronsIsEM" + m_CutBasedOperatingPoint );
-        if( CutDecision.isAvailable( *electron ) )
-            passSelID = CutDecision( *electron );
+          if ( !passSelID ) {
+            ANA_MSG_DEBUG( "Electron failed cut-based PID cut w/ operating point " << m_CutBasedOperatingPoint );
+            return false;
+          }
 
-        if ( !passSelID ) {
-          ANA_MSG_DEBUG( "Electron failed cut-based PID cut w/ operating point " << m_CutBasedOperatingPoint );
-          return 0;
         }
 
-      }
-
-      const std::set<std::string> myCutBasedWPs = m_el_CutBased_PIDManager->getValidWPs();
-      for ( auto it : (myCutBasedWPs) ) {
+        const std::set<std::string> myCutBasedWPs = m_el_CutBased_PIDManager->getValidWPs();
+        for ( auto it : (myCutBasedWPs) ) {
 
-        const std::string decorWP = "IsEM"+it;
+          const std::string decorWP = "IsEM"+it;
 
-        bool passThisID(false);
-        SG::AuxElement::ConstAccessor< char > CutDecisionAll( "DFCommonElectrons" + decorWP );
-        if( CutDecisionAll.isAvailable( *electron ) )
-            passThisID = CutDecisionAll( *electron );
+          bool passThisID(false);
+          SG::AuxElement::ConstAccessor< char > CutDecisionAll( "DFCommonElectrons" + decorWP );
+          if( CutDecisionAll.isAvailable( *electron ) )
+              passThisID = CutDecisionAll( *electron );
 
-        ANA_MSG_DEBUG( "Decorating electron with decision for cut-based WP : " << decorWP );
-        ANA_MSG_DEBUG( "\t does electron pass " << decorWP << "? " << passThisID );
-        electron->auxdecor<char>(decorWP) = static_cast<char>( passThisID );
+          m_el_toolDecisions.emplace_back( decorWP, static_cast<char>( passThisID ) );
 
-      }
+        }
 
-    } else {
+      } else if ( m_nestedPIDWPs ) {
 
-      // retrieve only tools with WP >= selected WP, cut electrons if not satisfying selected WP, and decorate w/ tool decision all the others
-      //
-      typedef std::multimap< std::string, AsgElectronIsEMSelector* > CutBasedToolsMap;
-      CutBasedToolsMap myCutBasedTools = m_el_CutBased_PIDManager->getValidWPTools();
+        // evaluate the WPs >= selected WP from the loosest to the tightest: the electron passes the first nPassed of them
+        //
+        const std::vector<AsgElectronIsEMSelector*>& myCutBasedTools = m_el_CutBased_PIDManager->getValidWPToolsByTightness();
+        const unsigned int nPassed = m_el_CutBased_PIDManager->acceptNested( electron );
 
-      if ( m_doCutBasedPIDcut && !( ( myCutBasedTools.find( m_CutBasedOperatingPoint )->second )->accept( *electron ) ) ) {
-        ANA_MSG_DEBUG( "Electron failed cut-based PID cut." );
-        return 0;
-      }
+        if ( m_doCutBasedPIDcut && m_el_CutBased_PIDManager->getSelectedWPIndex() >= nPassed ) {
+          ANA_MSG_DEBUG( "Electron failed cut-based PID cut." );
+          return false;
+        }
 
-      for ( auto it : (myCutBasedTools) ) {
+        for ( unsigned int iWP = 0; iWP < myCutBasedTools.size(); ++iWP ) {
+          // same name as below, when all the tools are evaluated
+          m_el_toolDecisions.emplace_back( "IsEM" + myCutBasedTools.at(iWP)->getOperatingPointName( ), static_cast<char>( iWP < nPassed ) );
+        }
 
-        const std::string decorWP = "IsEM"+it.second->getOperatingPointName( );
+      } else {
 
-        ANA_MSG_DEBUG( "Decorating electron with decision for cut-based WP : " << decorWP );
-        ANA_MSG_DEBUG( "\t does electron pass " << decorWP << "? " << static_cast<int>( it.second->accept( *electron ) ) );
+        // retrieve only tools with WP >= selected WP, cut electrons if not satisfying selected WP, and keep the tool decision for all the others
+        //
+        typedef std::multimap< std::string, AsgElectronIsEMSelector* > CutBasedToolsMap;
+        CutBasedToolsMap myCutBasedTools = m_el_CutBased_PIDManager->getValidWPTools();
 
-        electron->auxdecor<char>(decorWP) = static_cast<char>( it.second->accept( *electron ) );
-      }
+        if ( m_doCutBasedPIDcut && !( ( myCutBasedTools.find( m_CutBasedOperatingPoint )->second )->accept( *electron ) ) ) {
+          ANA_MSG_DEBUG( "Electron failed cut-based PID cut." );
+          return false;
+        }
 
-    }
-  }// if m_doCutBasedPID
+        for ( auto it : (myCutBasedTools) ) {
+          m_el_toolDecisions.emplace_back( "IsEM" + it.second->getOperatingPointName( ), static_cast<char>( bool( it.second->accept( *electron ) ) ) );
+        }
 
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_PID_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_PID_cut, 1 ); }
+      }
+    }// if m_doCutBasedPID
 
+    if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::PID );
+    return true;
+  }
 
   // *********************************************************************************************************************************************************************
   //
   // isolation cut
   //
+  case ElectronCut::iso : {
+    // Get the "list" of input WPs with the accept() decision from the tool
+    //
+    Root::TAccept accept_list = m_isolationSelectionTool_handle->accept( *electron );
 
-  // Get the "list" of input WPs with the accept() decision from the tool
-  //
-  Root::TAccept accept_list = m_isolationSelectionTool_handle->accept( *electron );
-
-  // Decorate w/ decision for all input WPs
-  //
-  std::string base_decor("isIsolated");
-  for ( auto WP_itr : m_IsoKeys ) {
-
-    std::string decorWP = base_decor + "_" + WP_itr;
-
-    ANA_MSG_DEBUG( "Decorate electron with " << decorWP << " - accept() ?" << accept_list.getCutResult( WP_itr.c_str()) );
-    electron->auxdecor<char>(decorWP) = static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) );
+    // Keep the decision for all input WPs
+    //
+    for ( auto WP_itr : m_IsoKeys ) {
+      m_el_toolDecisions.emplace_back( "isIsolated_" + WP_itr, static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) ) );
+    }
 
+    // Apply the cut if needed
+    //
+    if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
+      ANA_MSG_DEBUG( "Electron failed isolation cut " << m_MinIsoWPCut );
+      return false;
+    }
+    if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::iso );
+    return true;
   }
 
-  // Apply the cut if needed
-  //
-  if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
-    ANA_MSG_DEBUG( "Electron failed isolation cut " << m_MinIsoWPCut );
-    return 0;
+  default:
+    return true;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_el_cutflowHist_1->Fill( m_el_cutflow_iso_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_el_cutflowHist_2->Fill( m_el_cutflow_iso_cut, 1 ); }
 
-  return 1;
+}
+
+std::string ElectronSelector :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " " + m_vertexContainerName + " egamma*Clusters *TrackParticles *ConversionVertices";
 }
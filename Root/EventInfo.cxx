@@ -1,16 +1,34 @@
 #include "xAODAnaHelpers/EventInfo.h"
 #include <xAODAnaHelpers/HelperFunctions.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include "xAODTruth/TruthEventContainer.h"
 #include "xAODEventShape/EventShape.h"
-#include "xAODCaloEvent/CaloClusterContainer.h"
 
 
 using namespace xAH;
 
+namespace {
+  // pt of a cluster from its energy, mass and eta, as xAOD::CaloCluster::pt() computes it
+  inline double clusterPt( float e, float m, float eta ) {
+    double p = e;
+    if ( std::abs( m ) >= 0.00001 ) {
+      p = std::sqrt( double(e)*e - double(m)*m );
+      if ( e < 0 ) p = -p;
+    }
+    const double aeta = std::min( std::abs( double(eta) ), 710.0 );
+    return p / std::cosh( aeta );
+  }
+}
+
 EventInfo::EventInfo(const std::string& detailStr, float units, bool mc, bool storeSyst)
   : m_infoSwitch(detailStr), m_mc(mc), m_debug(false), m_storeSyst(storeSyst), m_units(units)
 {
+  // only the event shapes that are written out are ever retrieved
+  if ( m_infoSwitch.m_shapeLC )      m_eventShapes.emplace_back( "Kt4LCTopoOriginEventShape", &EventInfo::m_rhoLC );
+  if ( m_infoSwitch.m_shapeEM )      m_eventShapes.emplace_back( "Kt4EMTopoOriginEventShape", &EventInfo::m_rhoEM );
+  if ( m_infoSwitch.m_shapeEMPFLOW ) m_eventShapes.emplace_back( "Kt4EMPFlowEventShape",      &EventInfo::m_rhoEMPFLOW );
 }
 
 EventInfo::~EventInfo()
@@ -336,51 +354,35 @@ void EventInfo::FillEvent( const xAOD::EventInfo* eventInfo, xAOD::TEvent* event
 
   }
 
-  if ( m_infoSwitch.m_shapeLC && event ) {
-    const xAOD::EventShape* evtShape(nullptr);
-    HelperFunctions::retrieve( evtShape, "Kt4LCTopoOriginEventShape", event, 0 );
-    if ( !evtShape->getDensity( xAOD::EventShape::Density, m_rhoLC ) ) {
-      Info("FillEvent()","Could not retrieve xAOD::EventShape::Density from xAOD::EventShape");
-      m_rhoLC = -999;
-    }
-  }
-
-  if ( m_infoSwitch.m_shapeEM && event ) {
-    const xAOD::EventShape* evtShape(nullptr);
-    HelperFunctions::retrieve( evtShape, "Kt4EMTopoOriginEventShape", event, 0 );
-    if ( !evtShape->getDensity( xAOD::EventShape::Density, m_rhoEM ) ) {
-      Info("FillEvent()","Could not retrieve xAOD::EventShape::Density from xAOD::EventShape");
-      m_rhoEM = -999;
+  if ( event ) {
+    // the event shapes missing from the input are dropped the first time, instead of failing to retrieve them in every event
+    if ( !m_eventShapesChecked ) {
+      m_eventShapesChecked = true;
+      m_eventShapes.erase( std::remove_if( m_eventShapes.begin(), m_eventShapes.end(), [event]( const std::pair<std::string, double EventInfo::*>& shape ) {
+            if ( event->contains<xAOD::EventShape>( shape.first ) ) return false;
+            Warning("FillEvent()","No %s in the input: its density is not filled", shape.first.c_str());
+            return true;
+          } ), m_eventShapes.end() );
     }
-  }
-
-  if ( m_infoSwitch.m_shapeEMPFLOW && event ) {
-    const xAOD::EventShape* evtShape(nullptr);
-    HelperFunctions::retrieve( evtShape, "Kt4EMPFlowEventShape", event, 0 );
-    if ( !evtShape->getDensity( xAOD::EventShape::Density, m_rhoEMPFLOW ) ) {
-      Info("FillEvent()","Could not retrieve xAOD::EventShape::Density from xAOD::EventShape");
-      m_rhoEMPFLOW = -999;
+    for ( const auto& shape : m_eventShapes ) {
+      const xAOD::EventShape* evtShape(nullptr);
+      if ( !event->retrieve( evtShape, shape.first ).isSuccess() || !evtShape->getDensity( xAOD::EventShape::Density, this->*shape.second ) ) {
+        Info("FillEvent()","Could not retrieve xAOD::EventShape::Density from %s", shape.first.c_str());
+        this->*shape.second = -999;
+      }
     }
   }
 
   if( m_infoSwitch.m_caloClus && event ) {
-    const xAOD::CaloClusterContainer* caloClusters = 0;
-    HelperFunctions::retrieve( caloClusters, "CaloCalTopoClusters", event, 0);
-    // save the clusters at the EM scale
-    for( auto clus : * caloClusters ) {
-      if ( clus->pt ( xAOD::CaloCluster::State::UNCALIBRATED ) < 2000 ) { continue; } // 2 GeV cut
-      m_caloCluster_pt. push_back( clus->pt ( xAOD::CaloCluster::State::UNCALIBRATED ) / m_units );
-      m_caloCluster_eta.push_back( clus->eta( xAOD::CaloCluster::State::UNCALIBRATED ) );
-      m_caloCluster_phi.push_back( clus->phi( xAOD::CaloCluster::State::UNCALIBRATED ) );
-      m_caloCluster_e.  push_back( clus->e  ( xAOD::CaloCluster::State::UNCALIBRATED ) / m_units );
-    }
+    const xAOD::CaloClusterContainer* caloClusters(nullptr);
+    if ( event->retrieve( caloClusters, "CaloCalTopoClusters" ).isSuccess() ) fillCaloClusters( caloClusters );
   }
 
   if( m_infoSwitch.m_truth && event && m_mc ) {
     //MC Truth
     const xAOD::TruthEventContainer* truthE = 0;
     HelperFunctions::retrieve( truthE, "TruthEvents", event, 0 );
-    if( truthE ) {
+    if( truthE && !truthE->empty() ) {
       const xAOD::TruthEvent* truthEvent = truthE->at(0);
       truthEvent->pdfInfoParameter(m_pdgId1,   xAOD::TruthEvent::PDGID1);
       truthEvent->pdfInfoParameter(m_pdgId2,   xAOD::TruthEvent::PDGID2);
@@ -401,3 +403,28 @@ void EventInfo::FillEvent( const xAOD::EventInfo* eventInfo, xAOD::TEvent* event
 
   return;
 }
+
+void EventInfo::fillCaloClusters( const xAOD::CaloClusterContainer* caloClusters ) {
+  const std::size_t n = caloClusters->size();
+  if ( n == 0 ) return;
+
+  // the EM scale four-vector is the raw* variables of the clusters: read their columns directly rather than through the
+  // UNCALIBRATED getters of each cluster (in branch access mode only these branches of the aux store are read)
+  static SG::AuxElement::ConstAccessor<float> rawEAcc  ("rawE");
+  static SG::AuxElement::ConstAccessor<float> rawEtaAcc("rawEta");
+  static SG::AuxElement::ConstAccessor<float> rawPhiAcc("rawPhi");
+  static SG::AuxElement::ConstAccessor<float> rawMAcc  ("rawM");
+  const float* rawE   = rawEAcc.getDataArray( *caloClusters );
+  const float* rawEta = rawEtaAcc.getDataArray( *caloClusters );
+  const float* rawPhi = rawPhiAcc.getDataArray( *caloClusters );
+  const float* rawM   = rawMAcc.getDataArray( *caloClusters );
+
+  for ( std::size_t i = 0; i < n; ++i ) {
+    const double pt = clusterPt( rawE[i], rawM[i], rawEta[i] );
+    if ( pt < 2000 ) { continue; } // 2 GeV cut
+    m_caloCluster_pt. push_back( pt / m_units );
+    m_caloCluster_eta.push_back( rawEta[i] );
+    m_caloCluster_phi.push_back( rawPhi[i] );
+    m_caloCluster_e.  push_back( rawE[i] / m_units );
+  }
+}
@@ -0,0 +1,123 @@
+// c++ include(s):
+#include <sstream>
+
+// EL include(s):
+#include <EventLoop/Job.h>
+#include <EventLoop/StatusCode.h>
+#include <EventLoop/Worker.h>
+
+// ROOT include(s):
+#include "TFile.h"
+#include "TSystem.h"
+
+// package include(s):
+#include "xAODAnaHelpers/EventPicker.h"
+
+// this is needed to distribute the algorithm to the workers
+ClassImp(EventPicker)
+
+EventPicker :: EventPicker () :
+    Algorithm("EventPicker")
+{
+}
+
+EL::StatusCode EventPicker :: setupJob (EL::Job& job)
+{
+  ANA_MSG_DEBUG("Calling setupJob");
+
+  job.useXAOD ();
+  xAOD::Init( "EventPicker" ).ignore(); // call before opening first file
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode EventPicker :: histInitialize ()
+{
+  ANA_CHECK( xAH::Algorithm::algInitialize());
+
+  // file1|e1,e2,e3 file2|e4 ... -> {file1: {e1, e2, e3}, file2: {e4}, ...}
+  m_entriesPerFile.clear();
+  std::string token;
+  std::istringstream ss(m_entries);
+  while(std::getline(ss, token, ' ')){
+    if(token.empty()) continue;
+    std::size_t pos = token.find_last_of('|');
+    if(pos == std::string::npos){
+      ANA_MSG_ERROR("m_entries must be of the form 'file|entry,entry,...', got " << token);
+      return EL::StatusCode::FAILURE;
+    }
+    std::set<long long>& entries = m_entriesPerFile[token.substr(0, pos)];
+    std::string entry;
+    std::istringstream ss_entries(token.substr(pos+1));
+    while(std::getline(ss_entries, entry, ','))
+      if(!entry.empty()) entries.insert(std::stoll(entry));
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode EventPicker :: fileExecute () { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode EventPicker :: changeInput (bool /*firstFile*/)
+{
+  const std::string fileName = wk()->inputFile()->GetName();
+  m_currentEntries = nullptr;
+
+  auto it = m_entriesPerFile.find(fileName);
+  if ( it == m_entriesPerFile.end() ) {
+    // the index may have been written with a different path to the same file
+    const std::string baseName = gSystem->BaseName(fileName.c_str());
+    for ( it = m_entriesPerFile.begin(); it != m_entriesPerFile.end(); ++it ) {
+      if ( baseName == gSystem->BaseName(it->first.c_str()) ) break;
+    }
+  }
+
+  if ( it != m_entriesPerFile.end() ) {
+    m_currentEntries = &it->second;
+    ANA_MSG_INFO("Picking " << m_currentEntries->size() << " events in " << fileName);
+  } else {
+    ANA_MSG_WARNING("No events to pick in " << fileName);
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode EventPicker :: initialize ()
+{
+  ANA_MSG_DEBUG("Calling initialize");
+
+  m_event = wk()->xaodEvent();
+  m_store = wk()->xaodStore();
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode EventPicker :: execute ()
+{
+  if ( !m_currentEntries || !m_currentEntries->count(wk()->treeEntry()) ) {
+    wk()->skipEvent();
+    return EL::StatusCode::SUCCESS;
+  }
+
+  ++m_numPicked;
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode EventPicker :: postExecute () { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode EventPicker :: finalize ()
+{
+  ANA_MSG_INFO("Picked " << m_numPicked << " events");
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode EventPicker :: histFinalize ()
+{
+  ANA_CHECK( xAH::Algorithm::algFinalize());
+  return EL::StatusCode::SUCCESS;
+}
+
+std::string EventPicker :: declaredInputs () const
+{
+  return "";
+}
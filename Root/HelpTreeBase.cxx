@@ -486,6 +486,7 @@ void HelpTreeBase::FillElectrons( const xAOD::ElectronContainer* electrons, cons
 
   this->ClearElectrons(elecName);
 
+  m_elecs[elecName]->FillParticles(electrons);
   for ( auto el_itr : *electrons ) {
     this->FillElectron(el_itr, primaryVertex, elecName);
   }
@@ -534,6 +535,7 @@ void HelpTreeBase::FillPhotons( const xAOD::PhotonContainer* photons, const std:
 
   this->ClearPhotons(photonName);
 
+  m_photons[photonName]->FillParticles(photons);
   for ( auto ph_itr : *photons ) {
     this->FillPhoton(ph_itr, photonName);
   }
@@ -705,6 +707,7 @@ void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation, con
     if ( pvLocation >= 0 ) pv = vertices->at( pvLocation );
   }
 
+  thisJet->FillParticles(jets);
   for( auto jet_itr : *jets ) {
     this->FillJet(jet_itr, pv, pvLocation, jetName);
   }
@@ -888,6 +891,7 @@ void HelpTreeBase::FillFatJets( const xAOD::JetContainer* fatJets , const std::s
 
   this->ClearFatJets(fatjetName, suffix);
 
+  m_fatjets[FatJetCollectionName(fatjetName, suffix)]->FillParticles(fatJets);
   for( auto fatjet_itr : *fatJets ) {
 
     this->FillFatJet(fatjet_itr, fatjetName, suffix);
@@ -978,6 +982,7 @@ void HelpTreeBase::FillTaus( const xAOD::TauJetContainer* taus, const std::strin
 
   this->ClearTaus();
 
+  m_taus[tauName]->FillParticles(taus);
   for( auto tau_itr : *taus ) {
     this->FillTau(tau_itr, tauName);
   }
@@ -131,6 +131,15 @@ namespace HelperClasses{
     m_weightsSys    = has_exact("weightsSys");
   }
 
+  std::string EventInfoSwitch::inputs() const {
+    std::string inputs;
+    if(m_pileup)                                    inputs += " PrimaryVertices";
+    if(m_shapeEM || m_shapeEMPFLOW || m_shapeLC)    inputs += " *EventShape";
+    if(m_truth)                                     inputs += " TruthEvents";
+    if(m_caloClus)                                  inputs += " CaloCalTopoClusters";
+    return inputs;
+  }
+
   void TriggerInfoSwitch::initialize(){
     m_basic             = has_exact("basic");
     m_menuKeys          = has_exact("menuKeys");
@@ -140,6 +149,12 @@ namespace HelperClasses{
     m_prescalesLumi     = has_exact("prescalesLumi");
   }
 
+  std::string TriggerInfoSwitch::inputs() const {
+    // what the TrigDecisionTool reads
+    if(m_configStr.empty()) return "";
+    return " xTrigDecision TrigConfKeys TrigNavigation HLTNav_* HLT_* LVL1*";
+  }
+
   void IParticleInfoSwitch::initialize(){
     m_kinematic     = has_exact("kinematic");
 
@@ -195,6 +210,11 @@ namespace HelperClasses{
 
   }
 
+  std::string MuonInfoSwitch::inputs() const {
+    if(m_trackparams || m_trackhitcont) return " *TrackParticles";
+    return "";
+  }
+
   void ElectronInfoSwitch::initialize(){
     m_trigger       = has_exact("trigger");
     m_isolation     = has_exact("isolation");
@@ -237,6 +257,13 @@ namespace HelperClasses{
     }
   }
 
+  std::string ElectronInfoSwitch::inputs() const {
+    std::string inputs;
+    if(m_trackparams || m_trackhitcont) inputs += " *TrackParticles";
+    if(m_recoparams)                    inputs += " egamma*Clusters";
+    return inputs;
+  }
+
   void PhotonInfoSwitch::initialize(){
     m_isolation     = has_exact("isolation");
     m_PID           = has_exact("PID");
@@ -454,6 +481,68 @@ namespace HelperClasses{
     m_JVC           = has_exact("JVC");
   }
 
+  uint64_t JetInfoSwitch::mask() const {
+    uint64_t mask(0);
+    if(m_kinematic)        mask |= JetSwitch::kinematic;
+    if(m_useTheS)          mask |= JetSwitch::useTheS;
+    if(m_trigger)          mask |= JetSwitch::trigger;
+    if(m_substructure)     mask |= JetSwitch::substructure;
+    if(m_bosonCount)       mask |= JetSwitch::bosonCount;
+    if(m_VTags)            mask |= JetSwitch::VTags;
+    if(m_rapidity)         mask |= JetSwitch::rapidity;
+    if(m_clean)            mask |= JetSwitch::clean;
+    if(m_cleanLight)       mask |= JetSwitch::cleanLight;
+    if(m_cleanNoSumm)      mask |= JetSwitch::cleanNoSumm;
+    if(m_energy)           mask |= JetSwitch::energy;
+    if(m_energyLight)      mask |= JetSwitch::energyLight;
+    if(m_scales)           mask |= JetSwitch::scales;
+    if(m_constscaleEta)    mask |= JetSwitch::constscaleEta;
+    if(m_detectorEta)      mask |= JetSwitch::detectorEta;
+    if(m_resolution)       mask |= JetSwitch::resolution;
+    if(m_truth)            mask |= JetSwitch::truth;
+    if(m_truthDetails)     mask |= JetSwitch::truthDetails;
+    if(m_layer)            mask |= JetSwitch::layer;
+    if(m_trackPV)          mask |= JetSwitch::trackPV;
+    if(m_trackAll)         mask |= JetSwitch::trackAll;
+    if(m_jvt)              mask |= JetSwitch::jvt;
+    if(m_allTrack)         mask |= JetSwitch::allTrack;
+    if(m_allTrackDetail)   mask |= JetSwitch::allTrackDetail;
+    if(m_allTrackPVSel)    mask |= JetSwitch::allTrackPVSel;
+    if(m_constituent)      mask |= JetSwitch::constituent;
+    if(m_constituentAll)   mask |= JetSwitch::constituentAll;
+    if(m_flavorTag)        mask |= JetSwitch::flavorTag;
+    if(m_flavorTagHLT)     mask |= JetSwitch::flavorTagHLT;
+    if(m_btag_jettrk)      mask |= JetSwitch::btag_jettrk;
+    if(m_jetFitterDetails) mask |= JetSwitch::jetFitterDetails;
+    if(m_svDetails)        mask |= JetSwitch::svDetails;
+    if(m_ipDetails)        mask |= JetSwitch::ipDetails;
+    if(m_tracksInJet)      mask |= JetSwitch::tracksInJet;
+    if(m_hltVtxComp)       mask |= JetSwitch::hltVtxComp;
+    if(m_onlineBS)         mask |= JetSwitch::onlineBS;
+    if(m_onlineBSTool)     mask |= JetSwitch::onlineBSTool;
+    if(m_charge)           mask |= JetSwitch::charge;
+    if(m_etaPhiMap)        mask |= JetSwitch::etaPhiMap;
+    if(m_vsLumiBlock)      mask |= JetSwitch::vsLumiBlock;
+    if(m_vsActualMu)       mask |= JetSwitch::vsActualMu;
+    if(m_lumiB_runN)       mask |= JetSwitch::lumiB_runN;
+    if(m_byEta)            mask |= JetSwitch::byEta;
+    if(m_byAverageMu)      mask |= JetSwitch::byAverageMu;
+    if(m_area)             mask |= JetSwitch::area;
+    if(m_JVC)              mask |= JetSwitch::JVC;
+    return mask;
+  }
+
+  std::string JetInfoSwitch::inputs() const {
+    std::string inputs;
+    if(m_trackPV || m_trackAll || m_allTrack || m_tracksInJet || m_btag_jettrk) inputs += " *TrackParticles";
+    if(m_trackPV || m_allTrackPVSel || m_hltVtxComp)                           inputs += " *Vertices";
+    if(m_flavorTag || m_flavorTagHLT || !m_jetBTag.empty())                     inputs += " BTagging_*";
+    if(m_truth || m_truthDetails)                                               inputs += " *TruthJets* TruthParticles";
+    if(m_constituent || m_constituentAll)                                       inputs += " CaloCalTopoClusters *ParticleFlowObjects";
+    if(!m_trackJetNames.empty())                                                inputs += " *TrackJets";
+    return inputs;
+  }
+
   void TruthInfoSwitch::initialize(){
     m_type          = has_exact("type");
     m_bVtx          = has_exact("bVtx");
@@ -497,6 +586,11 @@ namespace HelperClasses{
 
   }
 
+  std::string TauInfoSwitch::inputs() const {
+    if(m_trackAll || m_trackparams || m_trackhitcont) return " TauTracks *TrackParticles";
+    return "";
+  }
+
   void METInfoSwitch::initialize(){
     m_metClus   = has_exact("metClus");
     m_metTrk    = has_exact("metTrk");
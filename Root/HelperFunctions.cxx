@@ -8,13 +8,8 @@
 #include <SampleHandler/MetaFields.h>
 #include <SampleHandler/MetaObject.h>
 
-// jet reclustering
-#include <fastjet/PseudoJet.hh>
-#include <fastjet/ClusterSequence.hh>
-
-// jet trimming
-#include <fastjet/tools/Filter.hh>
-#include <JetEDM/JetConstituentFiller.h>
+// jet reclustering and trimming
+#include <xAODAnaHelpers/JetReclusteringEngine.h>
 
 void xAH::addRucio(SH::SampleHandler& sh, const std::string& name, const std::string& dslist)
 {
@@ -212,73 +207,23 @@ bool HelperFunctions::isFilePrimaryxAOD(TFile* inputFile) {
 }
 
 
+namespace {
+  // keeps its buffers from one call to the next, see xAH::JetReclusteringEngine
+  xAH::JetReclusteringEngine& reclusteringEngine(){
+    static xAH::JetReclusteringEngine engine;
+    return engine;
+  }
+}
+
 std::vector<TLorentzVector> HelperFunctions::jetReclustering(
   const xAOD::JetContainer* jets,
   double radius,
   double fcut,
   fastjet::JetAlgorithm rc_alg
 ){
-
-  //1. Need to convert the vector of jets to a vector of pseudojets
-  //    only need p4() since we're using them as inputs
-  std::vector<fastjet::PseudoJet> input_jets;
-
-  for(auto jet : *jets){
-    const TLorentzVector jet_p4 = jet->p4();
-    input_jets.push_back(
-      fastjet::PseudoJet(
-        jet_p4.Px()/1000.,
-        jet_p4.Py()/1000.,
-        jet_p4.Pz()/1000.,
-        jet_p4.E ()/1000.
-      )
-    );
-  }
-
-  //2. Build up the new jet definitions using input configurations
-  //    - jet algorithm
-  //    - radius
-  fastjet::JetDefinition jet_def(rc_alg, radius);
-
-  //3. Run the Cluster Sequence on pseudojets with the right jet definition above
-  //    cs = clustersequence
-  fastjet::ClusterSequence cs(input_jets, jet_def);
-
-  // 4. Grab the reclustered jets, sorted by pt()
-  //    rc_jets == reclustered jets
-  std::vector<fastjet::PseudoJet> rc_jets = fastjet::sorted_by_pt(cs.inclusive_jets());
-
-  //5.  Apply trimming on PJ.constituents() using fcut
-  //    rc_t_jets == reclustered, trimmed jets
-  std::vector<TLorentzVector> rc_t_jets;
-
-  for(auto rc_jet : rc_jets){
-    TLorentzVector rc_t_jet = TLorentzVector();
-    // loop over subjets
-    for(auto rc_jet_subjet : rc_jet.constituents()){
-      TLorentzVector subjet = TLorentzVector();
-      subjet.SetPtEtaPhiE(
-        rc_jet_subjet.pt(),
-        rc_jet_subjet.eta(),
-        rc_jet_subjet.phi(),
-        rc_jet_subjet.e()
-      );
-      if(subjet.Pt() > fcut*rc_jet.pt()) rc_t_jet += subjet;
-    }
-    rc_t_jets.push_back(rc_t_jet);
-  }
-
-  // notes: rc_t_jets is not sorted by pt due to trimming applied
-  struct sort_by_pt
-  {
-      inline bool operator() (const TLorentzVector lhs, const TLorentzVector rhs)
-      {
-        return (lhs.Pt() > rhs.Pt());
-      }
-  };
-  std::sort(rc_t_jets.begin(), rc_t_jets.end(), sort_by_pt());
-
-  return rc_t_jets;
+  xAH::JetReclusteringEngine& engine = reclusteringEngine();
+  engine.configure(radius, fcut, rc_alg, 0.3, fastjet::kt_algorithm);
+  return engine.recluster(jets);
 }
 
 std::vector<TLorentzVector> HelperFunctions::jetTrimming(
@@ -287,23 +232,9 @@ std::vector<TLorentzVector> HelperFunctions::jetTrimming(
   double fcut,
   fastjet::JetAlgorithm s_alg
 ){
-
-  std::vector<TLorentzVector> t_jets;
-  for(const auto jet: *jets){
-    t_jets.push_back( jetTrimming(jet, radius, fcut, s_alg) );
-  }
-
-  // notes: t_jets is not sorted by pt due to trimming applied
-  struct sort_by_pt
-  {
-      inline bool operator() (const TLorentzVector lhs, const TLorentzVector rhs)
-      {
-        return (lhs.Pt() > rhs.Pt());
-      }
-  };
-  std::sort(t_jets.begin(), t_jets.end(), sort_by_pt());
-
-  return t_jets;
+  xAH::JetReclusteringEngine& engine = reclusteringEngine();
+  engine.configure(1.0, fcut, fastjet::antikt_algorithm, radius, s_alg);
+  return engine.trim(jets);
 }
 
 TLorentzVector HelperFunctions::jetTrimming(
@@ -312,30 +243,9 @@ TLorentzVector HelperFunctions::jetTrimming(
   double fcut,
   fastjet::JetAlgorithm s_alg
 ){
-
-  //1. Create the trimmer
-  fastjet::Filter trimmer(fastjet::JetDefinition(s_alg, radius), fastjet::SelectorPtFractionMin(fcut));
-
-  //2.  Apply the trimmer to the jet, this requires the JetEDM
-  //        convert xAOD::Jet to PseudoJet with constituents
-  //        apply trimmer on the PseudoJet
-  TLorentzVector t_jet = TLorentzVector();
-  std::vector<fastjet::PseudoJet> constit_pseudojets = jet::JetConstituentFiller::constituentPseudoJets(*jet);
-
-  //3. Need to use ClusterSequence to recluster jet again once we found constituents
-  fastjet::ClusterSequence cs(constit_pseudojets, fastjet::JetDefinition( (fastjet::JetAlgorithm) jet->getAlgorithmType(), jet->getSizeParameter()));
-
-  fastjet::PseudoJet t_pjet = trimmer(fastjet::join(cs.inclusive_jets()));
-
-  t_jet.SetPtEtaPhiE(
-    t_pjet.pt(),
-    t_pjet.eta(),
-    t_pjet.phi(),
-    t_pjet.e()
-  );
-
-  return t_jet;
-
+  xAH::JetReclusteringEngine& engine = reclusteringEngine();
+  engine.configure(1.0, fcut, fastjet::antikt_algorithm, radius, s_alg);
+  return engine.trim(jet);
 }
 
 const xAOD::Vertex* HelperFunctions::getPrimaryVertex(const xAOD::VertexContainer* vertexContainer, MsgStream& msg)
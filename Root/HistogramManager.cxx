@@ -11,9 +11,294 @@
  *
  ******************************************/
 
+#include <cmath>
+#include <unordered_map>
+
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TBuffer.h>
+
 #include <AsgTools/MsgStream.h>
 #include "xAODAnaHelpers/HistogramManager.h"
 
+namespace {
+
+  /** set the axes of a histogram booked lazily, returns its number of cells */
+  Int_t setAxes( TH1* hist, const std::string& name, const std::string& title, const xAH::HistBinning& binning ) {
+    hist->SetName( name.c_str() );
+    hist->SetTitle( title.c_str() );
+    TAxis* axes[3] = { hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis() };
+    Int_t ncells = 1;
+    for ( std::size_t i = 0; i < binning.axes.size() && i < 3; ++i ) {
+      const xAH::HistBinning::Axis& axis = binning.axes[i];
+      if ( axis.edges.empty() ) axes[i]->Set( axis.nbins, axis.low, axis.high );
+      else                      axes[i]->Set( axis.nbins, axis.edges.data() );
+      axes[i]->SetTitle( axis.title.c_str() );
+      ncells *= axis.nbins + 2;
+    }
+    return ncells;
+  }
+
+  /**
+      A histogram whose content and Sumw2 arrays are allocated on the first fill (or SetBinContent) rather than when it is booked.
+
+      All the fills of a TH1/TH2/TH3 go through AddBinContent, and all the reads of the content through RetrieveBinContent, so that
+      these are the only places where the arrays can be needed. It has no dictionary of its own: IsA() is that of HIST, so that it
+      is written (and cloned) as a plain HIST, which Streamer makes sure has its arrays allocated.
+   */
+  template<class HIST>
+  class LazyHist : public HIST {
+    public:
+      LazyHist( const std::string& name, const std::string& title, const xAH::HistBinning& binning ) :
+        HIST()
+      {
+        // the default constructor allocates a few cells (and Sumw2 if it is on by default): release them, so that the first fill allocates
+        this->SetBinsLength( 0 );
+        this->fSumw2.Set( 0 );
+        // the number of cells of the histogram booked eagerly, without the arrays
+        this->fNcells = setAxes( this, name, title, binning );
+      }
+
+      // the unweighted Fill() adds to Sumw2 itself once the content is filled
+      void AddBinContent( Int_t bin ) override {
+        if ( this->fN == 0 ) allocate();
+        HIST::AddBinContent( bin );
+      }
+      // the weighted Fill() adds w*w before filling the content, only if Sumw2 was already on
+      void AddBinContent( Int_t bin, Double_t w ) override {
+        if ( this->fN == 0 && allocate() ) this->fSumw2.fArray[bin] += w*w;
+        HIST::AddBinContent( bin, w );
+      }
+
+      void Streamer( TBuffer& b ) override {
+        if ( !b.IsWriting() || this->fN > 0 ) {
+          HIST::Streamer( b );
+          return;
+        }
+        // written as the same empty histogram as when booked eagerly, then released again
+        allocate();
+        HIST::Streamer( b );
+        const Int_t ncells = this->fNcells;
+        this->SetBinsLength( 0 );
+        this->fNcells = ncells;
+        this->fSumw2.Set( 0 );
+      }
+
+    protected:
+      Double_t RetrieveBinContent( Int_t bin ) const override {
+        return ( this->fN > 0 ) ? HIST::RetrieveBinContent( bin ) : 0.;
+      }
+      void UpdateBinContent( Int_t bin, Double_t content ) override {
+        if ( this->fN == 0 ) allocate();
+        HIST::UpdateBinContent( bin, content );
+      }
+
+    private:
+      /** allocate the content and Sumw2 arrays, returns true if Sumw2 was turned on now (and so misses the current weighted fill) */
+      bool allocate() {
+        this->SetBinsLength( this->fNcells );
+        if ( this->fSumw2.fN > 0 ) return false;  // already turned on by a weighted fill
+        this->Sumw2();
+        return true;
+      }
+  };
+
+  /** the histograms keeping their bins outside of the ROOT arrays, for HistogramManager::memoryUsage */
+  class CompactBins {
+    public:
+      virtual ~CompactBins() {}
+      /** memory used by the bins [B] */
+      virtual double binBytes() const = 0;
+  };
+
+  /** the filled bins only, in a hash map */
+  class SparseBins {
+    public:
+      void init( Int_t /*ncells*/ ) {}
+      void add( Int_t bin, double w ) {
+        auto& sums = m_bins[bin];
+        sums.first  += w;
+        sums.second += w*w;
+      }
+      void set( Int_t bin, double content ) { m_bins[bin].first = content; }
+      double content( Int_t bin ) const {
+        auto itr = m_bins.find( bin );
+        return ( itr != m_bins.end() ) ? itr->second.first : 0.;
+      }
+      double sumw2( Int_t bin ) const {
+        auto itr = m_bins.find( bin );
+        return ( itr != m_bins.end() ) ? itr->second.second : 0.;
+      }
+      template<class F> void forEach( F f ) const {
+        for ( const auto& bin : m_bins ) f( bin.first, bin.second.first, bin.second.second );
+      }
+      void clear() { m_bins.clear(); }
+      double bytes() const {
+        // one node per filled bin (key, sums and the next pointer, plus the cached hash) and the buckets
+        return m_bins.size() * ( sizeof( std::pair<const Int_t, std::pair<double, double> > ) + 2*sizeof(void*) ) + m_bins.bucket_count() * sizeof(void*);
+      }
+
+    private:
+      std::unordered_map<Int_t, std::pair<double, double> > m_bins;
+  };
+
+  /**
+      Integer counts, without sum of squared weights, as long as all the weights are 1 (the sum of squared weights is then the count).
+      The first other weight (or SetBinContent) turns them into sums of weights and of squared weights in double precision.
+   */
+  class CountBins {
+    public:
+      void init( Int_t ncells ) { m_ncells = ncells; }
+      void add( Int_t bin, double w ) {
+        if ( w == 1. && m_sumw.empty() ) {
+          if ( m_counts.empty() ) m_counts.resize( m_ncells, 0 );
+          ++m_counts[bin];
+          return;
+        }
+        toWeighted();
+        m_sumw[bin]  += w;
+        m_sumw2[bin] += w*w;
+      }
+      void set( Int_t bin, double content ) {
+        toWeighted();
+        m_sumw[bin] = content;
+      }
+      double content( Int_t bin ) const {
+        if ( !m_sumw.empty() )   return m_sumw[bin];
+        if ( !m_counts.empty() ) return m_counts[bin];
+        return 0.;
+      }
+      double sumw2( Int_t bin ) const {
+        if ( !m_sumw2.empty() ) return m_sumw2[bin];
+        return content( bin );
+      }
+      template<class F> void forEach( F f ) const {
+        for ( Int_t bin = 0; bin < static_cast<Int_t>( m_counts.size() ); ++bin ) {
+          if ( m_counts[bin] ) f( bin, m_counts[bin], m_counts[bin] );
+        }
+        for ( Int_t bin = 0; bin < static_cast<Int_t>( m_sumw.size() ); ++bin ) {
+          if ( m_sumw[bin] != 0. || m_sumw2[bin] != 0. ) f( bin, m_sumw[bin], m_sumw2[bin] );
+        }
+      }
+      void clear() {
+        std::vector<UInt_t>().swap( m_counts );
+        std::vector<double>().swap( m_sumw );
+        std::vector<double>().swap( m_sumw2 );
+      }
+      double bytes() const {
+        return m_counts.capacity() * sizeof(UInt_t) + ( m_sumw.capacity() + m_sumw2.capacity() ) * sizeof(double);
+      }
+
+    private:
+      void toWeighted() {
+        if ( !m_sumw.empty() ) return;
+        m_sumw.assign( m_counts.begin(), m_counts.end() );
+        m_sumw2.assign( m_counts.begin(), m_counts.end() );
+        if ( m_sumw.empty() ) {
+          m_sumw.resize( m_ncells, 0. );
+          m_sumw2.resize( m_ncells, 0. );
+        }
+        std::vector<UInt_t>().swap( m_counts );
+      }
+
+      Int_t m_ncells = 0;
+      std::vector<UInt_t> m_counts;
+      std::vector<double> m_sumw, m_sumw2;
+  };
+
+  /**
+      A histogram keeping its bins in BINS (SparseBins or CountBins) instead of its ROOT arrays, which are only filled while it is
+      written: the output is the same TH1F/TH2F/TH3F, with Sumw2, as when booked eagerly. Like LazyHist, it intercepts the fills
+      and reads of the bins, and Sumw2 so that TH1::Fill never allocates the array of the sums of squared weights.
+   */
+  template<class HIST, class BINS>
+  class CompactHist : public HIST, public CompactBins {
+    public:
+      CompactHist( const std::string& name, const std::string& title, const xAH::HistBinning& binning ) :
+        HIST()
+      {
+        // as for LazyHist: without its arrays, TH1::Fill only calls AddBinContent (the fills would overrun the few default cells)
+        this->SetBinsLength( 0 );
+        this->fSumw2.Set( 0 );
+        this->fNcells = setAxes( this, name, title, binning );
+        m_bins.init( this->fNcells );
+      }
+
+      void AddBinContent( Int_t bin ) override { m_bins.add( bin, 1. ); }
+      void AddBinContent( Int_t bin, Double_t w ) override { m_bins.add( bin, w ); }
+
+      using HIST::GetBinError;
+      Double_t GetBinError( Int_t bin ) const override {
+        if ( bin < 0 ) bin = 0;
+        if ( bin >= this->fNcells ) bin = this->fNcells - 1;
+        return std::sqrt( m_bins.sumw2( bin ) );
+      }
+
+      // the sums of squared weights are always kept by the bins
+      void Sumw2( Bool_t /*flag*/ = kTRUE ) override {}
+
+      void Reset( Option_t* option = "" ) override {
+        HIST::Reset( option );
+        m_bins.clear();
+      }
+
+      void Streamer( TBuffer& b ) override {
+        if ( !b.IsWriting() ) {
+          HIST::Streamer( b );
+          return;
+        }
+        // converted to the ROOT arrays just for the time of writing
+        const Int_t ncells = this->fNcells;
+        this->SetBinsLength( ncells );
+        this->fSumw2.Set( ncells );
+        m_bins.forEach( [this]( Int_t bin, double content, double sumw2 ) {
+          this->HIST::UpdateBinContent( bin, content );
+          this->fSumw2.fArray[bin] = sumw2;
+        } );
+        HIST::Streamer( b );
+        this->SetBinsLength( 0 );
+        this->fNcells = ncells;
+        this->fSumw2.Set( 0 );
+      }
+
+      double binBytes() const override { return m_bins.bytes(); }
+
+    protected:
+      Double_t RetrieveBinContent( Int_t bin ) const override { return m_bins.content( bin ); }
+      void UpdateBinContent( Int_t bin, Double_t content ) override { m_bins.set( bin, content ); }
+
+    private:
+      BINS m_bins;
+  };
+
+  xAH::HistBinning::Axis makeAxis( const std::string& title, int nbins, double low, double high ) {
+    xAH::HistBinning::Axis axis;
+    axis.title = title;
+    axis.nbins = nbins;
+    axis.low   = low;
+    axis.high  = high;
+    return axis;
+  }
+
+  xAH::HistBinning::Axis makeAxis( const std::string& title, int nbins, const Double_t* edges ) {
+    xAH::HistBinning::Axis axis = makeAxis( title, nbins, edges[0], edges[nbins] );
+    axis.edges.assign( edges, edges + nbins + 1 );
+    return axis;
+  }
+
+  /** size of the bins of a histogram, as allocated and if all were allocated in the ROOT arrays with Sumw2 [B] */
+  void arraySizes( const TH1* hist, double& allocated, double& full ) {
+    double elementSize = sizeof(Int_t);
+    int size = 0;
+    if ( const TArrayF* array = dynamic_cast<const TArrayF*>( hist ) )      { elementSize = sizeof(Float_t);  size = array->GetSize(); }
+    else if ( const TArrayD* array = dynamic_cast<const TArrayD*>( hist ) ) { elementSize = sizeof(Double_t); size = array->GetSize(); }
+    allocated = size * elementSize + hist->GetSumw2N() * sizeof(Double_t);
+    if ( const CompactBins* bins = dynamic_cast<const CompactBins*>( hist ) ) allocated = bins->binBytes();
+    full = hist->GetNcells() * ( elementSize + sizeof(Double_t) );
+  }
+
+}
+
 /* constructors and destructors */
 HistogramManager::HistogramManager(std::string name, std::string detailStr):
   m_name(name),
@@ -37,6 +322,7 @@ HistogramManager::~HistogramManager() {}
 TH1F* HistogramManager::book(std::string name, std::string title,
                              std::string xlabel, int xbins, double xlow, double xhigh)
 {
+  if( isBookingDeferred() ) return bookLazy<TH1F>(name, title, { makeAxis(xlabel, xbins, xlow, xhigh) });
   TH1F* tmp = new TH1F( (name + title).c_str(), title.c_str(), xbins, xlow, xhigh);
   SetLabel(tmp, xlabel);
   this->Sumw2(tmp);
@@ -48,6 +334,7 @@ TH2F* HistogramManager::book(std::string name, std::string title,
                              std::string xlabel, int xbins, double xlow, double xhigh,
                              std::string ylabel, int ybins, double ylow, double yhigh)
 {
+  if( isBookingDeferred() ) return bookLazy<TH2F>(name, title, { makeAxis(xlabel, xbins, xlow, xhigh), makeAxis(ylabel, ybins, ylow, yhigh) });
   TH2F* tmp = new TH2F( (name + title).c_str(), title.c_str(), xbins, xlow, xhigh, ybins, ylow, yhigh);
   SetLabel(tmp, xlabel, ylabel);
   this->Sumw2(tmp);
@@ -60,6 +347,7 @@ TH3F* HistogramManager::book(std::string name, std::string title,
                              std::string ylabel, int ybins, double ylow, double yhigh,
                              std::string zlabel, int zbins, double zlow, double zhigh)
 {
+  if( isBookingDeferred() ) return bookLazy<TH3F>(name, title, { makeAxis(xlabel, xbins, xlow, xhigh), makeAxis(ylabel, ybins, ylow, yhigh), makeAxis(zlabel, zbins, zlow, zhigh) });
   TH3F* tmp = new TH3F( (name + title).c_str(), title.c_str(), xbins, xlow, xhigh, ybins, ylow, yhigh, zbins, zlow, zhigh);
   SetLabel(tmp, xlabel, ylabel, zlabel);
   this->Sumw2(tmp);
@@ -84,6 +372,7 @@ TProfile* HistogramManager::book(std::string name, std::string title,
 TH1F* HistogramManager::book(std::string name, std::string title,
                              std::string xlabel, int xbins, const Double_t* xbinArr)
 {
+  if( isBookingDeferred() ) return bookLazy<TH1F>(name, title, { makeAxis(xlabel, xbins, xbinArr) });
   TH1F* tmp = new TH1F( (name + title).c_str(), title.c_str(), xbins, xbinArr);
   SetLabel(tmp, xlabel);
   this->Sumw2(tmp);
@@ -95,6 +384,7 @@ TH2F* HistogramManager::book(std::string name, std::string title,
                              std::string xlabel, int xbins, const Double_t* xbinArr,
                              std::string ylabel, int ybins, double ylow, double yhigh)
 {
+  if( isBookingDeferred() ) return bookLazy<TH2F>(name, title, { makeAxis(xlabel, xbins, xbinArr), makeAxis(ylabel, ybins, ylow, yhigh) });
   TH2F* tmp = new TH2F( (name + title).c_str(), title.c_str(), xbins, xbinArr, ybins, ylow, yhigh);
   SetLabel(tmp, xlabel, ylabel);
   this->Sumw2(tmp);
@@ -106,6 +396,7 @@ TH2F* HistogramManager::book(std::string name, std::string title,
                              std::string xlabel, int xbins, double xlow, double xhigh,
                              std::string ylabel, int ybins, const Double_t* ybinArr)
 {
+  if( isBookingDeferred() ) return bookLazy<TH2F>(name, title, { makeAxis(xlabel, xbins, xlow, xhigh), makeAxis(ylabel, ybins, ybinArr) });
   TH2F* tmp = new TH2F( (name + title).c_str(), title.c_str(), xbins, xlow, xhigh, ybins, ybinArr);
   SetLabel(tmp, xlabel, ylabel);
   this->Sumw2(tmp);
@@ -117,6 +408,7 @@ TH2F* HistogramManager::book(std::string name, std::string title,
                              std::string xlabel, int xbins, const Double_t* xbinArr,
                              std::string ylabel, int ybins, const Double_t* ybinArr)
 {
+  if( isBookingDeferred() ) return bookLazy<TH2F>(name, title, { makeAxis(xlabel, xbins, xbinArr), makeAxis(ylabel, ybins, ybinArr) });
   TH2F* tmp = new TH2F( (name + title).c_str(), title.c_str(), xbins, xbinArr, ybins, ybinArr);
   SetLabel(tmp, xlabel, ylabel);
   this->Sumw2(tmp);
@@ -129,6 +421,7 @@ TH3F* HistogramManager::book(std::string name, std::string title,
                              std::string ylabel, int ybins, const Double_t* ybinArr,
                              std::string zlabel, int zbins, const Double_t* zbinArr)
 {
+  if( isBookingDeferred() ) return bookLazy<TH3F>(name, title, { makeAxis(xlabel, xbins, xbinArr), makeAxis(ylabel, ybins, ybinArr), makeAxis(zlabel, zbins, zbinArr) });
   TH3F* tmp = new TH3F( (name + title).c_str(), title.c_str(), xbins, xbinArr, ybins, ybinArr, zbins, zbinArr);
   SetLabel(tmp, xlabel, ylabel, zlabel);
   this->Sumw2(tmp);
@@ -136,6 +429,67 @@ TH3F* HistogramManager::book(std::string name, std::string title,
   return tmp;
 }
 
+template<class HIST>
+HIST* HistogramManager::bookLazy(const std::string& name, const std::string& title, std::vector<xAH::HistBinning::Axis>&& axes)
+{
+  xAH::HistBinning binning;
+  binning.axes = std::move(axes);
+
+  HIST* tmp(nullptr);
+  switch( m_storage ) {
+    case xAH::HistStorage::Sparse : tmp = new CompactHist<HIST, SparseBins>( name + title, title, binning ); break;
+    case xAH::HistStorage::Counts : tmp = new CompactHist<HIST, CountBins>( name + title, title, binning );  break;
+    default                       : tmp = new LazyHist<HIST>( name + title, title, binning );                 break;
+  }
+  this->record(tmp);
+  return tmp;
+}
+
+void HistogramManager::setLazyBooking(bool lazy)
+{
+  m_lazyBooking = lazy;
+}
+
+void HistogramManager::setStorage(xAH::HistStorage storage)
+{
+  m_storage = storage;
+}
+
+StatusCode HistogramManager::setStorage(const std::string& storage)
+{
+  if( storage.empty() || storage == "dense" ) setStorage( xAH::HistStorage::Dense );
+  else if( storage == "sparse" )              setStorage( xAH::HistStorage::Sparse );
+  else if( storage == "counts" )              setStorage( xAH::HistStorage::Counts );
+  else {
+    ANA_MSG_ERROR( "Unknown histogram storage '" << storage << "', expected dense, sparse or counts" );
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+HistogramManager::MemoryUsage& HistogramManager::MemoryUsage::operator+=(const MemoryUsage& other)
+{
+  booked         += other.booked;
+  allocated      += other.allocated;
+  bookedBytes    += other.bookedBytes;
+  allocatedBytes += other.allocatedBytes;
+  return *this;
+}
+
+HistogramManager::MemoryUsage HistogramManager::memoryUsage() const
+{
+  MemoryUsage usage;
+  for( auto hist : m_allHists ) {
+    double allocated(0), full(0);
+    arraySizes(hist, allocated, full);
+    usage.booked++;
+    if( allocated > 0 ) usage.allocated++;
+    usage.bookedBytes    += full;
+    usage.allocatedBytes += allocated;
+  }
+  return usage;
+}
+
 MsgStream& HistogramManager :: msg () const { return m_msg; }
 MsgStream& HistogramManager :: msg (int level) const {
     MsgStream& result = msg();
@@ -91,7 +91,8 @@ StatusCode IParticleHists::initialize() {
   return StatusCode::SUCCESS;
 }
 
-StatusCode IParticleHists::execute( const xAOD::IParticleContainer* particles, float eventWeight, const xAOD::EventInfo* eventInfo) {
+StatusCode IParticleHists::execute( const xAOD::IParticleContainer* particles, float eventWeight, const xAOD::EventInfo* eventInfo,
+                                    const std::vector<unsigned int>* leadingOrder ) {
   using namespace msgIParticleHists;
   for( auto particle_itr : *particles ) {
     ANA_CHECK( this->execute( particle_itr, eventWeight, eventInfo));
@@ -100,18 +101,20 @@ StatusCode IParticleHists::execute( const xAOD::IParticleContainer* particles, f
   if( m_infoSwitch->m_numLeading > 0){
     int numParticles = std::min( m_infoSwitch->m_numLeading, (int)particles->size() );
     for(int iParticle=0; iParticle < numParticles; ++iParticle){
-      m_NPt_l.at(iParticle)->        Fill( particles->at(iParticle)->pt()/1e3,   eventWeight);
-      m_NPt.at(iParticle)->        Fill( particles->at(iParticle)->pt()/1e3,   eventWeight);
-      m_NPt_m.at(iParticle)->        Fill( particles->at(iParticle)->pt()/1e3,   eventWeight);
-      m_NPt_s.at(iParticle)->        Fill( particles->at(iParticle)->pt()/1e3,   eventWeight);
-      m_NEta.at(iParticle)->       Fill( particles->at(iParticle)->eta(),      eventWeight);
-      m_NPhi.at(iParticle)->       Fill( particles->at(iParticle)->phi(),      eventWeight);
-      m_NM.at(iParticle)->         Fill( particles->at(iParticle)->m()/1e3,    eventWeight);
-      m_NE.at(iParticle)->         Fill( particles->at(iParticle)->e()/1e3,    eventWeight);
-      m_NRapidity.at(iParticle)->  Fill( particles->at(iParticle)->rapidity(), eventWeight);
+      const xAOD::IParticle* particle = particles->at( leadingOrder ? leadingOrder->at(iParticle) : iParticle );
+
+      m_NPt_l.at(iParticle)->        Fill( particle->pt()/1e3,   eventWeight);
+      m_NPt.at(iParticle)->        Fill( particle->pt()/1e3,   eventWeight);
+      m_NPt_m.at(iParticle)->        Fill( particle->pt()/1e3,   eventWeight);
+      m_NPt_s.at(iParticle)->        Fill( particle->pt()/1e3,   eventWeight);
+      m_NEta.at(iParticle)->       Fill( particle->eta(),      eventWeight);
+      m_NPhi.at(iParticle)->       Fill( particle->phi(),      eventWeight);
+      m_NM.at(iParticle)->         Fill( particle->m()/1e3,    eventWeight);
+      m_NE.at(iParticle)->         Fill( particle->e()/1e3,    eventWeight);
+      m_NRapidity.at(iParticle)->  Fill( particle->rapidity(), eventWeight);
 
       if(m_infoSwitch->m_kinematic){
-	float et = particles->at(iParticle)->e()/cosh(particles->at(iParticle)->eta())/1e3;
+	float et = particle->e()/cosh(particle->eta())/1e3;
 	m_NEt  .at(iParticle)->        Fill( et,   eventWeight);
 	m_NEt_m.at(iParticle)->        Fill( et,   eventWeight);
 	m_NEt_s.at(iParticle)->        Fill( et,   eventWeight);
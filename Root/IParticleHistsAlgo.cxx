@@ -39,6 +39,8 @@ EL::StatusCode IParticleHistsAlgo::AddHists( std::string name ) {
   fullname += name; // add systematic
   IParticleHists* particleHists = new IParticleHists( fullname, m_detailStr, m_histPrefix, m_histTitle ); // add systematic
   particleHists->m_debug = msgLvl(MSG::DEBUG);
+  particleHists->setLazyBooking( m_lazyBooking );
+  ANA_CHECK( particleHists->setStorage( m_histStorage ));
   ANA_CHECK( particleHists->initialize());
   particleHists->record( wk() );
   m_plots[name] = particleHists;
@@ -76,6 +78,14 @@ EL::StatusCode IParticleHistsAlgo :: postExecute () { return EL::StatusCode::SUC
 
 EL::StatusCode IParticleHistsAlgo :: finalize () {
   ANA_MSG_DEBUG( m_name );
+
+  HistogramManager::MemoryUsage usage;
+  for( auto plots : m_plots ) {
+    if(plots.second) usage += plots.second->memoryUsage();
+  }
+  ANA_MSG_INFO( m_plots.size() << " set(s) of histograms: " << usage.allocated << " of " << usage.booked << " histograms allocated, "
+                << usage.allocatedBytes/1048576. << " MB of " << usage.bookedBytes/1048576. << " MB (" << m_histStorage << " storage" << (m_lazyBooking ? ", lazy booking)" : ")") );
+
   for( auto plots : m_plots ) {
     if(plots.second){
       plots.second->finalize();
@@ -89,3 +99,8 @@ EL::StatusCode IParticleHistsAlgo :: histFinalize () {
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
+
+std::string IParticleHistsAlgo :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName;
+}
@@ -0,0 +1,306 @@
+// c++ include(s):
+#include <iomanip>
+#include <sstream>
+
+#include <fnmatch.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// EL include(s):
+#include <EventLoop/Job.h>
+#include <EventLoop/StatusCode.h>
+#include <EventLoop/Worker.h>
+
+// ROOT include(s):
+#include "TEnv.h"
+#include "TFile.h"
+#include "TBranch.h"
+#include "TObjArray.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+#include "TUrl.h"
+
+// package include(s):
+#include "xAODAnaHelpers/InputCache.h"
+
+// this is needed to distribute the algorithm to the workers
+ClassImp(InputCache)
+
+namespace {
+  // what TTree::SetBranchStatus(name, false) does to the branch it finds
+  void disableBranch( TBranch* branch ) {
+    branch->SetBit(TBranch::kDoNotProcess);
+    TObjArray* subBranches = branch->GetListOfBranches();
+    for ( int i = 0; i < subBranches->GetEntriesFast(); ++i ) disableBranch( static_cast<TBranch*>(subBranches->At(i)) );
+  }
+}
+
+InputCache :: InputCache () :
+    Algorithm("InputCache")
+{
+}
+
+EL::StatusCode InputCache :: setupJob (EL::Job& job)
+{
+  ANA_MSG_DEBUG("Calling setupJob");
+
+  job.useXAOD ();
+  xAOD::Init( "InputCache" ).ignore(); // call before opening first file
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode InputCache :: histInitialize ()
+{
+  ANA_CHECK( xAH::Algorithm::algInitialize());
+
+  m_pinned = parseInputs(m_branches);
+  m_declared = parseInputs(m_declaredInputs);
+
+  std::string token;
+  m_fileList.clear();
+  std::istringstream ss_files(m_prefetchFiles);
+  while ( ss_files >> token ) m_fileList.push_back(token);
+
+  // read by the files opened from now on
+  if ( m_asyncPrefetch ) gEnv->SetValue("TFile.AsyncPrefetching", 1);
+
+  m_fileStats.clear();
+  m_file = nullptr;
+  m_cache = nullptr;
+  m_prefetchHandle = nullptr;
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode InputCache :: fileExecute () { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode InputCache :: changeInput (bool /*firstFile*/)
+{
+  closeFileStats();
+
+  m_file = wk()->inputFile();
+  m_current = FileStats();
+  m_current.name = m_file->GetName();
+
+  TTree* tree = wk()->tree();
+  m_cache = tree ? dynamic_cast<TTreeCache*>( m_file->GetCacheRead(tree) ) : nullptr;
+
+  m_prunedBranches.clear();
+  if ( tree && m_pruneInputs ) {
+    pruneBranches();
+    // everything that is left is read
+    const int numPinned = pinBranches(m_declared);
+    tree->StopCacheLearningPhase();
+    ANA_MSG_INFO("Disabled " << m_prunedBranches.size() << " undeclared branches of " << m_current.name << ", caching the other " << numPinned);
+  } else if ( tree && !m_pinned.empty() ) {
+    const int numPinned = pinBranches(m_pinned);
+    if ( m_pinOnly ) tree->StopCacheLearningPhase();
+    ANA_MSG_DEBUG("Added " << numPinned << " branches to the cache of " << m_current.name << (m_cache ? "" : " (no TTreeCache)"));
+  }
+
+  releasePrefetch();
+  if ( !m_fileList.empty() ) prefetchNext(m_current.name);
+
+  return EL::StatusCode::SUCCESS;
+}
+
+std::vector<InputCache::Input> InputCache :: parseInputs (const std::string& inputs)
+{
+  std::vector<Input> parsed;
+  std::string token;
+  std::istringstream ss(inputs);
+  while ( ss >> token ) {
+    const std::size_t pos = token.find('.');
+    if ( pos == std::string::npos ) parsed.push_back({token, ""});
+    else parsed.push_back({token.substr(0, pos), token.substr(pos+1)});
+  }
+  return parsed;
+}
+
+InputCache::Input InputCache :: splitBranchName (const std::string& branchName)
+{
+  // Container (interface), ContainerAux. (static variables) or ContainerAuxDyn.variable
+  const std::size_t pos = branchName.find("AuxDyn.");
+  if ( pos != std::string::npos ) return {branchName.substr(0, pos), branchName.substr(pos+7)};
+  if ( branchName.size() > 4 && branchName.compare(branchName.size()-4, 4, "Aux.") == 0 ) return {branchName.substr(0, branchName.size()-4), ""};
+  return {branchName, ""};
+}
+
+bool InputCache :: matches (const std::vector<Input>& inputs, const std::string& branchName)
+{
+  const Input branch = splitBranchName(branchName);
+  for ( const Input& input : inputs ) {
+    if ( fnmatch(input.container.c_str(), branch.container.c_str(), 0) != 0 ) continue;
+    if ( input.variable.empty() || branch.variable.empty() || fnmatch(input.variable.c_str(), branch.variable.c_str(), 0) == 0 ) return true;
+  }
+  return false;
+}
+
+std::vector<std::string> InputCache :: undeclaredBranches (TTree* tree) const
+{
+  const std::vector<Input> declared = parseInputs(m_declaredInputs);
+  std::vector<std::string> undeclared;
+  TObjArray* branches = tree->GetListOfBranches();
+  for ( int i = 0; i < branches->GetEntriesFast(); ++i ) {
+    const std::string name = branches->At(i)->GetName();
+    if ( !matches(declared, name) ) undeclared.push_back(name);
+  }
+  return undeclared;
+}
+
+int InputCache :: pinBranches (const std::vector<Input>& inputs)
+{
+  TTree* tree = wk()->tree();
+  int numPinned(0);
+  TObjArray* branches = tree->GetListOfBranches();
+  for ( int i = 0; i < branches->GetEntriesFast(); ++i ) {
+    TBranch* branch = static_cast<TBranch*>(branches->At(i));
+    if ( branch->TestBit(TBranch::kDoNotProcess) || !matches(inputs, branch->GetName()) ) continue;
+    // with its sub-branches, i.e. the static aux variables
+    if ( tree->AddBranchToCache(branch, true) == 0 ) ++numPinned;
+  }
+  return numPinned;
+}
+
+void InputCache :: pruneBranches ()
+{
+  // on the branches directly: TTree::SetBranchStatus would look each of them up by name among all the others
+  TObjArray* branches = wk()->tree()->GetListOfBranches();
+  for ( int i = 0; i < branches->GetEntriesFast(); ++i ) {
+    TBranch* branch = static_cast<TBranch*>(branches->At(i));
+    if ( matches(m_declared, branch->GetName()) ) continue;
+    disableBranch(branch);
+    m_prunedBranches.push_back(branch);
+  }
+}
+
+void InputCache :: prefetchNext (const std::string& fileName)
+{
+  // the list may have been written with a different path to the same file
+  const std::string baseName = gSystem->BaseName(fileName.c_str());
+  std::size_t i(0);
+  while ( i < m_fileList.size() && m_fileList[i] != fileName && baseName != gSystem->BaseName(m_fileList[i].c_str()) ) ++i;
+  if ( i + 1 >= m_fileList.size() ) return;
+  const std::string& next = m_fileList[i+1];
+  ANA_MSG_DEBUG("Prefetching " << next);
+
+  TUrl url(next.c_str(), true);
+  if ( std::string(url.GetProtocol()) == "file" ) {
+#ifdef __linux__
+    // local files: ask the kernel to start reading them, opening them ahead would not save anything
+    const int fd = open(url.GetFile(), O_RDONLY);
+    if ( fd < 0 ) return;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    close(fd);
+#endif
+    return;
+  }
+
+  // the next TFile::Open of the same name takes the pending handle
+  m_prefetchHandle = TFile::AsyncOpen(next.c_str());
+  m_prefetchName = next;
+}
+
+void InputCache :: releasePrefetch ()
+{
+  if ( !m_prefetchHandle ) return;
+  // TFile::Open deletes the handle when it takes it; one still pending was not opened by EventLoop: take it and close the file
+  if ( TFile::GetAsyncOpenStatus(m_prefetchName.c_str()) != TFile::kAOSNotAsync ) {
+    ANA_MSG_DEBUG("Closing " << m_prefetchName << ", prefetched but not processed next");
+    TFile* file = TFile::Open(m_prefetchHandle);
+    if ( file ) file->Close();
+    delete file;
+  }
+  m_prefetchHandle = nullptr;
+  m_prefetchName.clear();
+}
+
+void InputCache :: closeFileStats ()
+{
+  if ( !m_file ) return;
+  m_fileStats.push_back(m_current);
+  m_file = nullptr;
+  m_cache = nullptr;
+}
+
+EL::StatusCode InputCache :: initialize ()
+{
+  ANA_MSG_DEBUG("Calling initialize");
+
+  m_event = wk()->xaodEvent();
+  m_store = wk()->xaodStore();
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode InputCache :: execute ()
+{
+  // there is no call at the end of a file: keep what was read so far
+  if ( m_file ) {
+    ++m_current.entries;
+    m_current.bytesRead = m_file->GetBytesRead();
+    m_current.readCalls = m_file->GetReadCalls();
+    if ( m_cache ) m_current.cacheEfficiency = m_cache->GetEfficiency();
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode InputCache :: postExecute ()
+{
+  // TEvent reads a disabled branch as empty without complaining: make sure none was needed by the algorithms of this event
+  const Long64_t entry = wk()->treeEntry();
+  for ( TBranch* branch : m_prunedBranches ) {
+    if ( branch && branch->GetReadEntry() == entry ) {
+      ANA_MSG_ERROR("The branch " << branch->GetName() << " was read but is not declared by any algorithm, rerun with --keepInputs "
+                    << splitBranchName(branch->GetName()).container << " (or without --pruneInputs)");
+      return EL::StatusCode::FAILURE;
+    }
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode InputCache :: finalize ()
+{
+  closeFileStats();
+  releasePrefetch();
+  if ( !m_printStats ) return EL::StatusCode::SUCCESS;
+
+  unsigned long long entries(0);
+  long long bytesRead(0);
+  long long readCalls(0);
+  ANA_MSG_INFO("Read statistics of the input files:");
+  ANA_MSG_INFO(std::setw(10) << "entries" << std::setw(12) << "MB read" << std::setw(12) << "read calls" << std::setw(12) << "cache hits" << "  file");
+  for ( const FileStats& stats : m_fileStats ) {
+    std::stringstream hits;
+    if ( stats.cacheEfficiency < 0 ) hits << "-";
+    else hits << std::fixed << std::setprecision(1) << 100.*stats.cacheEfficiency << "%";
+    ANA_MSG_INFO(std::setw(10) << stats.entries << std::setw(12) << std::fixed << std::setprecision(2) << stats.bytesRead/1e6
+                 << std::setw(12) << stats.readCalls << std::setw(12) << hits.str() << "  " << stats.name);
+    entries += stats.entries;
+    bytesRead += stats.bytesRead;
+    readCalls += stats.readCalls;
+  }
+  ANA_MSG_INFO(std::setw(10) << entries << std::setw(12) << std::fixed << std::setprecision(2) << bytesRead/1e6
+               << std::setw(12) << readCalls << std::setw(12) << "" << "  total (" << m_fileStats.size() << " files"
+               << (readCalls > 0 ? ", " + std::to_string(bytesRead/readCalls/1024) + " kB per read call)" : ")"));
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode InputCache :: histFinalize ()
+{
+  ANA_CHECK( xAH::Algorithm::algFinalize());
+  return EL::StatusCode::SUCCESS;
+}
+
+std::string InputCache :: declaredInputs () const
+{
+  return "";
+}
@@ -357,6 +357,8 @@ EL::StatusCode JetCalibrator :: initialize ()
     ANA_MSG_DEBUG("Retrieved tool: " << m_fJVTTool_handle);
   }
 
+  this->setSystematicTimers( m_systList );
+
   std::vector< std::string >* SystJetsNames = new std::vector< std::string >;
   for ( const auto& syst_it : m_systList ) {
     if ( m_systName.empty() && m_systName.empty() ) {
@@ -459,7 +461,9 @@ EL::StatusCode JetCalibrator :: execute ()
   std::vector< std::string >* vecOutContainerNames = new std::vector< std::string >;
 
   //std::vector< int >
-  for ( const auto& syst_it : m_systList ) {
+  for ( std::size_t iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
+    const auto& syst_it = m_systList[iSyst];
+    auto systTimer = this->timeSystematic( iSyst );
 
     bool nominal = syst_it.name().empty();
 
@@ -620,3 +624,11 @@ EL::StatusCode JetCalibrator :: histFinalize ()
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
+
+std::string JetCalibrator :: declaredInputs () const
+{
+  // the pile-up densities, and the tracks and vertices of the track-based corrections and of the JVT
+  std::string inputs = m_inContainerName + " " + m_eventInfoContainerName + " " + m_vertexContainerName + " *EventShape *TrackParticles BTagging_*";
+  if ( m_addGhostMuonsToJets ) inputs += " Muons";
+  return inputs;
+}
@@ -1,6 +1,7 @@
 #include "xAODAnaHelpers/JetContainer.h"
 #include <xAODAnaHelpers/HelperFunctions.h>
 #include <iostream>
+#include <initializer_list>
 #include "xAODTruth/TruthEventContainer.h"
 
 using namespace xAH;
@@ -10,6 +11,8 @@ JetContainer::JetContainer(const std::string& name, const std::string& detailStr
     m_trkSelTool(nullptr)
 
 {
+  m_fillJetKernel = findFillJetKernel(m_infoSwitch.mask(), HelperClasses::JetFillConfigs());
+
   // rapidity
   if(m_infoSwitch.m_rapidity) {
     m_rapidity                  =new std::vector<float>();
@@ -2299,17 +2302,25 @@ void JetContainer::FillJet( const xAOD::Jet* jet, const xAOD::Vertex* pv, int pv
 }
 
 void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex* pv, int pvLocation ){
+  (this->*m_fillJetKernel)(particle, pv, pvLocation);
+}
+
+// a switch of the detail string, a compile-time constant in the kernels specialised on a configuration
+#define JET_SWITCH(name) HelperClasses::switchOn<MASK>(HelperClasses::JetSwitch::name, m_infoSwitch.m_##name)
+
+template <uint64_t MASK>
+void JetContainer::FillJetKernel( const xAOD::IParticle* particle, const xAOD::Vertex* pv, int pvLocation ){
   if(m_debug) std::cout << "In JetContainer::FillJet " << std::endl;
 
   ParticleContainer::FillParticle(particle);
 
   const xAOD::Jet* jet=dynamic_cast<const xAOD::Jet*>(particle);
 
-  if( m_infoSwitch.m_rapidity ){
+  if( JET_SWITCH(rapidity) ){
     m_rapidity->push_back( jet->rapidity() );
   }
 
-  if ( m_infoSwitch.m_trigger ) {
+  if ( JET_SWITCH(trigger) ) {
 
     // retrieve map<string,char> w/ <chain,isMatched>
     //
@@ -2337,9 +2348,9 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     
   }
 
-  if (m_infoSwitch.m_clean || m_infoSwitch.m_cleanLight || m_infoSwitch.m_cleanNoSumm ) {
+  if (JET_SWITCH(clean) || JET_SWITCH(cleanLight) || JET_SWITCH(cleanNoSumm) ) {
 
-    if(m_infoSwitch.m_clean || m_infoSwitch.m_cleanNoSumm){
+    if(JET_SWITCH(clean) || JET_SWITCH(cleanNoSumm)){
 
       static SG::AuxElement::ConstAccessor<float> jetTime ("Timing");
       safeFill<float, float, xAOD::Jet>(jet, jetTime, m_Timing, -999);
@@ -2386,7 +2397,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
       static SG::AuxElement::ConstAccessor<float> leadClusSecondR ("LeadingClusterSecondR");
       safeFill<float, float, xAOD::Jet>(jet, leadClusSecondR, m_LeadingClusterSecondR, -999);
 
-      if(!m_infoSwitch.m_cleanNoSumm) {
+      if(!JET_SWITCH(cleanNoSumm)) {
         static SG::AuxElement::ConstAccessor<char> clean_passLooseBadUgly ("clean_passLooseBadUgly");
         safeFill<char, int, xAOD::Jet>(jet, clean_passLooseBadUgly, m_clean_passLooseBadUgly, -999);
 
@@ -2396,7 +2407,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
 
     }
 
-    if(!m_infoSwitch.m_cleanNoSumm) {
+    if(!JET_SWITCH(cleanNoSumm)) {
       static SG::AuxElement::ConstAccessor<char> clean_passLooseBad ("clean_passLooseBad");
       safeFill<char, int, xAOD::Jet>(jet, clean_passLooseBad, m_clean_passLooseBad, -999);
 
@@ -2407,9 +2418,9 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
   } // clean
 
 
-  if ( m_infoSwitch.m_energy | m_infoSwitch.m_energyLight ) {
+  if ( JET_SWITCH(energy) | JET_SWITCH(energyLight) ) {
 
-    if ( m_infoSwitch.m_energy ){
+    if ( JET_SWITCH(energy) ){
 
       static SG::AuxElement::ConstAccessor<float> HECf ("HECFrac");
       safeFill<float, float, xAOD::Jet>(jet, HECf, m_HECFrac, -999);
@@ -2440,7 +2451,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
   } // energy
 
   // each step of the calibration sequence
-  if ( m_infoSwitch.m_scales ) {
+  if ( JET_SWITCH(scales) ) {
     xAOD::JetFourMom_t fourVec;
     bool status(false);
     // EM Scale
@@ -2525,7 +2536,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     }
   }
 
-  if ( m_infoSwitch.m_constscaleEta ) {
+  if ( JET_SWITCH(constscaleEta) ) {
     xAOD::JetFourMom_t fourVec;
     bool status(false);
     status = jet->getAttribute<xAOD::JetFourMom_t>( "JetConstitScaleMomentum", fourVec );
@@ -2533,12 +2544,12 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     else { m_constScaleEta->push_back( -999 ); }
   }
 
-  if ( m_infoSwitch.m_detectorEta ) {
+  if ( JET_SWITCH(detectorEta) ) {
     static SG::AuxElement::ConstAccessor<float> DetEta ("DetectorEta");
     safeFill<float, float, xAOD::Jet>(jet, DetEta, m_detectorEta, -999);
   }
 
-  if ( m_infoSwitch.m_layer ) {
+  if ( JET_SWITCH(layer) ) {
     static SG::AuxElement::ConstAccessor< std::vector<float> > ePerSamp ("EnergyPerSampling");
     if ( ePerSamp.isAvailable( *jet ) ) {
       m_EnergyPerSampling->push_back( ePerSamp( *jet ) );
@@ -2555,7 +2566,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     }
   }
 
-  if ( m_infoSwitch.m_trackAll || m_infoSwitch.m_trackPV || m_infoSwitch.m_jvt ) {
+  if ( JET_SWITCH(trackAll) || JET_SWITCH(trackPV) || JET_SWITCH(jvt) ) {
 
     // several moments calculated from all verticies
     // one accessor for each and just use appropiately in the following
@@ -2567,7 +2578,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     static SG::AuxElement::ConstAccessor< std::vector<float> > trkWidth500 ("TrackWidthPt500");
     static SG::AuxElement::ConstAccessor< std::vector<float> > jvf("JVF");
 
-    if ( m_infoSwitch.m_trackAll ) {
+    if ( JET_SWITCH(trackAll) ) {
 
       std::vector<int> junkInt(1,-999);
       std::vector<float> junkFlt(1,-999);
@@ -2610,9 +2621,9 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
 
     } // trackAll
 
-    if ( m_infoSwitch.m_trackPV || m_infoSwitch.m_jvt ) {
+    if ( JET_SWITCH(trackPV) || JET_SWITCH(jvt) ) {
 
-      if ( m_infoSwitch.m_trackPV && pvLocation >= 0 ) {
+      if ( JET_SWITCH(trackPV) && pvLocation >= 0 ) {
 
         if ( nTrk1000.isAvailable( *jet ) ) {
           m_NumTrkPt1000PV->push_back( nTrk1000( *jet )[pvLocation] );
@@ -2675,7 +2686,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
 
   std::vector<float> junkSF(1,1.0);
 
-  if ( m_infoSwitch.m_trackPV || m_infoSwitch.m_sfJVTName == "Loose" ) {
+  if ( JET_SWITCH(trackPV) || m_infoSwitch.m_sfJVTName == "Loose" ) {
     safeFill<char, int, xAOD::Jet>(jet, jvtPass_Loose, m_JvtPass_Loose, -1);
     if ( m_mc ) {
       if ( jvtSF_Loose.isAvailable( *jet ) ) {
@@ -2686,7 +2697,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     }
   }
 
-  if ( m_infoSwitch.m_trackPV || m_infoSwitch.m_sfJVTName == "Medium" ) {
+  if ( JET_SWITCH(trackPV) || m_infoSwitch.m_sfJVTName == "Medium" ) {
     safeFill<char, int, xAOD::Jet>(jet, jvtPass_Medium, m_JvtPass_Medium, -1);
     if ( m_mc ) {
       if ( jvtSF_Medium.isAvailable( *jet ) ) {
@@ -2697,7 +2708,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     }
   }
 
-  if ( m_infoSwitch.m_trackPV || m_infoSwitch.m_sfJVTName == "Tight" ) {
+  if ( JET_SWITCH(trackPV) || m_infoSwitch.m_sfJVTName == "Tight" ) {
     safeFill<char, int, xAOD::Jet>(jet, jvtPass_Tight, m_JvtPass_Tight, -1);
     if ( m_mc ) {
       if ( jvtSF_Tight.isAvailable( *jet ) ) {
@@ -2708,7 +2719,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     }
   }
 
-  if ( m_infoSwitch.m_trackPV || m_infoSwitch.m_sffJVTName == "Medium" ) {
+  if ( JET_SWITCH(trackPV) || m_infoSwitch.m_sffJVTName == "Medium" ) {
     safeFill<char, int, xAOD::Jet>(jet, fjvtPass_Medium, m_fJvtPass_Medium, -1);
     if ( m_mc ) {
       if ( fjvtSF_Medium.isAvailable( *jet ) ) {
@@ -2719,7 +2730,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     }
   }
 
-  if ( m_infoSwitch.m_trackPV || m_infoSwitch.m_sffJVTName == "Tight" ) {
+  if ( JET_SWITCH(trackPV) || m_infoSwitch.m_sffJVTName == "Tight" ) {
     safeFill<char, int, xAOD::Jet>(jet, fjvtPass_Tight, m_fJvtPass_Tight, -1);
     if ( m_mc ) {
       if ( fjvtSF_Tight.isAvailable( *jet ) ) {
@@ -2730,7 +2741,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     }
   }
 
-  if ( m_infoSwitch.m_allTrack ) {
+  if ( JET_SWITCH(allTrack) ) {
     static SG::AuxElement::ConstAccessor< int > ghostTrackCount("GhostTrackCount");
     safeFill<int, int, xAOD::Jet>(jet, ghostTrackCount, m_GhostTrackCount, -999);
 
@@ -2763,7 +2774,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
         if( !link_itr.isValid() ) { continue; }
         const xAOD::TrackParticle* track = dynamic_cast<const xAOD::TrackParticle*>( *link_itr );
         // if asking for tracks passing PV selection ( i.e. JVF JVT tracks )
-        if( m_infoSwitch.m_allTrackPVSel ) {
+        if( JET_SWITCH(allTrackPVSel) ) {
           // PV selection from
           // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/JvtManualRecalculation
           if( track->pt() < 500 )                { continue; } // pT cut
@@ -2780,7 +2791,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
         e.  push_back( track->e()  / m_units );
         d0. push_back( track->d0() );
         z0. push_back( track->z0() + track->vz() - pv->z() ); // store z0 wrt PV...most useful
-        if( m_infoSwitch.m_allTrackDetail ) {
+        if( JET_SWITCH(allTrackDetail) ) {
           uint8_t getInt(0);
           // n pix, sct, trt
           track->summaryValue( getInt, xAOD::numberOfPixelHits );
@@ -2818,7 +2829,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     m_GhostTrack_e->  push_back( e   );
     m_GhostTrack_d0-> push_back( d0  );
     m_GhostTrack_z0-> push_back( z0  );
-    if( m_infoSwitch.m_allTrackDetail ) {
+    if( JET_SWITCH(allTrackDetail) ) {
       m_GhostTrack_nPixelHits->push_back( nPixHits );
       m_GhostTrack_nSCTHits->push_back( nSCTHits );
       m_GhostTrack_nTRTHits->push_back( nTRTHits );
@@ -2833,11 +2844,11 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     }
   } // allTrack switch
 
-  if( m_infoSwitch.m_constituent ) {
+  if( JET_SWITCH(constituent) ) {
     m_numConstituents->push_back( jet->numConstituents() );
   }
 
-  if( m_infoSwitch.m_constituentAll ) {
+  if( JET_SWITCH(constituentAll) ) {
     m_constituentWeights->push_back( jet->getAttribute< std::vector<float> >( "constituentWeights" ) );
     std::vector<float> pt;
     std::vector<float> eta;
@@ -2864,16 +2875,16 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     m_constituent_e->  push_back( e   );
   }
 
-  if ( m_infoSwitch.m_flavorTag || m_infoSwitch.m_flavorTagHLT ) {
+  if ( JET_SWITCH(flavorTag) || JET_SWITCH(flavorTagHLT) ) {
     const xAOD::BTagging * myBTag(0);
 
-    if(m_infoSwitch.m_flavorTag){
+    if(JET_SWITCH(flavorTag)){
       myBTag = jet->btagging();
-    }else if(m_infoSwitch.m_flavorTagHLT){
+    }else if(JET_SWITCH(flavorTagHLT)){
       myBTag = jet->auxdata< const xAOD::BTagging* >("HLTBTag");
     }
 
-    if(m_infoSwitch.m_JVC ) {
+    if(JET_SWITCH(JVC) ) {
       static SG::AuxElement::ConstAccessor<double> JetVertexCharge_discriminant("JetVertexCharge_discriminant");
       safeFill<double, double, xAOD::BTagging>(myBTag, JetVertexCharge_discriminant, m_JetVertexCharge_discriminant, -999);
     }
@@ -2943,7 +2954,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
     static SG::AuxElement::ConstAccessor<int> hadConeExclExtendedTruthLabel("HadronConeExclExtendedTruthLabelID");
     safeFill<int, int, xAOD::Jet>(jet, hadConeExclExtendedTruthLabel, m_HadronConeExclExtendedTruthLabelID, -999);
 
-    if(m_infoSwitch.m_jetFitterDetails ) {
+    if(JET_SWITCH(jetFitterDetails) ) {
 
       static SG::AuxElement::ConstAccessor< int   > jf_nVTXAcc       ("JetFitter_nVTX");
       safeFill<int, float, xAOD::BTagging>(myBTag, jf_nVTXAcc, m_JetFitter_nVTX, -999);
@@ -2983,7 +2994,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
 
     }
 
-    if(m_infoSwitch.m_svDetails ) {
+    if(JET_SWITCH(svDetails) ) {
       if(m_debug) std::cout << "Filling m_svDetails " << std::endl;
 
       /// @brief SV0 : Number of good tracks in vertex
@@ -3063,7 +3074,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
 
     }
 
-    if(m_infoSwitch.m_ipDetails ) {
+    if(JET_SWITCH(ipDetails) ) {
       if(m_debug) std::cout << "Filling m_ipDetails " << std::endl;
 
       //
@@ -3167,7 +3178,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
 
 
 
-    if(m_infoSwitch.m_flavorTagHLT ) {
+    if(JET_SWITCH(flavorTagHLT) ) {
       if(m_debug) std::cout << "Filling m_flavorTagHLT " << std::endl;
       const xAOD::Vertex *online_pvx       = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx");
       const xAOD::Vertex *online_pvx_bkg   = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx_bkg");
@@ -3248,7 +3259,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
       btag->Fill( jet );
   } // jetBTag
 
-  if ( m_infoSwitch.m_area ) {
+  if ( JET_SWITCH(area) ) {
 
     static SG::AuxElement::ConstAccessor<float> ghostArea("JetGhostArea");
     safeFill<float, float, xAOD::Jet>(jet, ghostArea, m_GhostArea, -999);
@@ -3273,7 +3284,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
   }
 
 
-  if ( m_infoSwitch.m_truth && m_mc ) {
+  if ( JET_SWITCH(truth) && m_mc ) {
 
     static SG::AuxElement::ConstAccessor<int> ConeTruthLabelID ("ConeTruthLabelID");
     safeFill<int, int, xAOD::Jet>(jet, ConeTruthLabelID, m_ConeTruthLabelID, -999);
@@ -3317,7 +3328,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
 
   }
 
-  if ( m_infoSwitch.m_truthDetails ) {
+  if ( JET_SWITCH(truthDetails) ) {
 
     //
     // B-Hadron Details
@@ -3395,7 +3406,7 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
   }
 
 
-  if ( m_infoSwitch.m_charge ) {
+  if ( JET_SWITCH(charge) ) {
     xAOD::JetFourMom_t p4UsedInJetCharge;
     bool status = jet->getAttribute<xAOD::JetFourMom_t>( "JetPileupScaleMomentum", p4UsedInJetCharge );
     static SG::AuxElement::ConstAccessor<float>              uncalibratedJetCharge ("Charge");
@@ -3412,3 +3423,14 @@ void JetContainer::FillJet( const xAOD::IParticle* particle, const xAOD::Vertex*
 
   return;
 }
+
+#undef JET_SWITCH
+
+template <uint64_t... MASKS>
+JetContainer::FillJetKernel_t JetContainer::findFillJetKernel(uint64_t mask, HelperClasses::SwitchConfigs<MASKS...>)
+{
+  FillJetKernel_t kernel = &JetContainer::FillJetKernel<HelperClasses::RuntimeSwitches>;
+  // pick the kernel specialised on exactly this configuration, if there is one
+  (void)std::initializer_list<int>{ (mask == MASKS ? (kernel = &JetContainer::FillJetKernel<MASKS>, 0) : 0)... };
+  return kernel;
+}
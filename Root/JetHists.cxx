@@ -1,5 +1,6 @@
 #include <xAODAnaHelpers/JetHists.h>
 #include <sstream>
+#include <initializer_list>
 #include <math.h>       /* hypot */
 
 ANA_MSG_SOURCE(msgJetHists, "JetHists")
@@ -12,7 +13,9 @@ JetHists :: JetHists (std::string name, std::string detailStr, const std::string
   m_titlePrefix(titlePrefix),
   m_onlineBSTool(),
   m_tracksInJet(0)
-{ }
+{
+  m_executeKernel = findExecuteKernel(m_infoSwitch->mask(), HelperClasses::JetFillConfigs());
+}
 
 JetHists :: ~JetHists () {
   if(m_infoSwitch) delete m_infoSwitch;
@@ -370,6 +373,8 @@ StatusCode JetHists::initialize() {
     m_nTrk                      = book(m_name, "nTrk", "nTrk", 100, -0.5, 99.5);
 
     m_tracksInJet = new TracksInJetHists(m_name+"trk_", "");
+    m_tracksInJet -> setLazyBooking( m_lazyBooking );
+    m_tracksInJet -> setStorage( m_storage );
     m_tracksInJet -> initialize( );
   }
 
@@ -552,11 +557,27 @@ void JetHists::record(EL::Worker* wk) {
   }
 }
 
+HistogramManager::MemoryUsage JetHists::memoryUsage() const {
+  MemoryUsage usage = HistogramManager::memoryUsage();
+  if(m_infoSwitch->m_tracksInJet){
+    usage += m_tracksInJet -> memoryUsage();
+  }
+  return usage;
+}
+
 StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, const xAOD::EventInfo* eventInfo  ) {
   return execute(static_cast<const xAOD::IParticle*>(jet), eventWeight, eventInfo);
 }
 
 StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight, const xAOD::EventInfo* eventInfo ) {
+  return (this->*m_executeKernel)(particle, eventWeight, eventInfo);
+}
+
+// a switch of the detail string, a compile-time constant in the kernels specialised on a configuration
+#define JET_SWITCH(name) HelperClasses::switchOn<MASK>(HelperClasses::JetSwitch::name, m_infoSwitch->m_##name)
+
+template <uint64_t MASK>
+StatusCode JetHists::executeKernel( const xAOD::IParticle* particle, float eventWeight, const xAOD::EventInfo* eventInfo ) {
   using namespace msgJetHists;
   ANA_CHECK( IParticleHists::execute(particle, eventWeight, eventInfo));
 
@@ -571,7 +592,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
     }
 
   // clean
-  if( m_infoSwitch->m_clean ) {
+  if( JET_SWITCH(clean) ) {
     if(m_debug) std::cout << "JetHists: m_clean " <<std::endl;
 
     static SG::AuxElement::ConstAccessor<float> jetTime ("Timing");
@@ -626,19 +647,19 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
   } // fillClean
 
   // Pileup
-  if(m_infoSwitch->m_vsActualMu){
+  if(JET_SWITCH(vsActualMu)){
     float actualMu = eventInfo->actualInteractionsPerCrossing();
     m_actualMu->Fill(actualMu, eventWeight);
   }
 
-  if (m_infoSwitch->m_byAverageMu)
+  if (JET_SWITCH(byAverageMu))
   {
     float averageMu = eventInfo->averageInteractionsPerCrossing();
     m_avgMu->Fill(averageMu, eventWeight);
   }
 
   // energy
-  if( m_infoSwitch->m_energy ) {
+  if( JET_SWITCH(energy) ) {
     if(m_debug) std::cout << "JetHists: m_energy " <<std::endl;
 
     static SG::AuxElement::ConstAccessor<float> HECf ("HECFrac");
@@ -684,7 +705,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 
   }
 
-  if( m_infoSwitch->m_layer ){
+  if( JET_SWITCH(layer) ){
     if(m_debug) std::cout << "JetHists: m_layer " <<std::endl;
 
     static SG::AuxElement::ConstAccessor< vector<float> > ePerSamp ("EnergyPerSampling");
@@ -825,7 +846,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
  // 0042       TruthMF,
  // 0043       TruthMFindex,
 
-  if( m_infoSwitch->m_truth ) {
+  if( JET_SWITCH(truth) ) {
     if(m_debug) std::cout << "JetHists: m_truth " <<std::endl;
 
     static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
@@ -871,7 +892,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
   }
 
 
-  if( m_infoSwitch->m_truthDetails ) {
+  if( JET_SWITCH(truthDetails) ) {
     if(m_debug) std::cout << "JetHists: m_truthDetails " <<std::endl;
 
     //
@@ -962,7 +983,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
   //
   // JVC
   //
-  // if(m_infoSwitch->m_JVC) {
+  // if(JET_SWITCH(JVC)) {
   //   if(m_debug) std::cout << "JetHists: m_JVC " << std::endl;
   //   m_JVC->Fill(jet->JVC, eventWeight);
   // }
@@ -970,12 +991,12 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
   //
   // BTagging
   //
-  if( m_infoSwitch->m_flavorTag || m_infoSwitch->m_flavorTagHLT ) {
+  if( JET_SWITCH(flavorTag) || JET_SWITCH(flavorTagHLT) ) {
     if(m_debug) std::cout << "JetHists: m_flavorTag " <<std::endl;
     const xAOD::BTagging *btag_info(0);
-    if(m_infoSwitch->m_flavorTag){
+    if(JET_SWITCH(flavorTag)){
       btag_info = jet->btagging();
-    }else if(m_infoSwitch->m_flavorTagHLT){
+    }else if(JET_SWITCH(flavorTagHLT)){
       btag_info = jet->auxdata< const xAOD::BTagging* >("HLTBTag");
     }
 
@@ -990,7 +1011,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
     m_MV2c10_l ->  Fill( MV2c10, eventWeight );
     m_MV2c20   ->  Fill( MV2c20, eventWeight );
 
-    if(m_infoSwitch->m_vsLumiBlock || m_infoSwitch->m_vsActualMu){
+    if(JET_SWITCH(vsLumiBlock) || JET_SWITCH(vsActualMu)){
 
 
       bool passMV2c1040 = (MV2c10 > 0.975);
@@ -1001,7 +1022,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
       bool passMV2c1085 = (MV2c10 > 0.11);
 
 
-      if(m_infoSwitch->m_flavorTagHLT){
+      if(JET_SWITCH(flavorTagHLT)){
 	passMV2c1040 = (MV2c10 >  0.978);
 	passMV2c1050 = (MV2c10 >  0.948);
 	passMV2c1060 = (MV2c10 >  0.847);
@@ -1012,7 +1033,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
       }
 
 
-      if(m_infoSwitch->m_vsLumiBlock){
+      if(JET_SWITCH(vsLumiBlock)){
 	uint32_t lumiBlock = eventInfo->lumiBlock();
 
 	m_frac_MV240_vs_lBlock  -> Fill(lumiBlock, passMV2c1040,  eventWeight);
@@ -1024,7 +1045,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
       }
 
 
-      if(m_infoSwitch->m_vsActualMu){
+      if(JET_SWITCH(vsActualMu)){
 	float actualMu = eventInfo->actualInteractionsPerCrossing();
 
 	m_frac_MV240_vs_actMu  -> Fill(actualMu, passMV2c1040,  eventWeight);
@@ -1043,7 +1064,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
       m_JetFitter       ->  Fill( btag_info->JetFitter_loglikelihoodratio() , eventWeight );
     }
 
-    if(m_infoSwitch->m_btag_jettrk){
+    if(JET_SWITCH(btag_jettrk)){
       if(m_debug) std::cout << "JetHists: m_btag_jettrk " <<std::endl;
       unsigned trkSum_ntrk   = btag_info->isAvailable<unsigned>("trkSum_ntrk") ? btag_info->auxdata<unsigned>("trkSum_ntrk") : -1;
       float    trkSum_sPt    = btag_info->isAvailable<float   >("trkSum_SPt" ) ? btag_info->auxdata<float   >("trkSum_SPt" ) : -1000;//<== -1 GeV
@@ -1138,7 +1159,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
     }
 
 
-    if(m_infoSwitch->m_jetFitterDetails){
+    if(JET_SWITCH(jetFitterDetails)){
       if(m_debug) std::cout << "JetHists: m_jetFitterDetails " <<std::endl;
       static SG::AuxElement::ConstAccessor< int   > jf_nVTXAcc       ("JetFitter_nVTX");
       static SG::AuxElement::ConstAccessor< int   > jf_nSingleTracks ("JetFitter_nSingleTracks");
@@ -1183,7 +1204,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 
     }
 
-    if(m_infoSwitch->m_svDetails){
+    if(JET_SWITCH(svDetails)){
       if(m_debug) std::cout << "JetHists: m_svDetails " <<std::endl;
       //
       // SV0
@@ -1258,7 +1279,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
     }
 
 
-    if(m_infoSwitch->m_ipDetails){
+    if(JET_SWITCH(ipDetails)){
       if(m_debug) std::cout << "JetHists: m_ipDetails " <<std::endl;
       //
       // IP2D
@@ -1423,7 +1444,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 
 
   // testing
-  if( m_infoSwitch->m_resolution ) {
+  if( JET_SWITCH(resolution) ) {
     if(m_debug) std::cout << "JetHists: m_resolution " <<std::endl;
     //float ghostTruthPt = jet->getAttribute( xAOD::JetAttribute::GhostTruthPt );
     float ghostTruthPt = jet->auxdata< float >( "GhostTruthPt" );
@@ -1433,7 +1454,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
     m_jetGhostTruthPt_vs_resolution -> Fill( ghostTruthPt/1e3, resolution, eventWeight );
   }
 
-  if( m_infoSwitch->m_substructure ){
+  if( JET_SWITCH(substructure) ){
     if(m_debug) std::cout << "JetHists: m_substructure " <<std::endl;
     static SG::AuxElement::ConstAccessor<float> Tau1("Tau1");
     static SG::AuxElement::ConstAccessor<float> Tau2("Tau2");
@@ -1457,9 +1478,9 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 
   }
 
-  if(m_debug) std::cout << m_name << "::Matching tracks in Jet: " << m_infoSwitch->m_tracksInJet << std::endl;
+  if(m_debug) std::cout << m_name << "::Matching tracks in Jet: " << JET_SWITCH(tracksInJet) << std::endl;
 
-  if( m_infoSwitch->m_tracksInJet ){
+  if( JET_SWITCH(tracksInJet) ){
     if(m_debug) std::cout << "JetHists: m_tracksInJet " <<std::endl;
     const vector<const xAOD::TrackParticle*> matchedTracks = jet->auxdata< vector<const xAOD::TrackParticle*>  >(m_infoSwitch->m_trackName);
     const xAOD::Vertex *pvx  = jet->auxdata<const xAOD::Vertex*>(m_infoSwitch->m_trackName+"_vtx");
@@ -1472,19 +1493,19 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
     }
   }
 
-  if(  m_infoSwitch->m_byEta ){
+  if(  JET_SWITCH(byEta) ){
     if (fabs(jet->eta()) < 1)           m_jetPt_eta_0_1   -> Fill(jet->pt()/1e3, eventWeight);
     else if ( fabs(jet->eta()) < 2 ){   m_jetPt_eta_1_2   -> Fill(jet->pt()/1e3, eventWeight); m_jetPt_eta_1_2p5 -> Fill(jet->pt()/1e3, eventWeight);}
     else if ( fabs(jet->eta()) < 2.5 ){ m_jetPt_eta_2_2p5 -> Fill(jet->pt()/1e3, eventWeight); m_jetPt_eta_1_2p5 -> Fill(jet->pt()/1e3, eventWeight);}
   }
 
-  if(  m_infoSwitch->m_onlineBS ){
+  if(  JET_SWITCH(onlineBS) ){
 
     float bs_online_vx = jet->auxdata< float >("bs_online_vx");
     float bs_online_vy = jet->auxdata< float >("bs_online_vy");
     float bs_online_vz = jet->auxdata< float >("bs_online_vz");
 
-    if( m_infoSwitch->m_onlineBSTool ){
+    if( JET_SWITCH(onlineBSTool) ){
       // Over-ride with onlineBSToolInfo
       bs_online_vx = m_onlineBSTool.getOnlineBSInfo(eventInfo, xAH::OnlineBeamSpotTool::BSData::BSx);
       bs_online_vy = m_onlineBSTool.getOnlineBSInfo(eventInfo, xAH::OnlineBeamSpotTool::BSData::BSy);
@@ -1502,7 +1523,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 
 
 
-    if(m_infoSwitch->m_lumiB_runN){
+    if(JET_SWITCH(lumiB_runN)){
       uint32_t lumiBlock = eventInfo->lumiBlock();
       uint32_t runNumber = eventInfo->runNumber();
 
@@ -1515,7 +1536,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
   }
 
 
-  if( m_infoSwitch->m_hltVtxComp || m_infoSwitch->m_onlineBS ){
+  if( JET_SWITCH(hltVtxComp) || JET_SWITCH(onlineBS) ){
     const xAOD::Vertex *online_pvx     = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx");
     const xAOD::Vertex *online_pvx_bkg = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx_bkg");
     const xAOD::Vertex *offline_pvx    = jet->auxdata<const xAOD::Vertex*>("offline_vtx");
@@ -1530,7 +1551,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 
     m_vtxClass -> Fill(vtxClassInt, eventWeight);
 
-    if(m_infoSwitch->m_hltVtxComp){
+    if(JET_SWITCH(hltVtxComp)){
 
       if(online_pvx)  m_vtxOnlineValid ->Fill(1.0, eventWeight);
       else            m_vtxOnlineValid ->Fill(0.0, eventWeight);
@@ -1591,7 +1612,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 	m_vtx_online_x0_vs_vtx_online_z0 -> Fill(online_pvx->z(), online_pvx->x(), eventWeight);
 
 
-	if(m_infoSwitch->m_vsLumiBlock){
+	if(JET_SWITCH(vsLumiBlock)){
 	  uint32_t lumiBlock = eventInfo->lumiBlock();
 
 	  m_vtxDiffx0_vs_lBlock     ->Fill(lumiBlock, vtxDiffx0          , eventWeight);
@@ -1617,7 +1638,7 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
 	}
 
 
-	if(m_infoSwitch->m_lumiB_runN){
+	if(JET_SWITCH(lumiB_runN)){
 	  uint32_t lumiBlock = eventInfo->lumiBlock();
 	  uint32_t runNumber = eventInfo->runNumber();
 	  m_lumiB_runN              -> Fill(lumiBlock, runNumber, eventWeight);
@@ -1639,6 +1660,17 @@ StatusCode JetHists::execute( const xAOD::IParticle* particle, float eventWeight
   return StatusCode::SUCCESS;
 }
 
+#undef JET_SWITCH
+
+template <uint64_t... MASKS>
+JetHists::ExecuteKernel_t JetHists::findExecuteKernel(uint64_t mask, HelperClasses::SwitchConfigs<MASKS...>)
+{
+  ExecuteKernel_t kernel = &JetHists::executeKernel<HelperClasses::RuntimeSwitches>;
+  // pick the kernel specialised on exactly this configuration, if there is one
+  (void)std::initializer_list<int>{ (mask == MASKS ? (kernel = &JetHists::executeKernel<MASKS>, 0) : 0)... };
+  return kernel;
+}
+
 StatusCode JetHists::execute( const xAH::Jet* jet, float eventWeight, const xAH::EventInfo* eventInfo ) {
   return execute(static_cast<const xAH::Particle*>(jet), eventWeight, eventInfo);
 }
@@ -31,3 +31,8 @@ EL::StatusCode JetHistsAlgo :: execute ()
 {
   return IParticleHistsAlgo::execute<JetHists, xAOD::JetContainer>();
 }
+
+std::string JetHistsAlgo :: declaredInputs () const
+{
+  return IParticleHistsAlgo::declaredInputs() + HelperClasses::JetInfoSwitch(m_detailStr).inputs();
+}
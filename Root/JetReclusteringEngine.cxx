@@ -0,0 +1,121 @@
+#include <xAODAnaHelpers/JetReclusteringEngine.h>
+
+#include <algorithm>
+
+#include <fastjet/ClusterSequence.hh>
+#include <fastjet/Selector.hh>
+#include <JetEDM/JetConstituentFiller.h>
+
+namespace {
+  // below this many inputs, N2Plain beats the strategies fastjet would choose
+  const std::size_t s_smallN = 30;
+
+  bool higherPt( const fastjet::PseudoJet& lhs, const fastjet::PseudoJet& rhs ) { return lhs.perp2() > rhs.perp2(); }
+}
+
+xAH::JetReclusteringEngine::JetReclusteringEngine( double radius, double fcut, fastjet::JetAlgorithm rc_alg,
+                                                   double subjetRadius, fastjet::JetAlgorithm subjetAlg ) :
+  m_radius( -1. ),
+  m_fcut( -1. )
+{
+  configure( radius, fcut, rc_alg, subjetRadius, subjetAlg );
+}
+
+void xAH::JetReclusteringEngine::configure( double radius, double fcut, fastjet::JetAlgorithm rc_alg, double subjetRadius, fastjet::JetAlgorithm subjetAlg )
+{
+  if ( radius == m_radius && fcut == m_fcut && rc_alg == m_rcAlg && subjetRadius == m_subjetRadius && subjetAlg == m_subjetAlg ) return;
+
+  m_radius = radius;
+  m_fcut = fcut;
+  m_rcAlg = rc_alg;
+  m_subjetRadius = subjetRadius;
+  m_subjetAlg = subjetAlg;
+  m_rcSmall      = fastjet::JetDefinition( rc_alg, radius, fastjet::E_scheme, fastjet::N2Plain );
+  m_rcLarge      = fastjet::JetDefinition( rc_alg, radius, fastjet::E_scheme, fastjet::Best );
+  m_trimmerSmall = fastjet::Filter( fastjet::JetDefinition( subjetAlg, subjetRadius, fastjet::E_scheme, fastjet::N2Plain ), fastjet::SelectorPtFractionMin( fcut ) );
+  m_trimmerLarge = fastjet::Filter( fastjet::JetDefinition( subjetAlg, subjetRadius, fastjet::E_scheme, fastjet::Best ), fastjet::SelectorPtFractionMin( fcut ) );
+}
+
+const fastjet::JetDefinition& xAH::JetReclusteringEngine::definition( const fastjet::JetDefinition& small, const fastjet::JetDefinition& large, std::size_t n ) const
+{
+  return ( n < s_smallN ) ? small : large;
+}
+
+void xAH::JetReclusteringEngine::fillInputs( const xAOD::JetContainer* jets )
+{
+  m_inputs.clear();
+  for ( const auto jet : *jets ) {
+    m_inputs.emplace_back( jet->px()/1000., jet->py()/1000., jet->pz()/1000., jet->e()/1000. );
+  }
+}
+
+void xAH::JetReclusteringEngine::fillResult( std::vector<TLorentzVector>& result )
+{
+  // notes: the trimmed jets are not sorted by pt any more
+  std::sort( m_trimmed.begin(), m_trimmed.end(), higherPt );
+
+  result.clear();
+  for ( const auto& pjet : m_trimmed ) {
+    result.emplace_back( pjet.px(), pjet.py(), pjet.pz(), pjet.e() );
+  }
+}
+
+void xAH::JetReclusteringEngine::reclusterInputs( std::vector<TLorentzVector>& result )
+{
+  m_trimmed.clear();
+  if ( !m_inputs.empty() ) {
+    fastjet::ClusterSequence cs( m_inputs, definition( m_rcSmall, m_rcLarge, m_inputs.size() ) );
+
+    // trimming: only keep the small-R jets above fcut of the pt of the reclustered jet
+    for ( const auto& rc_jet : cs.inclusive_jets() ) {
+      const double ptcut = m_fcut*rc_jet.pt();
+      fastjet::PseudoJet rc_t_jet( 0., 0., 0., 0. );
+      for ( const auto& subjet : rc_jet.constituents() ) {
+        if ( subjet.pt() > ptcut ) rc_t_jet += subjet;
+      }
+      m_trimmed.push_back( rc_t_jet );
+    }
+  }
+  fillResult( result );
+}
+
+const std::vector<TLorentzVector>& xAH::JetReclusteringEngine::recluster( const xAOD::JetContainer* jets )
+{
+  fillInputs( jets );
+  reclusterInputs( m_result );
+  return m_result;
+}
+
+fastjet::PseudoJet xAH::JetReclusteringEngine::trimmedPseudoJet( const xAOD::Jet* jet )
+{
+  const std::vector<fastjet::PseudoJet> constituents = jet::JetConstituentFiller::constituentPseudoJets( *jet );
+  if ( constituents.empty() ) return fastjet::PseudoJet( 0., 0., 0., 0. );
+
+  if ( jet->getAlgorithmType() != m_jetAlg || jet->getSizeParameter() != m_jetRadius ) {
+    m_jetAlg = jet->getAlgorithmType();
+    m_jetRadius = jet->getSizeParameter();
+    m_jetSmall = fastjet::JetDefinition( (fastjet::JetAlgorithm) m_jetAlg, m_jetRadius, fastjet::E_scheme, fastjet::N2Plain );
+    m_jetLarge = fastjet::JetDefinition( (fastjet::JetAlgorithm) m_jetAlg, m_jetRadius, fastjet::E_scheme, fastjet::Best );
+  }
+
+  // recluster the constituents with the algorithm and radius of the jet, then trim the result
+  fastjet::ClusterSequence cs( constituents, definition( m_jetSmall, m_jetLarge, constituents.size() ) );
+  const fastjet::Filter& trimmer = ( constituents.size() < s_smallN ) ? m_trimmerSmall : m_trimmerLarge;
+  return trimmer( fastjet::join( cs.inclusive_jets() ) );
+}
+
+TLorentzVector xAH::JetReclusteringEngine::trim( const xAOD::Jet* jet )
+{
+  const fastjet::PseudoJet t_jet = trimmedPseudoJet( jet );
+  return TLorentzVector( t_jet.px(), t_jet.py(), t_jet.pz(), t_jet.e() );
+}
+
+const std::vector<TLorentzVector>& xAH::JetReclusteringEngine::trim( const xAOD::JetContainer* jets )
+{
+  m_trimmed.clear();
+  for ( const auto jet : *jets ) {
+    m_trimmed.push_back( trimmedPseudoJet( jet ) );
+  }
+  fillResult( m_result );
+  return m_result;
+}
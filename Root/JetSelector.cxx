@@ -137,16 +137,35 @@ EL::StatusCode JetSelector :: initialize ()
     //
     m_jet_cutflowHist_1 = (TH1D*)file->Get("cutflow_jets_1");
 
-    m_jet_cutflow_all             = m_jet_cutflowHist_1->GetXaxis()->FindBin("all");
-    m_jet_cutflow_ptmax_cut       = m_jet_cutflowHist_1->GetXaxis()->FindBin("ptmax_cut");
-    m_jet_cutflow_ptmin_cut       = m_jet_cutflowHist_1->GetXaxis()->FindBin("ptmin_cut");
-    m_jet_cutflow_eta_cut         = m_jet_cutflowHist_1->GetXaxis()->FindBin("eta_cut");
-    m_jet_cutflow_jvt_cut         = m_jet_cutflowHist_1->GetXaxis()->FindBin("JVT_cut");
-    m_jet_cutflow_btag_cut        = m_jet_cutflowHist_1->GetXaxis()->FindBin("BTag_cut");
-    m_jet_cutflow_cleaning_cut    = m_jet_cutflowHist_1->GetXaxis()->FindBin("cleaning_cut");
+    m_jet_cutflow.setHist( m_jet_cutflowHist_1 );
+    m_jet_cutflow.bookBin( JetCut::all,      "all" );
+    m_jet_cutflow.bookBin( JetCut::ptmax,    "ptmax_cut" );
+    m_jet_cutflow.bookBin( JetCut::ptmin,    "ptmin_cut" );
+    m_jet_cutflow.bookBin( JetCut::eta,      "eta_cut" );
+    m_jet_cutflow.bookBin( JetCut::JVT,      "JVT_cut" );
+    m_jet_cutflow.bookBin( JetCut::BTag,     "BTag_cut" );
+    m_jet_cutflow.bookBin( JetCut::cleaning, "cleaning_cut" );
 
   }
 
+  // default order of the object cuts: they can be reordered only if no cutflow is filled.
+  // The jet attributes read by the cuts are set for the whole container, so none of them depends on the cuts before it
+  //
+  m_jet_cutOrder.setOrder( { JetCut::ptmax, JetCut::ptmin, JetCut::eta, JetCut::detEta, JetCut::mass, JetCut::rapidity,
+                             JetCut::JVF, JetCut::fJVT, JetCut::JVT, JetCut::BTag, JetCut::HLTBTag, JetCut::HLTVtx,
+                             JetCut::passKeys, JetCut::failKeys, JetCut::truthLabel },
+                           { "ptmax_cut", "ptmin_cut", "eta_cut", "detEta_cut", "mass_cut", "rapidity_cut",
+                             "JVF_cut", "fJVT_cut", "JVT_cut", "BTag_cut", "HLTBTag_cut", "HLTVtx_cut",
+                             "passKeys", "failKeys", "truthLabel_cut" } );
+  if ( m_adaptiveCutOrder ) {
+    if ( m_useCutFlow ) {
+      ANA_MSG_WARNING( "m_adaptiveCutOrder is ignored when filling the cutflow: the cuts will be applied in the default order");
+    } else {
+      ANA_MSG_INFO( "Cuts will be reordered after " << m_nAdaptiveCutOrderEvents << " events to minimise the time spent per jet");
+      m_jet_cutOrder.setLearningEvents( m_nAdaptiveCutOrderEvents );
+    }
+  }
+
   //If not set, find default from input container name
   if (m_jetScaleType.size() == 0){
     if( m_inContainerName.find("EMTopo") != std::string::npos){
@@ -379,6 +398,10 @@ EL::StatusCode JetSelector :: execute ()
 
   m_numEvent++;
 
+  if ( m_jet_cutOrder.nextEvent() ) {
+    ANA_MSG_INFO( "Jet cuts reordered after " << m_numEvent << " events:\n" << m_jet_cutOrder.summary() );
+  }
+
   // QUESTION: why this must be done in execute(), and does not work in initialize()?
   //
   if ( m_numEvent == 1 && m_trigDecTool_handle.isInitialized() ) {
@@ -570,7 +593,7 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
       }// if jet is not clean
     }// if jet clean aux missing
     if( m_useCutFlow && passSel )
-      m_jet_cutflowHist_1->Fill( m_jet_cutflow_cleaning_cut, 1 );
+      m_jet_cutflow.count( JetCut::cleaning );
 
 
 
@@ -993,6 +1016,7 @@ EL::StatusCode JetSelector :: finalize ()
     ANA_MSG_DEBUG( "Filling cutflow");
     m_cutflowHist ->SetBinContent( m_cutflow_bin, m_numEventPass        );
     m_cutflowHistW->SetBinContent( m_cutflow_bin, m_weightNumEventPass  );
+    m_jet_cutflow.flush();
   }
 
   return EL::StatusCode::SUCCESS;
@@ -1022,199 +1046,290 @@ int JetSelector :: PassCuts( const xAOD::Jet* jet ) {
   ANA_MSG_DEBUG("In pass cuts");
 
   // fill cutflow bin 'all' before any cut
-  if(m_useCutFlow) m_jet_cutflowHist_1->Fill( m_jet_cutflow_all, 1 );
+  if ( m_useCutFlow ) m_jet_cutflow.count( JetCut::all );
 
-  // pT
-  if ( m_pT_max != 1e8 ) {
-    if ( jet->pt() > m_pT_max ) { return 0; }
+  // the cuts are applied in the default order, unless the adaptive ordering has been requested (and no cutflow is filled)
+  //
+  for ( auto cut : m_jet_cutOrder.order() ) {
+    auto start = m_jet_cutOrder.start();
+    bool pass  = this->applyCut( cut, jet );
+    m_jet_cutOrder.record( cut, pass, start );
+    if ( !pass ) { return 0; }
   }
-  if(m_useCutFlow) m_jet_cutflowHist_1->Fill( m_jet_cutflow_ptmax_cut, 1 );
 
-  if ( m_pT_min != 1e8 ) {
-    if ( jet->pt() < m_pT_min ) { return 0; }
+  ANA_MSG_DEBUG("Passed Cuts");
+  return 1;
+}
+
+bool JetSelector :: applyCut( JetCut cut, const xAOD::Jet* jet ) {
+
+  switch ( cut ) {
+
+  //
+  // pT max
+  //
+  case JetCut::ptmax : {
+    if ( m_pT_max != 1e8 ) {
+      if ( jet->pt() > m_pT_max ) { return false; }
+    }
+    if ( m_useCutFlow ) m_jet_cutflow.count( JetCut::ptmax );
+    return true;
   }
-  if(m_useCutFlow) m_jet_cutflowHist_1->Fill( m_jet_cutflow_ptmin_cut, 1 );
 
-  // eta
-  if ( m_eta_max != 1e8 ) {
-    if ( fabs(jet->eta()) > m_eta_max ) { return 0; }
+  //
+  // pT min
+  //
+  case JetCut::ptmin : {
+    if ( m_pT_min != 1e8 ) {
+      if ( jet->pt() < m_pT_min ) { return false; }
+    }
+    if ( m_useCutFlow ) m_jet_cutflow.count( JetCut::ptmin );
+    return true;
   }
-  if ( m_eta_min != 1e8 ) {
-    if ( fabs(jet->eta()) < m_eta_min ) { return 0; }
+
+  //
+  // eta
+  //
+  case JetCut::eta : {
+    if ( m_eta_max != 1e8 ) {
+      if ( fabs(jet->eta()) > m_eta_max ) { return false; }
+    }
+    if ( m_eta_min != 1e8 ) {
+      if ( fabs(jet->eta()) < m_eta_min ) { return false; }
+    }
+    if ( m_useCutFlow ) m_jet_cutflow.count( JetCut::eta );
+    return true;
   }
-  if(m_useCutFlow) m_jet_cutflowHist_1->Fill( m_jet_cutflow_eta_cut, 1 );
 
+  //
   // detEta
-  if ( m_detEta_max != 1e8 ) {
-    if ( fabs( ( jet->getAttribute<xAOD::JetFourMom_t>(m_jetScaleType.c_str()) ).eta() ) > m_detEta_max ) { return 0; }
-  }
-  if ( m_detEta_min != 1e8 ) {
-    if ( fabs( ( jet->getAttribute<xAOD::JetFourMom_t>(m_jetScaleType.c_str()) ).eta() ) < m_detEta_min ) { return 0; }
+  //
+  case JetCut::detEta : {
+    if ( m_detEta_max != 1e8 ) {
+      if ( fabs( ( jet->getAttribute<xAOD::JetFourMom_t>(m_jetScaleType.c_str()) ).eta() ) > m_detEta_max ) { return false; }
+    }
+    if ( m_detEta_min != 1e8 ) {
+      if ( fabs( ( jet->getAttribute<xAOD::JetFourMom_t>(m_jetScaleType.c_str()) ).eta() ) < m_detEta_min ) { return false; }
+    }
+    return true;
   }
 
+  //
   // mass
-  if ( m_mass_max != 1e8 ) {
-    if ( jet->m() > m_mass_max ) { return 0; }
-  }
-  if ( m_mass_min != 1e8 ) {
-    if ( jet->m() < m_mass_min ) { return 0; }
+  //
+  case JetCut::mass : {
+    if ( m_mass_max != 1e8 ) {
+      if ( jet->m() > m_mass_max ) { return false; }
+    }
+    if ( m_mass_min != 1e8 ) {
+      if ( jet->m() < m_mass_min ) { return false; }
+    }
+    return true;
   }
 
+  //
   // rapidity
-  if ( m_rapidity_max != 1e8 ) {
-    if ( jet->rapidity() > m_rapidity_max ) { return 0; }
-  }
-  if ( m_rapidity_min != 1e8 ) {
-    if ( jet->rapidity() < m_rapidity_min ) { return 0; }
+  //
+  case JetCut::rapidity : {
+    if ( m_rapidity_max != 1e8 ) {
+      if ( jet->rapidity() > m_rapidity_max ) { return false; }
+    }
+    if ( m_rapidity_min != 1e8 ) {
+      if ( jet->rapidity() < m_rapidity_min ) { return false; }
+    }
+    return true;
   }
 
+  //
   // JVF pileup cut
-  if ( m_doJVF ){
-    ANA_MSG_DEBUG("Doing JVF");
-    ANA_MSG_DEBUG("Jet Pt " << jet->pt());
-    if ( jet->pt() < m_pt_max_JVF ) {
-      xAOD::JetFourMom_t jetScaleP4 = jet->getAttribute< xAOD::JetFourMom_t >( m_jetScaleType.c_str() );
-      if ( fabs(jetScaleP4.eta()) < m_eta_max_JVF ){
-        if ( jet->getAttribute< std::vector<float> >( "JVF" ).at( m_pvLocation ) < m_JVFCut ) {
-          return 0;
+  //
+  case JetCut::JVF : {
+    if ( m_doJVF ){
+      ANA_MSG_DEBUG("Doing JVF");
+      ANA_MSG_DEBUG("Jet Pt " << jet->pt());
+      if ( jet->pt() < m_pt_max_JVF ) {
+        xAOD::JetFourMom_t jetScaleP4 = jet->getAttribute< xAOD::JetFourMom_t >( m_jetScaleType.c_str() );
+        if ( fabs(jetScaleP4.eta()) < m_eta_max_JVF ){
+          if ( jet->getAttribute< std::vector<float> >( "JVF" ).at( m_pvLocation ) < m_JVFCut ) {
+            return false;
+          }
         }
       }
-    }
-  } // m_doJVF
+    } // m_doJVF
+    return true;
+  }
 
-  if(m_dofJVT){
-    if(jet->auxdata<char>("passFJVT")!=1){
-      ANA_MSG_DEBUG("jet pt = "<<jet->pt()<<",eta = "<<jet->eta()<<",phi = "<<jet->phi());
-      ANA_MSG_DEBUG("Failed forward JVT");
-      if(m_dofJVTVeto)return 0;
-    }
-    else if (TMath::Abs(jet->eta()>2.5) ) {
-      ANA_MSG_DEBUG("jet pt = " << jet->pt() << ",eta = "<<jet->eta()<<",phi = "<<jet->phi());
-      ANA_MSG_DEBUG("Passed forward JVT");
-    }
+  //
+  // forward JVT
+  //
+  case JetCut::fJVT : {
+    if(m_dofJVT){
+      if(jet->auxdata<char>("passFJVT")!=1){
+        ANA_MSG_DEBUG("jet pt = "<<jet->pt()<<",eta = "<<jet->eta()<<",phi = "<<jet->phi());
+        ANA_MSG_DEBUG("Failed forward JVT");
+        if(m_dofJVTVeto)return false;
+      }
+      else if (TMath::Abs(jet->eta()>2.5) ) {
+        ANA_MSG_DEBUG("jet pt = " << jet->pt() << ",eta = "<<jet->eta()<<",phi = "<<jet->phi());
+        ANA_MSG_DEBUG("Passed forward JVT");
+      }
 
-  }//do forward JVT
+    }//do forward JVT
+    return true;
+  }
 
+  //
   // JVT pileup cut
-  if ( m_doJVT ) {
-    // NB: origin-correction is applied at constituent level. Eta for Jvt needs to be the DetectorEta explicitly.
-    float jet_pt = jet->pt();
-    float jet_eta = jet->getAttribute<float>("DetectorEta");
-    float jet_jvt = jet->getAttribute<float>("Jvt");
-    ANA_MSG_DEBUG("Checking Jvt cut for jet pT=" << jet_pt << " MeV, DetectorEta=" << jet_eta <<", and Jvt="<< jet_jvt );
-    bool result = false;
-
-    // if non-negative, the user wants to apply a custom jvt cut
-    if( m_JVTCut > 0 ){
-      ANA_MSG_DEBUG("Custom JVT working point with pT<" << m_pt_max_JVT << ", |eta|<" << m_eta_max_JVT << ", Jvt<" << m_JVTCut);
-      result = (jet_pt < m_pt_max_JVT && std::fabs(jet_eta) < m_eta_max_JVT && jet_jvt < m_JVTCut);
-    } else {
-      result = m_JVT_tool_handle->passesJvtCut(*jet);
-    }
+  //
+  case JetCut::JVT : {
+    if ( m_doJVT ) {
+      // NB: origin-correction is applied at constituent level. Eta for Jvt needs to be the DetectorEta explicitly.
+      float jet_pt = jet->pt();
+      float jet_eta = jet->getAttribute<float>("DetectorEta");
+      float jet_jvt = jet->getAttribute<float>("Jvt");
+      ANA_MSG_DEBUG("Checking Jvt cut for jet pT=" << jet_pt << " MeV, DetectorEta=" << jet_eta <<", and Jvt="<< jet_jvt );
+      bool result = false;
+
+      // if non-negative, the user wants to apply a custom jvt cut
+      if( m_JVTCut > 0 ){
+        ANA_MSG_DEBUG("Custom JVT working point with pT<" << m_pt_max_JVT << ", |eta|<" << m_eta_max_JVT << ", Jvt<" << m_JVTCut);
+        result = (jet_pt < m_pt_max_JVT && std::fabs(jet_eta) < m_eta_max_JVT && jet_jvt < m_JVTCut);
+      } else {
+        result = m_JVT_tool_handle->passesJvtCut(*jet);
+      }
 
-    if(result) ANA_MSG_DEBUG(" ... jet passes Jvt cut");
-    else       ANA_MSG_DEBUG(" ... jet does not pass Jvt cut");
-    if ( !m_noJVTVeto && !result ) return 0;
+      if(result) ANA_MSG_DEBUG(" ... jet passes Jvt cut");
+      else       ANA_MSG_DEBUG(" ... jet does not pass Jvt cut");
+      if ( !m_noJVTVeto && !result ) return false;
+    }
+    if ( m_useCutFlow ) m_jet_cutflow.count( JetCut::JVT );
+    return true;
   }
-  if ( m_useCutFlow ) m_jet_cutflowHist_1->Fill( m_jet_cutflow_jvt_cut, 1 );
 
   //
-  //  BTagging
+  // BTagging
   //
-  if ( m_doBTagCut ) {
-    ANA_MSG_DEBUG("Doing BTagging");
-    if ( m_BJetSelectTool_handle->accept( jet ) ) {
-      if(m_useCutFlow) m_jet_cutflowHist_1->Fill( m_jet_cutflow_btag_cut, 1 );
-    } else {
-      return 0;
+  case JetCut::BTag : {
+    if ( m_doBTagCut ) {
+      ANA_MSG_DEBUG("Doing BTagging");
+      if ( m_BJetSelectTool_handle->accept( jet ) ) {
+        if ( m_useCutFlow ) m_jet_cutflow.count( JetCut::BTag );
+      } else {
+        return false;
+      }
     }
+    return true;
   }
 
-
   //
-  //  HLT BTagging
+  // HLT BTagging
   //
-  if ( m_doHLTBTagCut ) {
-    const xAOD::BTagging *btag_info = jet->auxdata< const xAOD::BTagging* >("HLTBTag");
+  case JetCut::HLTBTag : {
+    if ( m_doHLTBTagCut ) {
+      const xAOD::BTagging *btag_info = jet->auxdata< const xAOD::BTagging* >("HLTBTag");
+      if ( !btag_info ) { return false; }
+
+      double tagValue = -99;
+      if(m_HLTBTagTaggerName=="MV2c00"){
+        btag_info->MVx_discriminant("MV2c00", tagValue);
+      }
 
-    double tagValue = -99;
-    if(m_HLTBTagTaggerName=="MV2c00"){
-      btag_info->MVx_discriminant("MV2c00", tagValue);
-    }
+      if(m_HLTBTagTaggerName=="MV2c10"){
+        btag_info->MVx_discriminant("MV2c10", tagValue);
+      }
 
-    if(m_HLTBTagTaggerName=="MV2c10"){
-      btag_info->MVx_discriminant("MV2c10", tagValue);
-    }
+      if(m_HLTBTagTaggerName=="MV2c20"){
+        btag_info->MVx_discriminant("MV2c20", tagValue);
+      }
 
-    if(m_HLTBTagTaggerName=="MV2c20"){
-      btag_info->MVx_discriminant("MV2c20", tagValue);
-    }
+      if(m_HLTBTagTaggerName=="COMB"){
+        float wIP3D = btag_info->IP3D_loglikelihoodratio();
+        float wSV1  = btag_info->SV1_loglikelihoodratio();
+        tagValue = wIP3D + wSV1;
+      }
 
-    if(m_HLTBTagTaggerName=="COMB"){
-      float wIP3D = btag_info->IP3D_loglikelihoodratio();
-      float wSV1  = btag_info->SV1_loglikelihoodratio();
-      tagValue = wIP3D + wSV1;
+      if(tagValue < m_HLTBTagCutValue){return false;}
     }
-
-    if(tagValue < m_HLTBTagCutValue){return 0;}
+    return true;
   }
 
   //
   // HLT Valid Vtx
   //
-  if ( m_requireHLTVtx ) {
-    const xAOD::Vertex *online_pvx   = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx");
-    if(!online_pvx) {return 0;}
-  }
+  case JetCut::HLTVtx : {
+    if ( m_requireHLTVtx ) {
+      const xAOD::Vertex *online_pvx   = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx");
+      if(!online_pvx) {return false;}
+    }
 
-  if ( m_requireNoHLTVtx ) {
-    const xAOD::Vertex *online_pvx   = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx");
-    if(online_pvx) {return 0;}
+    if ( m_requireNoHLTVtx ) {
+      const xAOD::Vertex *online_pvx   = jet->auxdata<const xAOD::Vertex*>("HLTBJetTracks_vtx");
+      if(online_pvx) {return false;}
+    }
+    return true;
   }
 
-
   //
-  //  Pass Keys
+  // Pass Keys
   //
-  for ( auto& passKey : m_passKeys ) {
-    if ( !(jet->auxdata< char >(passKey) == '1') ) { return 0;}
+  case JetCut::passKeys : {
+    for ( auto& passKey : m_passKeys ) {
+      if ( !(jet->auxdata< char >(passKey) == '1') ) { return false;}
+    }
+    return true;
   }
 
   //
-  //  Fail Keys
+  // Fail Keys
   //
-  for ( auto& failKey : m_failKeys ){
-    if ( !(jet->auxdata< char >(failKey) == '0') ) { return 0;}
+  case JetCut::failKeys : {
+    for ( auto& failKey : m_failKeys ){
+      if ( !(jet->auxdata< char >(failKey) == '0') ) { return false;}
+    }
+    return true;
   }
 
   //
-  //  Truth Label
+  // Truth Label
   //
-  if ( m_truthLabel != -1 ) {
-    ANA_MSG_DEBUG("Doing Truth Label");
-    int this_TruthLabel = 0;
-
-    static SG::AuxElement::ConstAccessor<int> HadronConeExclTruthLabelID ("HadronConeExclTruthLabelID");
-    static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
-    static SG::AuxElement::ConstAccessor<int> PartonTruthLabelID ("PartonTruthLabelID");
-
-    if( m_useHadronConeExcl && HadronConeExclTruthLabelID.isAvailable( *jet) ){
-      this_TruthLabel = HadronConeExclTruthLabelID(( *jet) );
-    } else if ( TruthLabelID.isAvailable( *jet) ) {
-      this_TruthLabel = TruthLabelID( *jet );
-      if (this_TruthLabel == 21 || this_TruthLabel<4) this_TruthLabel = 0;
-    } else {
-      this_TruthLabel = PartonTruthLabelID( *jet );
-      if (this_TruthLabel == 21 || this_TruthLabel<4) this_TruthLabel = 0;
-    }
+  case JetCut::truthLabel : {
+    if ( m_truthLabel != -1 ) {
+      ANA_MSG_DEBUG("Doing Truth Label");
+      int this_TruthLabel = 0;
+
+      static SG::AuxElement::ConstAccessor<int> HadronConeExclTruthLabelID ("HadronConeExclTruthLabelID");
+      static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
+      static SG::AuxElement::ConstAccessor<int> PartonTruthLabelID ("PartonTruthLabelID");
+
+      if( m_useHadronConeExcl && HadronConeExclTruthLabelID.isAvailable( *jet) ){
+        this_TruthLabel = HadronConeExclTruthLabelID(( *jet) );
+      } else if ( TruthLabelID.isAvailable( *jet) ) {
+        this_TruthLabel = TruthLabelID( *jet );
+        if (this_TruthLabel == 21 || this_TruthLabel<4) this_TruthLabel = 0;
+      } else {
+        this_TruthLabel = PartonTruthLabelID( *jet );
+        if (this_TruthLabel == 21 || this_TruthLabel<4) this_TruthLabel = 0;
+      }
 
-    if ( this_TruthLabel == -1 ) {return 0;}
-    if ( (m_truthLabel == 5) && this_TruthLabel != 5 ) { return 0;}
-    if ( (m_truthLabel == 4) && this_TruthLabel != 4 ) { return 0;}
-    if ( (m_truthLabel == 0) && this_TruthLabel != 0 ) { return 0;}
+      if ( this_TruthLabel == -1 ) {return false;}
+      if ( (m_truthLabel == 5) && this_TruthLabel != 5 ) { return false;}
+      if ( (m_truthLabel == 4) && this_TruthLabel != 4 ) { return false;}
+      if ( (m_truthLabel == 0) && this_TruthLabel != 0 ) { return false;}
 
+    }
+    return true;
   }
 
-  ANA_MSG_DEBUG("Passed Cuts");
-  return 1;
+  default:
+    return true;
+  }
+
+}
+
+std::string JetSelector :: declaredInputs () const
+{
+  std::string inputs = m_inContainerName + " " + m_eventInfoContainerName + " " + m_vertexContainerName + " BTagging_*";
+  if ( m_doJVF || m_doJVT || m_dofJVT ) inputs += " *TrackParticles";
+  if ( m_doJVT && m_haveTruthJets ) inputs += " " + m_truthJetContainer;
+  return inputs;
 }
@@ -46,6 +46,10 @@
 
 /* Mini xAOD */
 #include <xAODAnaHelpers/MinixAOD.h>
+#include <xAODAnaHelpers/StoreRecorder.h>
+#include <xAODAnaHelpers/StoreReplayer.h>
+#include <xAODAnaHelpers/EventPicker.h>
+#include <xAODAnaHelpers/InputCache.h>
 
 /* Other */
 #include <xAODAnaHelpers/HelperFunctions.h>
@@ -54,6 +58,7 @@
 #include <xAODAnaHelpers/TauJetMatching.h>
 #include <xAODAnaHelpers/Writer.h>
 #include <xAODAnaHelpers/MessagePrinterAlgo.h>
+#include <xAODAnaHelpers/AlgorithmTimer.h>
 
 #ifdef __CINT__
 
@@ -105,11 +110,16 @@
 #pragma link C++ class TreeAlgo+;
 
 #pragma link C++ class MinixAOD+;
+#pragma link C++ class StoreRecorder+;
+#pragma link C++ class StoreReplayer+;
+#pragma link C++ class EventPicker+;
+#pragma link C++ class InputCache+;
 
 #pragma link C++ class OverlapRemover+;
 #pragma link C++ class TrigMatcher+;
 #pragma link C++ class TauJetMatching+;
 #pragma link C++ class Writer+;
 #pragma link C++ class MessagePrinterAlgo+;
+#pragma link C++ class AlgorithmTimer+;
 
 #endif
@@ -649,3 +649,9 @@ EL::StatusCode METConstructor :: histFinalize ()
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
+
+std::string METConstructor :: declaredInputs () const
+{
+  return m_referenceMETContainer + " " + m_mapName + " " + m_coreName + " " + m_inputJets + " " + m_inputElectrons + " " + m_inputPhotons + " "
+         + m_inputTaus + " " + m_inputMuons + " " + m_eventInfoContainerName + " " + m_vertexContainerName + " *TrackParticles";
+}
@@ -0,0 +1,130 @@
+#include <xAODAnaHelpers/MemoryRegistry.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __linux__
+#include <malloc.h>
+#include <unistd.h>
+#endif
+
+#include <TTree.h>
+
+std::map<std::string, xAH::MemoryRegistry::Entry> xAH::MemoryRegistry::s_entries = {};
+std::vector<const xAH::MemoryRegistry::Entry*> xAH::MemoryRegistry::s_ordered = {};
+std::vector<xAH::MemoryRegistry::EventSample> xAH::MemoryRegistry::s_events = {};
+
+double xAH::MemoryRegistry::rss() {
+#ifdef __linux__
+  std::ifstream statm( "/proc/self/statm" );
+  unsigned long size(0), resident(0);
+  if ( !( statm >> size >> resident ) ) return 0.;
+  return static_cast<double>( resident ) * sysconf( _SC_PAGESIZE );
+#else
+  return 0.;
+#endif
+}
+
+double xAH::MemoryRegistry::heapInUse() {
+#ifdef __linux__
+#if defined(__GLIBC__) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 33 ) )
+  struct mallinfo2 info = mallinfo2();
+#else
+  struct mallinfo info = mallinfo();
+#endif
+  // small blocks in the arenas, and large blocks allocated with mmap
+  return static_cast<double>( info.uordblks ) + static_cast<double>( info.hblkhd );
+#else
+  return 0.;
+#endif
+}
+
+xAH::MemoryRegistry::Entry* xAH::MemoryRegistry::entry( const std::string& algorithm, const std::string& step ) {
+  const std::string key = algorithm + "/" + step;
+  auto it = s_entries.find( key );
+  if ( it == s_entries.end() ) {
+    Entry newEntry;
+    newEntry.algorithm = algorithm;
+    newEntry.step      = step;
+    it = s_entries.emplace( key, newEntry ).first;
+    s_ordered.push_back( &it->second );
+  }
+  return &it->second;
+}
+
+void xAH::MemoryRegistry::add( Entry* entry, double heapDelta ) {
+  if ( !entry ) return;
+  entry->samples++;
+  entry->totalHeap += heapDelta;
+  entry->maxHeap = std::max( entry->maxHeap, heapDelta );
+}
+
+std::string xAH::MemoryRegistry::summary() {
+  const double MB = 1024. * 1024.;
+
+  std::stringstream ss;
+  ss << std::left << std::setw(40) << "algorithm" << std::setw(16) << "step"
+     << std::right << std::setw(10) << "samples" << std::setw(16) << "mean heap [MB]" << std::setw(16) << "max heap [MB]"
+     << std::setw(16) << "total heap [MB]" << "\n";
+  ss << std::fixed << std::setprecision(3);
+  for ( const Entry* entry : s_ordered ) {
+    ss << std::left << std::setw(40) << entry->algorithm << std::setw(16) << entry->step
+       << std::right << std::setw(10) << entry->samples
+       << std::setw(16) << ( ( entry->samples ) ? entry->totalHeap / entry->samples / MB : 0. )
+       << std::setw(16) << entry->maxHeap / MB
+       << std::setw(16) << entry->totalHeap / MB << "\n";
+  }
+
+  if ( !s_events.empty() ) {
+    double maxRSS(0), maxStore(0), sumStore(0);
+    for ( const auto& sample : s_events ) {
+      maxRSS   = std::max( maxRSS, sample.rss );
+      maxStore = std::max( maxStore, sample.storeHeap );
+      sumStore += sample.storeHeap;
+    }
+    ss << s_events.size() << " sampled events: RSS first/last/max = " << s_events.front().rss / MB << " / " << s_events.back().rss / MB
+       << " / " << maxRSS / MB << " MB, event store mean/max = " << sumStore / s_events.size() / MB << " / " << maxStore / MB << " MB\n";
+  }
+  return ss.str();
+}
+
+void xAH::MemoryRegistry::fillTree( TTree* tree ) {
+  std::string algorithm, step;
+  unsigned long long samples(0);
+  double totalHeap(0), maxHeap(0);
+
+  tree->Branch( "algorithm", &algorithm );
+  tree->Branch( "step",      &step );
+  tree->Branch( "samples",   &samples,   "samples/l" );
+  tree->Branch( "totalHeap", &totalHeap, "totalHeap/D" );
+  tree->Branch( "maxHeap",   &maxHeap,   "maxHeap/D" );
+
+  for ( const Entry* entry : s_ordered ) {
+    algorithm = entry->algorithm;
+    step      = entry->step;
+    samples   = entry->samples;
+    totalHeap = entry->totalHeap;
+    maxHeap   = entry->maxHeap;
+    tree->Fill();
+  }
+
+  tree->ResetBranchAddresses();
+}
+
+void xAH::MemoryRegistry::fillEventTree( TTree* tree ) {
+  EventSample sample;
+
+  tree->Branch( "event",     &sample.event,     "event/l" );
+  tree->Branch( "rss",       &sample.rss,       "rss/D" );
+  tree->Branch( "heap",      &sample.heap,      "heap/D" );
+  tree->Branch( "storeHeap", &sample.storeHeap, "storeHeap/D" );
+
+  for ( const auto& s : s_events ) {
+    sample = s;
+    tree->Fill();
+  }
+
+  tree->ResetBranchAddresses();
+}
@@ -83,3 +83,8 @@ EL::StatusCode MetHistsAlgo :: histFinalize ()
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
+
+std::string MetHistsAlgo :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName;
+}
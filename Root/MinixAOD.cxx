@@ -1,8 +1,19 @@
 // c++ include(s):
+#include <algorithm>
+#include <fnmatch.h>
 #include <iostream>
+#include <set>
 #include <typeinfo>
 #include <sstream>
 
+// ROOT include(s):
+#include "TBranch.h"
+#include "TClass.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TLeaf.h"
+#include "TTree.h"
+
 // EL include(s):
 #include <EventLoop/Job.h>
 #include <EventLoop/StatusCode.h>
@@ -11,9 +22,15 @@
 #include "EventLoop/OutputStream.h"
 
 // EDM include(s):
+#include "AthContainers/AuxElement.h"
+#include "AthContainers/AuxTypeRegistry.h"
+#include "AthContainers/AuxVectorData.h"
+#include "AthContainersInterfaces/IAuxStoreIO.h"
+#include "AthContainersInterfaces/IConstAuxStore.h"
 #include "xAODCore/AuxContainerBase.h"
 #include "xAODBase/IParticleContainer.h"
 #include "xAODCore/ShallowCopy.h"
+#include "xAODEventFormat/EventFormat.h"
 #include "xAODEgamma/ElectronContainer.h"
 #include "xAODEgamma/ElectronAuxContainer.h"
 #include "xAODJet/JetContainer.h"
@@ -40,6 +57,15 @@
 // this is needed to distribute the algorithm to the workers
 ClassImp(MinixAOD)
 
+namespace {
+  // does the name match any of the (shell wildcard) patterns
+  bool matchesAny(const std::string& name, const std::vector<std::string>& patterns){
+    for(const auto& pattern: patterns)
+      if(fnmatch(pattern.c_str(), name.c_str(), 0) == 0) return true;
+    return false;
+  }
+}
+
 MinixAOD :: MinixAOD () :
     Algorithm("MinixAOD")
 {
@@ -71,6 +97,11 @@ EL::StatusCode MinixAOD :: histInitialize ()
 
 EL::StatusCode MinixAOD :: changeInput (bool firstFile)
 {
+  // the output tree only exists after initialize(), which connects the branches of the first file,
+  // the branch list is then rebuilt for every file
+  if(m_fastSkim && m_rawOutputTree)
+    ANA_CHECK( this->connectRawBranches());
+
   //
   // Update CutBookkeeper
   if(m_copyCutBookkeeper)
@@ -175,6 +206,21 @@ EL::StatusCode MinixAOD :: initialize ()
     m_vectorCopyKeys_vec.push_back(std::pair<std::string, std::string>(token.substr(0, pos), token.substr(pos+1)));
   }
 
+  ANA_CHECK( this->parseAuxLists("m_auxIncludes", m_auxIncludes, m_auxIncludes_map));
+  ANA_CHECK( this->parseAuxLists("m_auxExcludes", m_auxExcludes, m_auxExcludes_map));
+
+  if(m_fastSkim){
+    m_rawOutputTree = dynamic_cast<TTree*>(file_xAOD->Get(wk()->tree()->GetName()));
+    if(!m_rawOutputTree){
+      ANA_MSG_ERROR("Could not find the output event tree " << wk()->tree()->GetName() << " for m_fastSkim");
+      return EL::StatusCode::FAILURE;
+    }
+    ANA_CHECK( this->connectRawBranches());
+    // their dynamic variables are slimmed when the branches are connected
+    for(const auto& key: m_simpleCopyKeys_vec) m_auxSlimming.erase(key);
+    ANA_MSG_INFO("Copying " << m_rawBranches.size() << " branches of " << m_simpleCopyKeys_vec.size() << " containers as they are");
+  }
+
   ANA_MSG_DEBUG("MinixAOD Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -204,9 +250,20 @@ EL::StatusCode MinixAOD :: execute ()
   // Copy code
 
   // simple copy is easiest - it's in the input, copy over, no need for types
-  for(const auto& key: m_simpleCopyKeys_vec){
-    ANA_CHECK( m_event->copy(key));
-    ANA_MSG_DEBUG("Copying " << key << " from input file");
+  if(m_fastSkim){
+    // read into the buffers of the output branches, written out by TEvent::fill()
+    const Long64_t entry = wk()->treeEntry();
+    for(auto& branch: m_rawBranches){
+      if(branch.second.input && branch.second.input->GetEntry(entry) < 0){
+        ANA_MSG_ERROR("Could not read " << branch.first << " for entry " << entry);
+        return EL::StatusCode::FAILURE;
+      }
+    }
+  } else {
+    for(const auto& key: m_simpleCopyKeys_vec){
+      ANA_CHECK( m_event->copy(key));
+      ANA_MSG_DEBUG("Copying " << key << " from input file");
+    }
   }
 
   // we need to make deep copies
@@ -214,7 +271,7 @@ EL::StatusCode MinixAOD :: execute ()
     auto in_key = keypair.first;
     auto out_key = keypair.second;
 
-    const xAOD::IParticleContainer* cont(nullptr);
+    const SG::AuxVectorData* cont(nullptr);
     ANA_CHECK( HelperFunctions::retrieve(cont, in_key, nullptr, m_store, msg()));
 
     if(const xAOD::ElectronContainer* t_cont = dynamic_cast<const xAOD::ElectronContainer*>(cont)){
@@ -281,7 +338,7 @@ EL::StatusCode MinixAOD :: execute ()
 
   // all we need to do is retrieve it and figure out what type it is to record it and we're done
   for(const auto& key: m_copyFromStoreToEventKeys_vec){
-    const xAOD::IParticleContainer* cont(nullptr);
+    const SG::AuxVectorData* cont(nullptr);
     ANA_CHECK( HelperFunctions::retrieve(cont, key, nullptr, m_store, msg()));
 
     if(dynamic_cast<const xAOD::ElectronContainer*>(cont)){
@@ -304,6 +361,14 @@ EL::StatusCode MinixAOD :: execute ()
     ANA_MSG_DEBUG("Copied " << key << " and it's auxiliary container from TStore to TEvent");
   }
 
+  // the aux item lists have to be set before the containers are written out for the first time
+  for(auto& slimming: m_auxSlimming){
+    if(!slimming.second.configured) ANA_CHECK( this->configureAuxSlimming(slimming.first, slimming.second));
+
+    const SG::IConstAuxStore* auxStore(nullptr);
+    ANA_CHECK( this->retrieveAuxStore(slimming.first, auxStore));
+    slimming.second.bytesDropped += auxStore->size() * slimming.second.droppedElementSize;
+  }
 
   m_event->fill();
   ANA_MSG_DEBUG("Finished dumping objects...");
@@ -312,9 +377,208 @@ EL::StatusCode MinixAOD :: execute ()
 
 }
 
+EL::StatusCode MinixAOD :: parseAuxLists( const std::string& optionName, const std::string& option, std::map<std::string, std::vector<std::string>>& lists )
+{
+  // A1|a,b,c B1|d,e ... -> {A1: [a, b, c], B1: [d, e], ...}
+  std::string token;
+  std::istringstream ss(option);
+  while(std::getline(ss, token, ' ')){
+    if(token.empty()) continue;
+    std::size_t pos = token.find_first_of('|');
+    if(pos == std::string::npos || pos == 0){
+      ANA_MSG_ERROR("Invalid item '" << token << "' in " << optionName << ", expected 'container|variable1,variable2,...'");
+      return EL::StatusCode::FAILURE;
+    }
+    std::string pattern;
+    std::istringstream ss_patterns(token.substr(pos+1));
+    std::vector<std::string>& patterns = lists[token.substr(0, pos)];
+    while(std::getline(ss_patterns, pattern, ','))
+      if(!pattern.empty()) patterns.push_back(pattern);
+    m_auxSlimming[token.substr(0, pos)] = AuxSlimming();
+  }
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode MinixAOD :: retrieveAuxStore( const std::string& key, const SG::IConstAuxStore*& auxStore )
+{
+  auxStore = nullptr;
+  // containers of any type, or standalone objects like EventInfo
+  if(HelperFunctions::isAvailable<SG::AuxVectorData>(key, m_event, m_store, msg())){
+    const SG::AuxVectorData* cont(nullptr);
+    ANA_CHECK( HelperFunctions::retrieve(cont, key, m_event, m_store, msg()));
+    auxStore = cont->getConstStore();
+  } else if(HelperFunctions::isAvailable<SG::AuxElement>(key, m_event, m_store, msg())){
+    const SG::AuxElement* object(nullptr);
+    ANA_CHECK( HelperFunctions::retrieve(object, key, m_event, m_store, msg()));
+    auxStore = object->getConstStore();
+  }
+
+  if(!auxStore){
+    ANA_MSG_ERROR("Could not find the auxiliary store of " << key << " to slim it");
+    return EL::StatusCode::FAILURE;
+  }
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode MinixAOD :: configureAuxSlimming( const std::string& key, AuxSlimming& slimming )
+{
+  const SG::IConstAuxStore* auxStore(nullptr);
+  ANA_CHECK( this->retrieveAuxStore(key, auxStore));
+
+  // only the dynamic variables can be dropped, the static ones are written with the auxiliary object anyway
+  const SG::IAuxStoreIO* auxStoreIO = dynamic_cast<const SG::IAuxStoreIO*>(auxStore);
+  if(!auxStoreIO){
+    ANA_MSG_ERROR("Could not tell the dynamic variables of " << key << " apart, its auxiliary store does not support I/O");
+    return EL::StatusCode::FAILURE;
+  }
+
+  const std::vector<std::string>& includes = m_auxIncludes_map[key];
+  const std::vector<std::string>& excludes = m_auxExcludes_map[key];
+  const SG::AuxTypeRegistry& registry = SG::AuxTypeRegistry::instance();
+  std::string itemList("");
+  for(SG::auxid_t auxid: auxStoreIO->getDynamicAuxIDs()){
+    const std::string name = registry.getName(auxid);
+    if( (includes.empty() || matchesAny(name, includes)) && !matchesAny(name, excludes) ){
+      itemList += (itemList.empty() ? "" : ".") + name;
+      ++slimming.numKept;
+    } else {
+      slimming.dropped.push_back(name);
+      slimming.droppedElementSize += registry.getEltSize(auxid);
+    }
+  }
+
+  // an empty item list would mean all the variables, "-" means none
+  m_event->setAuxItemList(key+"Aux.", itemList.empty() ? "-" : itemList);
+  slimming.configured = true;
+
+  ANA_MSG_INFO("Writing " << slimming.numKept << " aux variables of " << key << ", dropping " << slimming.dropped.size());
+  for(const auto& name: slimming.dropped) ANA_MSG_DEBUG("\tdropping " << key << "." << name);
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode MinixAOD :: connectRawBranches ()
+{
+  // a second instance of the input event tree, read from the file EventLoop has open, so that the branches can be read into
+  // our buffers without touching the ones TEvent reads. It belongs to the input file, which deletes it when it is closed.
+  TFile* inputFile = wk()->inputFile();
+  TKey* treeKey = inputFile->GetKey(wk()->tree()->GetName());
+  m_rawInputTree = (treeKey) ? dynamic_cast<TTree*>(treeKey->ReadObj()) : nullptr;
+  if(!m_rawInputTree){
+    ANA_MSG_ERROR("Could not read " << wk()->tree()->GetName() << " from " << inputFile->GetName() << " for m_fastSkim");
+    return EL::StatusCode::FAILURE;
+  }
+
+  // the branches of this file to copy: the interface, auxiliary and dynamic auxiliary branches of each container
+  std::set<std::string> fileBranches;
+  for(const auto& key: m_simpleCopyKeys_vec){
+    if(key.empty()) continue;
+    const std::string auxName = key + "Aux.";
+    const std::string dynPrefix = key + "AuxDyn.";
+    unsigned int numBranches(0);
+
+    for(TObject* obj: *m_rawInputTree->GetListOfBranches()){
+      const std::string name = obj->GetName();
+      if(name != key && name != auxName && name.compare(0, dynPrefix.size(), dynPrefix) != 0) continue;
+      if(name.compare(0, dynPrefix.size(), dynPrefix) == 0){
+        const std::string variable = name.substr(dynPrefix.size());
+        const std::vector<std::string>& includes = m_auxIncludes_map[key];
+        if( (!includes.empty() && !matchesAny(variable, includes)) || matchesAny(variable, m_auxExcludes_map[key]) ){
+          ANA_MSG_DEBUG("\tdropping " << key << "." << variable);
+          continue;
+        }
+      }
+      fileBranches.insert(name);
+      ++numBranches;
+    }
+
+    if(numBranches == 0){
+      // the output branches are made from the first file
+      if(m_rawBranches.empty()){
+        ANA_MSG_ERROR("Could not find " << key << " in " << inputFile->GetName());
+        return EL::StatusCode::FAILURE;
+      }
+      ANA_MSG_WARNING("Could not find " << key << " in " << inputFile->GetName() << ", writing it empty for the events of this file");
+    }
+  }
+
+  // new branches can only be added to the output before the first event is written out
+  const bool firstFile = m_rawBranches.empty();
+  for(const auto& name: fileBranches){
+    if(m_rawBranches.count(name)) continue;
+    if(m_rawOutputTree->GetEntries() > 0){
+      ANA_MSG_WARNING("The branch " << name << " first appears in " << inputFile->GetName() << ", it is not written out");
+      continue;
+    }
+
+    TBranch* input = m_rawInputTree->GetBranch(name.c_str());
+    RawBranch& raw = m_rawBranches[name];
+    TClass* cl(nullptr);
+    EDataType type(kOther_t);
+    input->GetExpectedType(cl, type);
+    if(cl){
+      raw.className = cl->GetName();
+      raw.object = cl->New();
+      raw.output = m_rawOutputTree->Branch(name.c_str(), raw.className.c_str(), &raw.object, input->GetBasketSize(), input->GetSplitLevel());
+    } else {
+      TLeaf* leaf = static_cast<TLeaf*>(input->GetListOfLeaves()->At(0));
+      raw.buffer.resize(std::max(8, leaf->GetLenType()*leaf->GetLenStatic()));
+      raw.output = m_rawOutputTree->Branch(name.c_str(), raw.buffer.data(), input->GetTitle(), input->GetBasketSize());
+    }
+    if(!raw.output){
+      ANA_MSG_ERROR("Could not create the output branch " << name);
+      return EL::StatusCode::FAILURE;
+    }
+  }
+
+  // declare the containers in the output, so that TEvent can read them back
+  if(firstFile){
+    xAOD::EventFormat* outputFormat(nullptr);
+    if(m_event->retrieveMetaOutput(outputFormat, "EventFormat").isSuccess() && outputFormat){
+      for(const auto& key: m_simpleCopyKeys_vec){
+        for(const auto& name: {key, key + "Aux."}){
+          const xAOD::EventFormatElement* element = m_event->inputEventFormat()->get(name, true);
+          if(element && !outputFormat->exists(name)) outputFormat->add(*element);
+        }
+      }
+    } else {
+      ANA_MSG_WARNING("Could not retrieve the output EventFormat, the m_fastSkim containers can only be read back branch by branch");
+    }
+  }
+
+  m_rawInputTree->SetCacheSize(m_rawCacheSize);
+  for(auto& branch: m_rawBranches){
+    RawBranch& raw = branch.second;
+    raw.input = (fileBranches.count(branch.first)) ? m_rawInputTree->GetBranch(branch.first.c_str()) : nullptr;
+    if(!raw.input){
+      // missing from this file: written with the default value
+      if(raw.object){
+        TClass* cl = TClass::GetClass(raw.className.c_str());
+        cl->Destructor(raw.object, true);
+        cl->New(raw.object);
+      } else {
+        std::fill(raw.buffer.begin(), raw.buffer.end(), 0);
+      }
+      continue;
+    }
+    if(raw.object) raw.input->SetAddress(&raw.object);
+    else            raw.input->SetAddress(raw.buffer.data());
+    m_rawInputTree->AddBranchToCache(raw.input, true);
+  }
+  m_rawInputTree->StopCacheLearningPhase();
+
+  ANA_MSG_DEBUG("Copying " << fileBranches.size() << " branches of " << inputFile->GetName() << " as they are");
+  return EL::StatusCode::SUCCESS;
+}
+
 EL::StatusCode MinixAOD :: postExecute () { return EL::StatusCode::SUCCESS; }
 
 EL::StatusCode MinixAOD :: finalize () {
+  for(const auto& slimming: m_auxSlimming){
+    ANA_MSG_INFO("Dropped " << slimming.second.dropped.size() << " aux variables of " << slimming.first << ": "
+                 << slimming.second.bytesDropped/1048576. << " MB (uncompressed) not written");
+  }
+
   //
   // Save cutbookkeeper
   if(m_copyCutBookkeeper)
@@ -332,6 +596,12 @@ EL::StatusCode MinixAOD :: finalize () {
   TFile *file_xAOD = wk()->getOutputFile(m_outputFileName);
   ANA_CHECK( m_event->finishWritingTo(file_xAOD));
 
+  // the input tree is deleted with its file
+  m_rawInputTree = nullptr;
+  for(auto& branch: m_rawBranches)
+    if(branch.second.object) TClass::GetClass(branch.second.className.c_str())->Destructor(branch.second.object);
+  m_rawBranches.clear();
+
   if(m_fileMetaDataTool) delete m_fileMetaDataTool;
   if(m_trigMetaDataTool) delete m_trigMetaDataTool;
 
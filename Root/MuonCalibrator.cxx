@@ -158,6 +158,8 @@ EL::StatusCode MuonCalibrator :: initialize ()
   m_systList = HelperFunctions::getListofSystematics( recSyst, m_systName, m_systVal, msg() );
 
   ANA_MSG_INFO("Will be using MuonCalibrationAndSmearingTool systematic:");
+  this->setSystematicTimers( m_systList );
+
   std::vector< std::string >* SystMuonsNames = new std::vector< std::string >;
   for ( const auto& syst_it : m_systList ) {
     if ( m_systName.empty() ) {
@@ -212,7 +214,9 @@ EL::StatusCode MuonCalibrator :: execute ()
   //
   std::vector< std::string >* vecOutContainerNames = new std::vector< std::string >;
 
-  for ( const auto& syst_it : m_systList ) {
+  for ( std::size_t iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
+    const auto& syst_it = m_systList[iSyst];
+    auto systTimer = this->timeSystematic( iSyst );
 
     std::string outSCContainerName(m_outSCContainerName);
     std::string outSCAuxContainerName(m_outSCAuxContainerName);
@@ -354,3 +358,8 @@ EL::StatusCode MuonCalibrator :: histFinalize ()
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
+
+std::string MuonCalibrator :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " *TrackParticles";
+}
@@ -933,3 +933,8 @@ EL::StatusCode MuonEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* eve
 
   return EL::StatusCode::SUCCESS;
 }
+
+std::string MuonEfficiencyCorrector :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " " + m_vertexContainerName + " *TrackParticles";
+}
@@ -144,38 +144,47 @@ EL::StatusCode MuonSelector :: initialize ()
     // retrieve the object cutflow
     //
     m_mu_cutflowHist_1  = (TH1D*)file->Get("cutflow_muons_1");
-
-    m_mu_cutflow_all                  = m_mu_cutflowHist_1->GetXaxis()->FindBin("all");
-    m_mu_cutflow_eta_and_quaility_cut = m_mu_cutflowHist_1->GetXaxis()->FindBin("eta_and_quality_cut");
-    m_mu_cutflow_ptmax_cut            = m_mu_cutflowHist_1->GetXaxis()->FindBin("ptmax_cut");
-    m_mu_cutflow_ptmin_cut            = m_mu_cutflowHist_1->GetXaxis()->FindBin("ptmin_cut");
-    m_mu_cutflow_type_cut             = m_mu_cutflowHist_1->GetXaxis()->FindBin("type_cut");
-    m_mu_cutflow_z0sintheta_cut       = m_mu_cutflowHist_1->GetXaxis()->FindBin("z0sintheta_cut");
-    m_mu_cutflow_d0_cut               = m_mu_cutflowHist_1->GetXaxis()->FindBin("d0_cut");
-    m_mu_cutflow_d0sig_cut            = m_mu_cutflowHist_1->GetXaxis()->FindBin("d0sig_cut");
-    m_mu_cutflow_iso_cut              = m_mu_cutflowHist_1->GetXaxis()->FindBin("iso_cut");
-    if( m_removeCosmicMuon )
-      m_mu_cutflow_cosmic_cut              = m_mu_cutflowHist_1->GetXaxis()->FindBin("cosmic_cut");
-
-
     if ( m_isUsedBefore ) {
       m_mu_cutflowHist_2 = (TH1D*)file->Get("cutflow_muons_2");
+    }
 
-      m_mu_cutflow_all 		 = m_mu_cutflowHist_2->GetXaxis()->FindBin("all");
-      m_mu_cutflow_eta_and_quaility_cut = m_mu_cutflowHist_2->GetXaxis()->FindBin("eta_and_quality_cut");
-      m_mu_cutflow_ptmax_cut		 = m_mu_cutflowHist_2->GetXaxis()->FindBin("ptmax_cut");
-      m_mu_cutflow_ptmin_cut		 = m_mu_cutflowHist_2->GetXaxis()->FindBin("ptmin_cut");
-      m_mu_cutflow_type_cut		 = m_mu_cutflowHist_2->GetXaxis()->FindBin("type_cut");
-      m_mu_cutflow_z0sintheta_cut	 = m_mu_cutflowHist_2->GetXaxis()->FindBin("z0sintheta_cut");
-      m_mu_cutflow_d0_cut		 = m_mu_cutflowHist_2->GetXaxis()->FindBin("d0_cut");
-      m_mu_cutflow_d0sig_cut		 = m_mu_cutflowHist_2->GetXaxis()->FindBin("d0sig_cut");
-      m_mu_cutflow_iso_cut		 = m_mu_cutflowHist_2->GetXaxis()->FindBin("iso_cut");
+    // the counts go to the last histogram set (see xAH::CutflowCounter)
+    for ( TH1D* hist : { m_mu_cutflowHist_1, m_mu_cutflowHist_2 } ) {
+      if ( !hist ) continue;
+      m_mu_cutflow.setHist( hist );
+      m_mu_cutflow.bookBin( MuonCut::all,           "all" );
+      m_mu_cutflow.bookBin( MuonCut::etaAndQuality, "eta_and_quality_cut" );
+      m_mu_cutflow.bookBin( MuonCut::ptmax,         "ptmax_cut" );
+      m_mu_cutflow.bookBin( MuonCut::ptmin,         "ptmin_cut" );
+      m_mu_cutflow.bookBin( MuonCut::type,          "type_cut" );
+      m_mu_cutflow.bookBin( MuonCut::z0sintheta,    "z0sintheta_cut" );
+      m_mu_cutflow.bookBin( MuonCut::d0,            "d0_cut" );
+      m_mu_cutflow.bookBin( MuonCut::d0sig,         "d0sig_cut" );
+      m_mu_cutflow.bookBin( MuonCut::iso,           "iso_cut" );
       if( m_removeCosmicMuon )
-        m_mu_cutflow_cosmic_cut		 = m_mu_cutflowHist_2->GetXaxis()->FindBin("cosmic_cut");
+        m_mu_cutflow.bookBin( MuonCut::cosmic,      "cosmic_cut" );
     }
 
   }// if m_useCutFlow
 
+  // default order of the object cuts: they can be reordered only if no cutflow is filled (the cuts do not decorate the muon, see passCuts())
+  //
+  std::vector<MuonCut>     cutOrder  = { MuonCut::etaAndQuality, MuonCut::ptmax, MuonCut::ptmin, MuonCut::z0sintheta, MuonCut::d0, MuonCut::d0sig, MuonCut::iso };
+  std::vector<std::string> cutLabels = { "eta_and_quality_cut", "ptmax_cut", "ptmin_cut", "z0sintheta_cut", "d0_cut", "d0sig_cut", "iso_cut" };
+  if ( m_removeCosmicMuon ) {
+    cutOrder.push_back( MuonCut::cosmic );
+    cutLabels.push_back( "cosmic_cut" );
+  }
+  m_mu_cutOrder.setOrder( cutOrder, cutLabels );
+  if ( m_adaptiveCutOrder ) {
+    if ( m_useCutFlow ) {
+      ANA_MSG_WARNING( "m_adaptiveCutOrder is ignored when filling the cutflow: the cuts will be applied in the default order");
+    } else {
+      ANA_MSG_INFO( "Cuts will be reordered after " << m_nAdaptiveCutOrderEvents << " events to minimise the time spent per muon");
+      m_mu_cutOrder.setLearningEvents( m_nAdaptiveCutOrderEvents );
+    }
+  }
+
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
 
@@ -350,6 +359,10 @@ EL::StatusCode MuonSelector :: execute ()
 
   m_numEvent++;
 
+  if ( m_mu_cutOrder.nextEvent() ) {
+    ANA_MSG_INFO( "Muon cuts reordered after " << m_numEvent << " events:\n" << m_mu_cutOrder.summary() );
+  }
+
   // QUESTION: why this must be done in execute(), and does not work in initialize()?
   //
   if ( m_numEvent == 1 && m_trigDecTool_handle.isInitialized() ) {
@@ -402,7 +415,7 @@ EL::StatusCode MuonSelector :: execute ()
 
     // find the selected muons, and return if event passes object selection
     //
-    eventPass = executeSelection( inMuons, mcEvtWeight, countPass, selectedMuons );
+    eventPass = executeSelection( inMuons, mcEvtWeight, countPass, selectedMuons, eventInfo );
 
     if ( m_createSelectedContainer ) {
       if ( eventPass ) {
@@ -445,7 +458,7 @@ EL::StatusCode MuonSelector :: execute ()
 
       // find the selected muons, and return if event passes object selection
       //
-      eventPassThisSyst = executeSelection( inMuons, mcEvtWeight, countPass, selectedMuons );
+      eventPassThisSyst = executeSelection( inMuons, mcEvtWeight, countPass, selectedMuons, eventInfo );
 
       if ( countPass ) { countPass = false; } // only count objects/events for 1st syst collection in iteration (i.e., nominal)
 
@@ -497,7 +510,7 @@ EL::StatusCode MuonSelector :: execute ()
 }
 
 bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, float mcEvtWeight, bool countPass,
-					    ConstDataVector<xAOD::MuonContainer>* selectedMuons )
+					    ConstDataVector<xAOD::MuonContainer>* selectedMuons, const xAOD::EventInfo* eventInfo )
 {
 
   ANA_MSG_DEBUG( "In  executeSelection..." );
@@ -522,7 +535,7 @@ bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, floa
     }
 
     nObj++;
-    bool passSel = this->passCuts( mu_itr, pvx );
+    bool passSel = this->passCuts( mu_itr, pvx, eventInfo );
     if ( m_decorateSelectedObjects ) {
       passSelDecor( *mu_itr ) = passSel;
     }
@@ -627,9 +640,6 @@ bool MuonSelector :: executeSelection ( const xAOD::MuonContainer* inMuons, floa
 
       ANA_MSG_DEBUG( "Doing di-muon trigger matching...");
 
-      const xAOD::EventInfo* eventInfo(nullptr);
-      ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
-
       typedef std::pair< std::pair<unsigned int,unsigned int>, char> dimuon_trigmatch_pair;
       typedef std::multimap< std::string, dimuon_trigmatch_pair >    dimuon_trigmatch_pair_map;
       static SG::AuxElement::Decorator< dimuon_trigmatch_pair_map >  diMuonTrigMatchPairMapDecor( "diMuonTrigMatchPairMap" );
@@ -713,6 +723,7 @@ EL::StatusCode MuonSelector :: finalize ()
     ANA_MSG_INFO( "Filling cutflow");
     m_cutflowHist ->SetBinContent( m_cutflow_bin, m_numEventPass        );
     m_cutflowHistW->SetBinContent( m_cutflow_bin, m_weightNumEventPass  );
+    m_mu_cutflow.flush();
   }
 
   return EL::StatusCode::SUCCESS;
@@ -738,25 +749,46 @@ EL::StatusCode MuonSelector :: histFinalize ()
   return EL::StatusCode::SUCCESS;
 }
 
-int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex  ) {
+int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex, const xAOD::EventInfo* eventInfo ) {
 
   ANA_MSG_DEBUG( "In  passCuts..." );
   // fill cutflow bin 'all' before any cut
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_all, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_all, 1 ); }
-  ANA_MSG_DEBUG( "In  passCuts2..." );
-  // *********************************************************************************************************************************************************************
+  if ( m_useCutFlow ) m_mu_cutflow.count( MuonCut::all );
+
+  // the decorations are set outside of the cuts, so that they do not depend on the order the cuts are applied in:
+  // the quality and track variables on every muon before the cuts, the isolation decisions on the selected muons after them
   //
-  // MuonSelectorTool cut: quality & |eta| acceptance cut
+  this->decorateTrackVariables( muon, primaryVertex, eventInfo );
+  m_mu_toolDecisions.clear();
+
+  // the cuts are applied in the default order, unless the adaptive ordering has been requested (and no cutflow is filled)
   //
+  for ( auto cut : m_mu_cutOrder.order() ) {
+    auto start = m_mu_cutOrder.start();
+    bool pass  = this->applyCut( cut, muon, primaryVertex );
+    m_mu_cutOrder.record( cut, pass, start );
+    if ( !pass ) { return 0; }
+  }
+
+  for ( const auto& decision : m_mu_toolDecisions ) {
+    ANA_MSG_DEBUG( "Decorating muon with " << decision.first << " : " << static_cast<int>( decision.second ) );
+    muon->auxdecor<char>( decision.first ) = decision.second;
+  }
+
+  ANA_MSG_DEBUG( "Leave passCuts... pass" );
+  return 1;
+}
+
+void MuonSelector :: decorateTrackVariables( const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex, const xAOD::EventInfo* eventInfo ) {
 
   // quality decorators
   static SG::AuxElement::Decorator< char > isVeryLooseQDecor("isVeryLooseQ");
   static SG::AuxElement::Decorator< char > isLooseQDecor("isLooseQ");
   static SG::AuxElement::Decorator< char > isMediumQDecor("isMediumQ");
   static SG::AuxElement::Decorator< char > isTightQDecor("isTightQ");
+  static SG::AuxElement::Decorator< float > z0sinthetaDecor("z0sintheta");
+  static SG::AuxElement::Decorator< float > d0SigDecor("d0sig");
 
-  ANA_MSG_DEBUG( "Got the decors" );
   int this_quality = static_cast<int>( m_muonSelectionTool_handle->getQuality( *muon ) );
   ANA_MSG_DEBUG( "Got quality" );
 
@@ -764,42 +796,83 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
   isLooseQDecor( *muon )     = ( this_quality <= static_cast<int>(xAOD::Muon::Loose) )     ? 1 : 0;
   isMediumQDecor( *muon )    = ( this_quality <= static_cast<int>(xAOD::Muon::Medium) )    ? 1 : 0;
   isTightQDecor( *muon )     = ( this_quality <= static_cast<int>(xAOD::Muon::Tight) )     ? 1 : 0;
-  ANA_MSG_DEBUG( "Doing muon quality" );
-  // this will accept the muon based on the settings at initialization : eta, ID track info, muon quality
-  if ( ! m_muonSelectionTool_handle->accept( *muon ) ) {
-    ANA_MSG_DEBUG( "Muon failed requirements of MuonSelectionTool.");
-    return 0;
+
+  // The following returns a pointer (which should not usually be NULL, but might be if the muon has been stripped of information) to the
+  // primary TrackParticle corresponding to the MuonType of this muon.
+  // This is determined in the following order:
+  //  1. CombinedTrackParticle
+  //  2. InnerDetectorTrackParticle
+  //  3. (Extrapolated)MuonSpectrometerTrackParticle
+  //
+  m_mu_track = TrackVariables();
+  const xAOD::TrackParticle* tp = muon->primaryTrackParticle();
+  if ( !tp ) {
+    ANA_MSG_DEBUG("Muon has no TrackParticle. Won't be selected.");
+    return;
   }
+  m_mu_track.hasTrack = true;
 
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_eta_and_quaility_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_eta_and_quaility_cut, 1 ); }
+  // Take distance between z0 and zPV ( after referring the PV z coordinate to the beamspot position, given by vz() ), multiplied by sin(theta)
+  // see https://twiki.cern.ch/twiki/bin/view/AtlasProtected/InDetTrackingDC14 for further reference
+  //
+  if (primaryVertex) m_mu_track.z0sintheta = ( tp->z0() + tp->vz() - primaryVertex->z() ) * sin( tp->theta() );
+  z0sinthetaDecor( *muon ) = m_mu_track.z0sintheta;
+
+  m_mu_track.d0sig = xAOD::TrackingHelpers::d0significance( tp, eventInfo->beamPosSigmaX(), eventInfo->beamPosSigmaY(), eventInfo->beamPosSigmaXY() );
+  d0SigDecor( *muon ) = m_mu_track.d0sig;
+}
+
+bool MuonSelector :: applyCut( MuonCut cut, const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex ) {
+
+  // A muon w/o TrackParticle fails all the tracking cuts.
+  //
+  switch ( cut ) {
+
+  // *********************************************************************************************************************************************************************
+  //
+  // MuonSelectorTool cut: quality & |eta| acceptance cut
+  //
+  case MuonCut::etaAndQuality : {
+    // this will accept the muon based on the settings at initialization : eta, ID track info, muon quality
+    if ( ! m_muonSelectionTool_handle->accept( *muon ) ) {
+      ANA_MSG_DEBUG( "Muon failed requirements of MuonSelectionTool.");
+      return false;
+    }
+
+    if ( m_useCutFlow ) m_mu_cutflow.count( MuonCut::etaAndQuality );
+    return true;
+  }
 
   // *********************************************************************************************************************************************************************
   //
   // pT max cut
   //
-  ANA_MSG_DEBUG( "Doing pt cuts" );
-  if ( m_pT_max != 1e8 ) {
-    if (  muon->pt() > m_pT_max ) {
-      ANA_MSG_DEBUG( "Muon failed pT max cut.");
-      return 0;
+  case MuonCut::ptmax : {
+    ANA_MSG_DEBUG( "Doing pt cuts" );
+    if ( m_pT_max != 1e8 ) {
+      if (  muon->pt() > m_pT_max ) {
+        ANA_MSG_DEBUG( "Muon failed pT max cut.");
+        return false;
+      }
     }
+    if ( m_useCutFlow ) m_mu_cutflow.count( MuonCut::ptmax );
+    return true;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_ptmax_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_ptmax_cut, 1 ); }
 
   // *********************************************************************************************************************************************************************
   //
   // pT min cut
   //
-  if ( m_pT_min != 1e8 ) {
-    if ( muon->pt() < m_pT_min ) {
-      ANA_MSG_DEBUG( "Muon failed pT min cut.");
-      return 0;
+  case MuonCut::ptmin : {
+    if ( m_pT_min != 1e8 ) {
+      if ( muon->pt() < m_pT_min ) {
+        ANA_MSG_DEBUG( "Muon failed pT min cut.");
+        return false;
+      }
     }
+    if ( m_useCutFlow ) m_mu_cutflow.count( MuonCut::ptmin );
+    return true;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_ptmin_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_ptmin_cut, 1 ); }
 
   // *********************************************************************************************************************************************************************
   //
@@ -812,107 +885,86 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
   //    return 0;
   //  }
   //}
-  //if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_type_cut, 1 );
-  //if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_type_cut, 1 ); }
+  //if ( m_useCutFlow ) m_mu_cutflow.count( MuonCut::type );
 
   // *********************************************************************************************************************************************************************
   //
-  // impact parameter cuts
-  //
-
-  // Put tracking cuts here, after pt cuts, to be safe with derivations.
-
-  // The following returns a pointer (which should not usually be NULL, but might be if the muon has been stripped of information) to the
-  // primary TrackParticle corresponding to the MuonType of this muon.
-  // This is determined in the following order:
-  //  1. CombinedTrackParticle
-  //  2. InnerDetectorTrackParticle
-  //  3. (Extrapolated)MuonSpectrometerTrackParticle
+  // z0*sin(theta) cut
   //
-  const xAOD::TrackParticle* tp = muon->primaryTrackParticle();
+  case MuonCut::z0sintheta : {
+    if ( !m_mu_track.hasTrack ) { return false; }
 
-  if ( !tp ) {
-    ANA_MSG_DEBUG("Muon has no TrackParticle. Won't be selected.");
-    return 0;
+    if ( !( fabs(m_mu_track.z0sintheta) < m_z0sintheta_max ) ) {
+        ANA_MSG_DEBUG( "Muon failed z0*sin(theta) cut.");
+        return false;
+    }
+    if ( m_useCutFlow ) m_mu_cutflow.count( MuonCut::z0sintheta );
+    return true;
   }
 
-  const xAOD::EventInfo* eventInfo(nullptr);
-  ANA_CHECK( HelperFunctions::retrieve(eventInfo, m_eventInfoContainerName, m_event, m_store, msg()) );
-
-  double d0_significance = xAOD::TrackingHelpers::d0significance( tp, eventInfo->beamPosSigmaX(), eventInfo->beamPosSigmaY(), eventInfo->beamPosSigmaXY() );
-
-  // Take distance between z0 and zPV ( after referring the PV z coordinate to the beamspot position, given by vz() ), multiplied by sin(theta)
-  // see https://twiki.cern.ch/twiki/bin/view/AtlasProtected/InDetTrackingDC14 for further reference
-  //
-  float z0sintheta = 1e8;
-  if (primaryVertex) z0sintheta = ( tp->z0() + tp->vz() - primaryVertex->z() ) * sin( tp->theta() );
-
-  // z0*sin(theta) cut
+  // *********************************************************************************************************************************************************************
   //
-  if ( !( fabs(z0sintheta) < m_z0sintheta_max ) ) {
-      ANA_MSG_DEBUG( "Muon failed z0*sin(theta) cut.");
-      return 0;
-  }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_z0sintheta_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_z0sintheta_cut, 1 ); }
-
-  // decorate muon w/ z0*sin(theta) info
-  static SG::AuxElement::Decorator< float > z0sinthetaDecor("z0sintheta");
-  z0sinthetaDecor( *muon ) = z0sintheta;
-
   // d0 cut
   //
-  if ( !( tp->d0() < m_d0_max ) ) {
-      ANA_MSG_DEBUG( "Muon failed d0 cut.");
-      return 0;
+  case MuonCut::d0 : {
+    const xAOD::TrackParticle* tp = muon->primaryTrackParticle();
+    if ( !tp ) { return false; }
+
+    if ( !( tp->d0() < m_d0_max ) ) {
+        ANA_MSG_DEBUG( "Muon failed d0 cut.");
+        return false;
+    }
+    if ( m_useCutFlow ) m_mu_cutflow.count( MuonCut::d0 );
+    return true;
   }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_d0_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_d0_cut, 1 ); }
 
+  // *********************************************************************************************************************************************************************
+  //
   // d0sig cut
   //
-  if ( !( fabs(d0_significance) < m_d0sig_max ) ) {
-      ANA_MSG_DEBUG( "Muon failed d0 significance cut.");
-      return 0;
-  }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_d0sig_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_d0sig_cut, 1 ); }
+  case MuonCut::d0sig : {
+    if ( !m_mu_track.hasTrack ) { return false; }
 
-  // decorate muon w/ d0sig info
-  static SG::AuxElement::Decorator< float > d0SigDecor("d0sig");
-  d0SigDecor( *muon ) = static_cast<float>(d0_significance);
+    if ( !( fabs(m_mu_track.d0sig) < m_d0sig_max ) ) {
+        ANA_MSG_DEBUG( "Muon failed d0 significance cut.");
+        return false;
+    }
+    if ( m_useCutFlow ) m_mu_cutflow.count( MuonCut::d0sig );
+    return true;
+  }
 
   // *********************************************************************************************************************************************************************
   //
   // isolation cut
   //
+  case MuonCut::iso : {
+    // Get the "list" of input WPs with the accept() decision from the tool
+    //
+    Root::TAccept accept_list = m_isolationSelectionTool_handle->accept( *muon );
 
-  // Get the "list" of input WPs with the accept() decision from the tool
-  //
-  Root::TAccept accept_list = m_isolationSelectionTool_handle->accept( *muon );
-
-  // Decorate w/ decision for all input WPs
-  //
-  std::string base_decor("isIsolated");
-  for ( auto WP_itr : m_IsoKeys ) {
-
-    std::string decorWP = base_decor + "_" + WP_itr;
-
-    ANA_MSG_DEBUG( "Decorate muon with " << decorWP << " - accept() ? " << accept_list.getCutResult( WP_itr.c_str()) );
-    muon->auxdecor<char>(decorWP) = static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) );
+    // Keep the decision for all input WPs: they are decorated by passCuts() if the muon is selected
+    //
+    for ( auto WP_itr : m_IsoKeys ) {
+      m_mu_toolDecisions.emplace_back( "isIsolated_" + WP_itr, static_cast<char>( accept_list.getCutResult( WP_itr.c_str() ) ) );
+    }
 
+    // Apply the cut if needed
+    //
+    if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
+      ANA_MSG_DEBUG( "Muon failed isolation cut " <<  m_MinIsoWPCut );
+      return false;
+    }
+    if ( m_useCutFlow ) m_mu_cutflow.count( MuonCut::iso );
+    return true;
   }
 
-  // Apply the cut if needed
+  // *********************************************************************************************************************************************************************
   //
-  if ( !m_MinIsoWPCut.empty() && !accept_list.getCutResult( m_MinIsoWPCut.c_str() ) ) {
-    ANA_MSG_DEBUG( "Muon failed isolation cut " <<  m_MinIsoWPCut );
-    return 0;
-  }
-  if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_iso_cut, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_iso_cut, 1 ); }
-
-  if( m_removeCosmicMuon ){
+  // cosmic muon cut
+  //
+  case MuonCut::cosmic : {
+    const xAOD::TrackParticle* tp = muon->primaryTrackParticle();
+    if ( !tp ) { return false; }
 
     double muon_d0 = tp->d0();
     double pv_z = primaryVertex ? primaryVertex->z() : 0;
@@ -920,14 +972,19 @@ int MuonSelector :: passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primar
 
     if( fabs(muon_z0_exPV) >= 1.0 || fabs(muon_d0) >= 0.2 ){
       ANA_MSG_DEBUG("Muon failed cosmic cut" );
-      return 0;
+      return false;
     }
-    if (!m_isUsedBefore && m_useCutFlow) m_mu_cutflowHist_1->Fill( m_mu_cutflow_cosmic_cut, 1 );
-    if ( m_isUsedBefore && m_useCutFlow ) { m_mu_cutflowHist_2->Fill( m_mu_cutflow_cosmic_cut, 1 ); }
+    if ( m_useCutFlow ) m_mu_cutflow.count( MuonCut::cosmic );
+    return true;
+  }
 
+  default:
+    return true;
   }
 
+}
 
-  ANA_MSG_DEBUG( "Leave passCuts... pass" );
-  return 1;
+std::string MuonSelector :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " " + m_vertexContainerName + " *TrackParticles MuonSegments";
 }
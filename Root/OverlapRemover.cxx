@@ -1140,3 +1140,9 @@ EL::StatusCode OverlapRemover :: setCounters( )
 
   return EL::StatusCode::SUCCESS;
 }
+
+std::string OverlapRemover :: declaredInputs () const
+{
+  return m_inContainerName_Electrons + " " + m_inContainerName_Muons + " " + m_inContainerName_Jets + " " + m_inContainerName_Photons + " "
+         + m_inContainerName_Taus + " " + m_eventInfoContainerName;
+}
@@ -3,6 +3,7 @@
 ANA_MSG_SOURCE(msgPIDManager, "PIDManager")
 
 ElectronLHPIDManager :: ElectronLHPIDManager ( std::string WP, bool debug ) :
+  m_selectedWPIndex(0),
   m_asgElectronLikelihoodTool_VeryLoose(nullptr),
   m_asgElectronLikelihoodTool_Loose(nullptr),
   m_asgElectronLikelihoodTool_LooseBL(nullptr),
@@ -74,6 +75,19 @@ StatusCode ElectronLHPIDManager :: setupWPs( bool configTools, std::string selec
       m_validWPTools.insert( it );
 
     }
+
+    /* the LikeEnum::Menu values do not follow the tightness of the menus (LooseBL), so use an explicit ordering */
+    for ( const std::string WP : { "VeryLoose", "Loose", "LooseBL", "Medium", "Tight" } ) {
+      auto it = m_validWPTools.find( WP );
+      if ( it == m_validWPTools.end() ) { continue; }
+      if ( WP == m_selectedWP ) { m_selectedWPIndex = m_validWPsByTightness.size(); }
+      m_validWPsByTightness.push_back( it->first );
+      m_validWPToolsByTightness.push_back( it->second );
+    }
+    if ( m_selectedWPIndex >= m_validWPsByTightness.size() || m_validWPsByTightness.at(m_selectedWPIndex) != m_selectedWP ) {
+      ANA_MSG_ERROR( "Working point " << m_selectedWP << " has no configured AsgElectronLikelihoodTool" );
+      return StatusCode::FAILURE;
+    }
   } else {
     for ( auto it : (m_allWPAuxDecors) ) {
 
@@ -93,6 +107,17 @@ StatusCode ElectronLHPIDManager :: setupWPs( bool configTools, std::string selec
 
 }
 
+unsigned int ElectronLHPIDManager :: acceptNested( const xAOD::Electron* electron ) {
+
+  unsigned int nPassed(0);
+  for ( auto tool : m_validWPToolsByTightness ) {
+    if ( !tool->accept( electron ) ) { break; }
+    ++nPassed;
+  }
+  return nPassed;
+
+}
+
 /* set default values for decorations (do it for all WPs) */
 StatusCode ElectronLHPIDManager :: setDecorations( const xAOD::Electron* electron ) {
 
@@ -112,6 +137,7 @@ const std::string ElectronLHPIDManager :: getSelectedWP () {
 }
 
 ElectronCutBasedPIDManager :: ElectronCutBasedPIDManager ( std::string WP, bool debug ) :
+  m_selectedWPIndex(0),
   m_asgElectronIsEMSelector_Loose(nullptr),
   m_asgElectronIsEMSelector_Medium(nullptr),
   m_asgElectronIsEMSelector_Tight(nullptr)
@@ -176,6 +202,19 @@ StatusCode ElectronCutBasedPIDManager :: setupWPs( bool configTools, std::string
 
     }
 
+    /* the multimap is sorted by name: keep also the tools ordered by tightness */
+    for ( const std::string WP : { "Loose", "Medium", "Tight" } ) {
+      auto it = m_validWPTools.find( WP );
+      if ( it == m_validWPTools.end() ) { continue; }
+      if ( WP == m_selectedWP ) { m_selectedWPIndex = m_validWPsByTightness.size(); }
+      m_validWPsByTightness.push_back( it->first );
+      m_validWPToolsByTightness.push_back( it->second );
+    }
+    if ( m_selectedWPIndex >= m_validWPsByTightness.size() || m_validWPsByTightness.at(m_selectedWPIndex) != m_selectedWP ) {
+      ANA_MSG_ERROR( "Working point " << m_selectedWP << " has no configured AsgElectronIsEMSelector" );
+      return StatusCode::FAILURE;
+    }
+
   } else {
 
     for ( auto it : (m_allWPAuxDecors) ) {
@@ -196,6 +235,17 @@ StatusCode ElectronCutBasedPIDManager :: setupWPs( bool configTools, std::string
   return StatusCode::SUCCESS;
 }
 
+unsigned int ElectronCutBasedPIDManager :: acceptNested( const xAOD::Electron* electron ) {
+
+  unsigned int nPassed(0);
+  for ( auto tool : m_validWPToolsByTightness ) {
+    if ( !tool->accept( *electron ) ) { break; }
+    ++nPassed;
+  }
+  return nPassed;
+
+}
+
 /* set default values for decorations (do it for all WPs) */
 StatusCode ElectronCutBasedPIDManager :: setDecorations( const xAOD::Electron* electron ) {
   for ( auto it : (m_allWPTools) ) {
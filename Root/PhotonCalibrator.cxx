@@ -166,6 +166,8 @@ EL::StatusCode PhotonCalibrator :: initialize ()
 
   ANA_MSG_INFO("Will be using EgammaCalibrationAndSmearingTool systematic:");
 
+  this->setSystematicTimers( m_systList );
+
   std::vector< std::string >* SystPhotonsNames = new std::vector< std::string >;
   for ( const auto& syst_it : m_systList ) {
     SystPhotonsNames->push_back(syst_it.name());
@@ -329,7 +331,9 @@ EL::StatusCode PhotonCalibrator :: execute ()
   //
   std::vector< std::string >* vecOutContainerNames = new std::vector< std::string >;
 
-  for ( const auto& syst_it : m_systList ) {
+  for ( std::size_t iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
+    const auto& syst_it = m_systList[iSyst];
+    auto systTimer = this->timeSystematic( iSyst );
     ANA_MSG_DEBUG("Systematic Loop for m_systList=" << syst_it.name() );
     // discard photon systematics
     //
@@ -606,3 +610,7 @@ EL::StatusCode PhotonCalibrator :: decorate(xAOD::Photon* photon)
   return EL::StatusCode::SUCCESS;
 }
 
+std::string PhotonCalibrator :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " egamma*Clusters *TrackParticles *ConversionVertices";
+}
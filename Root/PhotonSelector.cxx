@@ -131,15 +131,15 @@ EL::StatusCode PhotonSelector :: initialize ()
     //
     m_ph_cutflowHist_1 = (TH1D*)file->Get("cutflow_photons_1");
 
-    m_ph_cutflow_all             = m_ph_cutflowHist_1->GetXaxis()->FindBin("all");
-    m_ph_cutflow_author_cut      = m_ph_cutflowHist_1->GetXaxis()->FindBin("author_cut");
-    m_ph_cutflow_OQ_cut          = m_ph_cutflowHist_1->GetXaxis()->FindBin("OQ_cut");
-    m_ph_cutflow_PID_cut         = m_ph_cutflowHist_1->GetXaxis()->FindBin("PID_cut");
-    m_ph_cutflow_ptmax_cut       = m_ph_cutflowHist_1->GetXaxis()->FindBin("ptmax_cut");
-    m_ph_cutflow_ptmin_cut       = m_ph_cutflowHist_1->GetXaxis()->FindBin("ptmin_cut");
-    m_ph_cutflow_eta_cut         = m_ph_cutflowHist_1->GetXaxis()->FindBin("eta_cut"); // including crack veto, if applied
-    m_ph_cutflow_iso_cut         = m_ph_cutflowHist_1->GetXaxis()->FindBin("iso_cut");
-
+    m_ph_cutflow.setHist( m_ph_cutflowHist_1 );
+    m_ph_cutflow.bookBin( PhotonCut::all,    "all" );
+    m_ph_cutflow.bookBin( PhotonCut::author, "author_cut" );
+    m_ph_cutflow.bookBin( PhotonCut::OQ,     "OQ_cut" );
+    m_ph_cutflow.bookBin( PhotonCut::PID,    "PID_cut" );
+    m_ph_cutflow.bookBin( PhotonCut::ptmax,  "ptmax_cut" );
+    m_ph_cutflow.bookBin( PhotonCut::ptmin,  "ptmin_cut" );
+    m_ph_cutflow.bookBin( PhotonCut::eta,    "eta_cut" ); // including crack veto, if applied
+    m_ph_cutflow.bookBin( PhotonCut::iso,    "iso_cut" );
 
   }
 
@@ -408,7 +408,7 @@ bool PhotonSelector :: passCuts( const xAOD::Photon* photon )
     ANA_MSG_ERROR("Please call PhotonCalibrator before calling PhotonSelector, or check the quality requirement (should be either of Tight/Medium/Loose) [" << m_name << " " << photonIDKeyName << "]");
   }
 
-  if(m_useCutFlow) m_ph_cutflowHist_1->Fill( m_ph_cutflow_all, 1 );
+  if ( m_useCutFlow ) m_ph_cutflow.count( PhotonCut::all );
 
   // *********************************************************************************************************************************************************************
   //
@@ -420,7 +420,7 @@ bool PhotonSelector :: passCuts( const xAOD::Photon* photon )
       return false;
     }
   }
-  if(m_useCutFlow) m_ph_cutflowHist_1->Fill( m_ph_cutflow_author_cut, 1 );
+  if ( m_useCutFlow ) m_ph_cutflow.count( PhotonCut::author );
 
   // *********************************************************************************************************************************************************************
   //
@@ -441,7 +441,7 @@ bool PhotonSelector :: passCuts( const xAOD::Photon* photon )
       }
     }
   }
-  if(m_useCutFlow) m_ph_cutflowHist_1->Fill( m_ph_cutflow_OQ_cut, 1 );
+  if ( m_useCutFlow ) m_ph_cutflow.count( PhotonCut::OQ );
 
   // *********************************************************************************************************************************************************************
   //
@@ -454,7 +454,7 @@ bool PhotonSelector :: passCuts( const xAOD::Photon* photon )
       return false;
     }
   }
-  if(m_useCutFlow) m_ph_cutflowHist_1->Fill( m_ph_cutflow_PID_cut, 1 );
+  if ( m_useCutFlow ) m_ph_cutflow.count( PhotonCut::PID );
 
   // *********************************************************************************************************************************************************************
   //
@@ -466,7 +466,7 @@ bool PhotonSelector :: passCuts( const xAOD::Photon* photon )
       return false;
     }
   }
-  if(m_useCutFlow) m_ph_cutflowHist_1->Fill( m_ph_cutflow_ptmax_cut, 1 );
+  if ( m_useCutFlow ) m_ph_cutflow.count( PhotonCut::ptmax );
 
   // *********************************************************************************************************************************************************************
   //
@@ -478,7 +478,7 @@ bool PhotonSelector :: passCuts( const xAOD::Photon* photon )
       return false;
     }
   }
-  if(m_useCutFlow) m_ph_cutflowHist_1->Fill( m_ph_cutflow_ptmin_cut, 1 );
+  if ( m_useCutFlow ) m_ph_cutflow.count( PhotonCut::ptmin );
 
   // *********************************************************************************************************************************************************************
   //
@@ -501,7 +501,7 @@ bool PhotonSelector :: passCuts( const xAOD::Photon* photon )
       return false;
     }
   }
-  if(m_useCutFlow) m_ph_cutflowHist_1->Fill( m_ph_cutflow_eta_cut, 1 );
+  if ( m_useCutFlow ) m_ph_cutflow.count( PhotonCut::eta );
 
   // *********************************************************************************************************************************************************************
   //
@@ -531,7 +531,7 @@ bool PhotonSelector :: passCuts( const xAOD::Photon* photon )
     ANA_MSG_DEBUG( "Photon failed isolation cut " << m_MinIsoWPCut );
     return false;
   }
-  if(m_useCutFlow) m_ph_cutflowHist_1->Fill( m_ph_cutflow_iso_cut, 1 );
+  if ( m_useCutFlow ) m_ph_cutflow.count( PhotonCut::iso );
 
   return true;
 }
@@ -568,6 +568,7 @@ EL::StatusCode PhotonSelector :: finalize ()
     ANA_MSG_INFO( "Filling cutflow");
     m_cutflowHist ->SetBinContent( m_cutflow_bin, m_numEventPass        );
     m_cutflowHistW->SetBinContent( m_cutflow_bin, m_weightNumEventPass  );
+    m_ph_cutflow.flush();
   }
 
   ANA_MSG_DEBUG("Cutflow filled");
@@ -612,3 +613,8 @@ EL::StatusCode PhotonSelector :: histFinalize ()
 
   return EL::StatusCode::SUCCESS;
 }
+
+std::string PhotonSelector :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " egamma*Clusters *TrackParticles *ConversionVertices";
+}
@@ -0,0 +1,255 @@
+// c++ include(s):
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+// EL include(s):
+#include <EventLoop/Job.h>
+#include <EventLoop/StatusCode.h>
+#include <EventLoop/Worker.h>
+// output stream
+#include "EventLoop/OutputStream.h"
+
+// EDM include(s):
+#include "AthLinks/ElementLink.h"
+#include "xAODBase/IParticleContainer.h"
+#include "xAODEgamma/ElectronContainer.h"
+#include "xAODEgamma/ElectronAuxContainer.h"
+#include "xAODEgamma/PhotonContainer.h"
+#include "xAODEgamma/PhotonAuxContainer.h"
+#include "xAODJet/JetContainer.h"
+#include "xAODJet/JetAuxContainer.h"
+#include "xAODMissingET/MissingETContainer.h"
+#include "xAODMissingET/MissingETAuxContainer.h"
+#include "xAODMuon/MuonContainer.h"
+#include "xAODMuon/MuonAuxContainer.h"
+#include "xAODTau/TauJetContainer.h"
+#include "xAODTau/TauJetAuxContainer.h"
+#include "xAODTracking/TrackParticleContainer.h"
+#include "xAODTracking/TrackParticleAuxContainer.h"
+
+// package include(s):
+#include "xAODAnaHelpers/StoreRecorder.h"
+#include "xAODAnaHelpers/HelperFunctions.h"
+
+// this is needed to distribute the algorithm to the workers
+ClassImp(StoreRecorder)
+
+const std::string StoreRecorder::RecordedContainersKey = "xAHStoreRecord_Containers";
+const std::string StoreRecorder::RecordedVectorsKey    = "xAHStoreRecord_Vectors";
+
+StoreRecorder :: StoreRecorder () :
+    Algorithm("StoreRecorder")
+{
+}
+
+EL::StatusCode StoreRecorder :: setupJob (EL::Job& job)
+{
+  ANA_MSG_DEBUG("Calling setupJob");
+
+  job.useXAOD ();
+  xAOD::Init( "StoreRecorder" ).ignore(); // call before opening first file
+
+  EL::OutputStream out_xAOD (m_outputFileName, "xAOD");
+  job.outputAdd (out_xAOD);
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreRecorder :: histInitialize ()
+{
+  ANA_CHECK( xAH::Algorithm::algInitialize());
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreRecorder :: fileExecute () { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode StoreRecorder :: changeInput (bool /*firstFile*/) { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode StoreRecorder :: initialize ()
+{
+  ANA_MSG_DEBUG("Calling initialize");
+
+  m_event = wk()->xaodEvent();
+  m_store = wk()->xaodStore();
+
+  TFile *file_xAOD = wk()->getOutputFile(m_outputFileName);
+  ANA_CHECK( m_event->writeTo(file_xAOD));
+
+  std::string token;
+  std::istringstream ss("");
+
+  // A B C D ... Z -> {A, B, C, D, ..., Z}
+  ss.clear(); ss.str(m_simpleCopyKeys);
+  while(std::getline(ss, token, ' '))
+    if(!token.empty()) m_simpleCopyKeys_vec.push_back(token);
+
+  ss.clear(); ss.str(m_storeKeys);
+  while(std::getline(ss, token, ' '))
+    if(!token.empty()) m_storeKeys_vec.push_back(token);
+
+  // A1|A2 B1|B2 C1|C2 ... Z1|Z2 -> {(A1, A2), (B1, B2), ..., (Z1, Z2)}
+  ss.clear(); ss.str(m_systKeys);
+  while(std::getline(ss, token, ' ')){
+    if(token.empty()) continue;
+    std::size_t pos = token.find_first_of('|');
+    if(pos == std::string::npos){
+      ANA_MSG_ERROR("m_systKeys entries must be of the form 'vector name|container name', got " << token);
+      return EL::StatusCode::FAILURE;
+    }
+    m_systKeys_vec.push_back(std::pair<std::string, std::string>(token.substr(0, pos), token.substr(pos+1)));
+  }
+
+  if ( m_storeKeys_vec.empty() && m_systKeys_vec.empty() ) {
+    ANA_MSG_WARNING("No TStore containers to record: only " << m_simpleCopyKeys << " will be written out");
+  }
+
+  ANA_MSG_INFO("Recording " << ( ( m_nEventsToRecord < 0 ) ? std::string("all the") : std::to_string(m_nEventsToRecord) ) << " events to " << m_outputFileName);
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreRecorder :: execute ()
+{
+  if ( m_nEventsToRecord >= 0 && m_numRecorded >= m_nEventsToRecord ) return EL::StatusCode::SUCCESS;
+
+  ANA_MSG_VERBOSE( "Recording the TStore content...");
+
+  for(const auto& key: m_simpleCopyKeys_vec){
+    ANA_CHECK( m_event->copy(key));
+  }
+
+  // the list of what is recorded in this event, for the replay
+  std::vector<std::string>* recordedContainers = new std::vector<std::string>();
+  std::vector<std::string>* recordedVectors    = new std::vector<std::string>();
+  m_linkedKeys.clear();
+
+  for(const auto& key: m_storeKeys_vec){
+    ANA_CHECK( this->recordContainer(key));
+    recordedContainers->push_back(key);
+  }
+
+  for(const auto& keypair: m_systKeys_vec){
+    const std::string& vectorName = keypair.first;
+
+    std::vector<std::string>* systNames(nullptr);
+    ANA_CHECK( HelperFunctions::retrieve(systNames, vectorName, nullptr, m_store, msg()));
+
+    for(const auto& systName: *systNames){
+      const std::string key = keypair.second + systName;
+      // several vectors can point to the same containers
+      if ( std::find( recordedContainers->begin(), recordedContainers->end(), key ) != recordedContainers->end() ) continue;
+      ANA_CHECK( this->recordContainer(key));
+      recordedContainers->push_back(key);
+    }
+
+    ANA_CHECK( m_event->record( new std::vector<std::string>( *systNames ), vectorName ));
+    recordedVectors->push_back(vectorName);
+  }
+
+  // the original objects of the recorded containers, for the replay to match the shallow copies to them
+  for(const auto& key: m_linkedKeys){
+    if ( std::find( m_simpleCopyKeys_vec.begin(), m_simpleCopyKeys_vec.end(), key ) != m_simpleCopyKeys_vec.end() ) continue;
+    if ( std::find( recordedContainers->begin(), recordedContainers->end(), key ) != recordedContainers->end() ) continue;
+    if ( !m_event->copy(key).isSuccess() ) {
+      ANA_MSG_ERROR("The recorded objects link to " << key << ", which is not in the input file: add it to m_storeKeys");
+      return EL::StatusCode::FAILURE;
+    }
+    ANA_MSG_DEBUG("Copied " << key << ", the original objects of the recorded containers");
+  }
+
+  ANA_CHECK( m_event->record( recordedContainers, RecordedContainersKey ));
+  ANA_CHECK( m_event->record( recordedVectors, RecordedVectorsKey ));
+
+  m_event->fill();
+  ++m_numRecorded;
+
+  if ( m_numRecorded == m_nEventsToRecord ) {
+    ANA_MSG_INFO("Recorded " << m_numRecorded << " events, nothing else will be written to " << m_outputFileName);
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreRecorder :: recordContainer( const std::string& key )
+{
+  // a ConstDataVector is seen as its underlying container, and written out as a deep copy
+  if ( m_store->contains<const xAOD::JetContainer>(key) ) {
+    ANA_CHECK( (this->recordDeepCopy<xAOD::JetContainer, xAOD::JetAuxContainer, xAOD::Jet>(key)));
+  } else if ( m_store->contains<const xAOD::ElectronContainer>(key) ) {
+    ANA_CHECK( (this->recordDeepCopy<xAOD::ElectronContainer, xAOD::ElectronAuxContainer, xAOD::Electron>(key)));
+  } else if ( m_store->contains<const xAOD::PhotonContainer>(key) ) {
+    ANA_CHECK( (this->recordDeepCopy<xAOD::PhotonContainer, xAOD::PhotonAuxContainer, xAOD::Photon>(key)));
+  } else if ( m_store->contains<const xAOD::MuonContainer>(key) ) {
+    ANA_CHECK( (this->recordDeepCopy<xAOD::MuonContainer, xAOD::MuonAuxContainer, xAOD::Muon>(key)));
+  } else if ( m_store->contains<const xAOD::TauJetContainer>(key) ) {
+    ANA_CHECK( (this->recordDeepCopy<xAOD::TauJetContainer, xAOD::TauJetAuxContainer, xAOD::TauJet>(key)));
+  } else if ( m_store->contains<const xAOD::TrackParticleContainer>(key) ) {
+    ANA_CHECK( (this->recordDeepCopy<xAOD::TrackParticleContainer, xAOD::TrackParticleAuxContainer, xAOD::TrackParticle>(key)));
+  } else if ( m_store->contains<const xAOD::MissingETContainer>(key) ) {
+    ANA_CHECK( (this->recordDeepCopy<xAOD::MissingETContainer, xAOD::MissingETAuxContainer, xAOD::MissingET>(key)));
+  } else {
+    ANA_MSG_ERROR("Could not find " << key << " in the TStore as one of the supported container types.");
+    return EL::StatusCode::FAILURE;
+  }
+
+  ANA_MSG_DEBUG("Recorded " << key);
+  return EL::StatusCode::SUCCESS;
+}
+
+template <typename T1, typename T2, typename T3>
+EL::StatusCode StoreRecorder :: recordDeepCopy( const std::string& key )
+{
+  const T1* cont(nullptr);
+  ANA_CHECK( m_store->retrieve(cont, key));
+  this->collectOriginalLinks( cont );
+
+  T1* cont_new = new T1();
+  T2* auxcont_new = new T2();
+  cont_new->setStore(auxcont_new);
+
+  for(const auto p: *cont){
+    T3* p_new = new T3();
+    cont_new->push_back(p_new);
+    *p_new = *p;
+  }
+
+  ANA_CHECK( m_event->record(cont_new, key));
+  ANA_CHECK( m_event->record(auxcont_new, key+"Aux."));
+  return EL::StatusCode::SUCCESS;
+}
+
+template <typename T1>
+void StoreRecorder :: collectOriginalLinks( const T1* cont )
+{
+  static const SG::AuxElement::ConstAccessor< ElementLink<xAOD::IParticleContainer> > originalObjectLink("originalObjectLink");
+
+  // the objects of a container usually all point to the same one: only look up the name of a new key
+  SG::sgkey_t lastKey = 0;
+  for(const auto p: *cont){
+    if ( !originalObjectLink.isAvailable(*p) ) return;
+    const ElementLink<xAOD::IParticleContainer>& link = originalObjectLink(*p);
+    if ( !link.isValid() || link.key() == lastKey ) continue;
+    lastKey = link.key();
+    const std::string linkedKey = link.dataID();
+    if ( std::find( m_linkedKeys.begin(), m_linkedKeys.end(), linkedKey ) == m_linkedKeys.end() ) m_linkedKeys.push_back(linkedKey);
+  }
+}
+
+EL::StatusCode StoreRecorder :: postExecute () { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode StoreRecorder :: finalize ()
+{
+  ANA_MSG_INFO("Recorded " << m_numRecorded << " events to " << m_outputFileName);
+
+  TFile *file_xAOD = wk()->getOutputFile(m_outputFileName);
+  ANA_CHECK( m_event->finishWritingTo(file_xAOD));
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreRecorder :: histFinalize ()
+{
+  ANA_CHECK( xAH::Algorithm::algFinalize());
+  return EL::StatusCode::SUCCESS;
+}
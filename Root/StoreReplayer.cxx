@@ -0,0 +1,146 @@
+// c++ include(s):
+#include <iostream>
+
+// EL include(s):
+#include <EventLoop/Job.h>
+#include <EventLoop/StatusCode.h>
+#include <EventLoop/Worker.h>
+
+// EDM include(s):
+#include "AthLinks/ElementLink.h"
+#include "xAODBase/IParticleContainer.h"
+#include "xAODCore/ShallowCopy.h"
+#include "xAODEgamma/ElectronContainer.h"
+#include "xAODEgamma/PhotonContainer.h"
+#include "xAODJet/JetContainer.h"
+#include "xAODMissingET/MissingETContainer.h"
+#include "xAODMuon/MuonContainer.h"
+#include "xAODTau/TauJetContainer.h"
+#include "xAODTracking/TrackParticleContainer.h"
+
+// package include(s):
+#include "xAODAnaHelpers/StoreReplayer.h"
+#include "xAODAnaHelpers/StoreRecorder.h"
+#include "xAODAnaHelpers/HelperFunctions.h"
+
+// this is needed to distribute the algorithm to the workers
+ClassImp(StoreReplayer)
+
+StoreReplayer :: StoreReplayer () :
+    Algorithm("StoreReplayer")
+{
+}
+
+EL::StatusCode StoreReplayer :: setupJob (EL::Job& job)
+{
+  ANA_MSG_DEBUG("Calling setupJob");
+
+  job.useXAOD ();
+  xAOD::Init( "StoreReplayer" ).ignore(); // call before opening first file
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreReplayer :: histInitialize ()
+{
+  ANA_CHECK( xAH::Algorithm::algInitialize());
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreReplayer :: fileExecute () { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode StoreReplayer :: changeInput (bool /*firstFile*/) { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode StoreReplayer :: initialize ()
+{
+  ANA_MSG_DEBUG("Calling initialize");
+
+  m_event = wk()->xaodEvent();
+  m_store = wk()->xaodStore();
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreReplayer :: execute ()
+{
+  const std::vector<std::string>* recordedContainers(nullptr);
+  const std::vector<std::string>* recordedVectors(nullptr);
+  if ( !m_event->contains< std::vector<std::string> >( StoreRecorder::RecordedContainersKey ) ) {
+    ANA_MSG_ERROR("The input was not written by StoreRecorder: " << StoreRecorder::RecordedContainersKey << " is missing");
+    return EL::StatusCode::FAILURE;
+  }
+  ANA_CHECK( m_event->retrieve( recordedContainers, StoreRecorder::RecordedContainersKey ));
+  ANA_CHECK( m_event->retrieve( recordedVectors, StoreRecorder::RecordedVectorsKey ));
+
+  for(const auto& key: *recordedContainers){
+    ANA_CHECK( this->replayContainer(key));
+  }
+
+  for(const auto& vectorName: *recordedVectors){
+    const std::vector<std::string>* systNames(nullptr);
+    ANA_CHECK( m_event->retrieve( systNames, vectorName ));
+    ANA_CHECK( m_store->record( new std::vector<std::string>( *systNames ), vectorName ));
+  }
+
+  ++m_numReplayed;
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreReplayer :: replayContainer( const std::string& key )
+{
+  if ( m_event->contains<const xAOD::JetContainer>(key) ) {
+    ANA_CHECK( this->replayShallowCopy<xAOD::JetContainer>(key));
+  } else if ( m_event->contains<const xAOD::ElectronContainer>(key) ) {
+    ANA_CHECK( this->replayShallowCopy<xAOD::ElectronContainer>(key));
+  } else if ( m_event->contains<const xAOD::PhotonContainer>(key) ) {
+    ANA_CHECK( this->replayShallowCopy<xAOD::PhotonContainer>(key));
+  } else if ( m_event->contains<const xAOD::MuonContainer>(key) ) {
+    ANA_CHECK( this->replayShallowCopy<xAOD::MuonContainer>(key));
+  } else if ( m_event->contains<const xAOD::TauJetContainer>(key) ) {
+    ANA_CHECK( this->replayShallowCopy<xAOD::TauJetContainer>(key));
+  } else if ( m_event->contains<const xAOD::TrackParticleContainer>(key) ) {
+    ANA_CHECK( this->replayShallowCopy<xAOD::TrackParticleContainer>(key));
+  } else if ( m_event->contains<const xAOD::MissingETContainer>(key) ) {
+    ANA_CHECK( this->replayShallowCopy<xAOD::MissingETContainer>(key));
+  } else {
+    ANA_MSG_ERROR("Could not find " << key << " in the input as one of the supported container types.");
+    return EL::StatusCode::FAILURE;
+  }
+
+  ANA_MSG_VERBOSE("Replayed " << key);
+  return EL::StatusCode::SUCCESS;
+}
+
+template <typename T1>
+EL::StatusCode StoreReplayer :: replayShallowCopy( const std::string& key )
+{
+  const T1* cont(nullptr);
+  ANA_CHECK( m_event->retrieve(cont, key));
+
+  // the links to the original objects (used e.g. by the MET maker to match the calibrated objects) must be there
+  static const SG::AuxElement::ConstAccessor< ElementLink<xAOD::IParticleContainer> > originalObjectLink("originalObjectLink");
+  if ( !cont->empty() && originalObjectLink.isAvailable( *cont->front() ) && !originalObjectLink( *cont->front() ).isValid() ) {
+    ANA_MSG_ERROR("The original objects of " << key << " are not in the input: record their container with StoreRecorder");
+    return EL::StatusCode::FAILURE;
+  }
+
+  std::pair< T1*, xAOD::ShallowAuxContainer* > copy = xAOD::shallowCopyContainer( *cont );
+  ANA_CHECK( m_store->record( copy.first,  key ));
+  ANA_CHECK( m_store->record( copy.second, key+"Aux." ));
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreReplayer :: postExecute () { return EL::StatusCode::SUCCESS; }
+
+EL::StatusCode StoreReplayer :: finalize ()
+{
+  ANA_MSG_INFO("Replayed " << m_numReplayed << " recorded events");
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode StoreReplayer :: histFinalize ()
+{
+  ANA_CHECK( xAH::Algorithm::algFinalize());
+  return EL::StatusCode::SUCCESS;
+}
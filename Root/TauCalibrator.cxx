@@ -146,6 +146,8 @@ EL::StatusCode TauCalibrator :: initialize ()
   m_systList = HelperFunctions::getListofSystematics( recSyst, m_systName, m_systVal, msg() );
 
   ANA_MSG_INFO("Will be using TauSmearingTool systematic:");
+  this->setSystematicTimers( m_systList );
+
   std::vector< std::string >* SystTausNames = new std::vector< std::string >;
   for ( const auto& syst_it : m_systList ) {
     if ( m_systName.empty() ) {
@@ -197,7 +199,9 @@ EL::StatusCode TauCalibrator :: execute ()
   //
   std::vector< std::string >* vecOutContainerNames = new std::vector< std::string >;
 
-  for ( const auto& syst_it : m_systList ) {
+  for ( std::size_t iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
+    const auto& syst_it = m_systList[iSyst];
+    auto systTimer = this->timeSystematic( iSyst );
 
     std::string outSCContainerName(m_outSCContainerName);
     std::string outSCAuxContainerName(m_outSCAuxContainerName);
@@ -335,3 +339,8 @@ EL::StatusCode TauCalibrator :: histFinalize ()
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
+
+std::string TauCalibrator :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " TauTracks *TrackParticles";
+}
@@ -443,3 +443,8 @@ EL::StatusCode TauEfficiencyCorrector :: executeSF ( const xAOD::EventInfo* /*ev
   
   return EL::StatusCode::SUCCESS;
 }
+
+std::string TauEfficiencyCorrector :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " TauTracks *TrackParticles";
+}
@@ -369,3 +369,8 @@ std::unordered_map<int, std::pair<const xAOD::TauJet*, const xAOD::Jet* > > TauJ
   return match_map;
 
 }
+
+std::string TauJetMatching :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_inJetContainerName + " " + m_eventInfoContainerName;
+}
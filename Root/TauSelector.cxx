@@ -150,15 +150,16 @@ EL::StatusCode TauSelector :: initialize ()
     // retrieve the object cutflow
     //
     m_tau_cutflowHist_1  = (TH1D*)file->Get("cutflow_taus_1");
-
-    m_tau_cutflow_all                  = m_tau_cutflowHist_1->GetXaxis()->FindBin("all");
-    m_tau_cutflow_selected             = m_tau_cutflowHist_1->GetXaxis()->FindBin("selected");
-
     if ( m_isUsedBefore ) {
       m_tau_cutflowHist_2 = (TH1D*)file->Get("cutflow_taus_2");
+    }
 
-      m_tau_cutflow_all                  = m_tau_cutflowHist_2->GetXaxis()->FindBin("all");
-      m_tau_cutflow_selected             = m_tau_cutflowHist_2->GetXaxis()->FindBin("selected");
+    // the counts go to the last histogram set (see xAH::CutflowCounter)
+    for ( TH1D* hist : { m_tau_cutflowHist_1, m_tau_cutflowHist_2 } ) {
+      if ( !hist ) continue;
+      m_tau_cutflow.setHist( hist );
+      m_tau_cutflow.bookBin( TauCut::all,      "all" );
+      m_tau_cutflow.bookBin( TauCut::selected, "selected" );
     }
 
   }
@@ -644,6 +645,7 @@ EL::StatusCode TauSelector :: finalize ()
     ANA_MSG_INFO( "Filling cutflow");
     m_cutflowHist ->SetBinContent( m_cutflow_bin, m_numEventPass        );
     m_cutflowHistW->SetBinContent( m_cutflow_bin, m_weightNumEventPass  );
+    m_tau_cutflow.flush();
   }
 
   return EL::StatusCode::SUCCESS;
@@ -672,8 +674,7 @@ EL::StatusCode TauSelector :: histFinalize ()
 int TauSelector :: passCuts( const xAOD::TauJet* tau ) {
 
   // fill cutflow bin 'all' before any cut
-  if(!m_isUsedBefore && m_useCutFlow) m_tau_cutflowHist_1->Fill( m_tau_cutflow_all, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_tau_cutflowHist_2->Fill( m_tau_cutflow_all, 1 ); }
+  if ( m_useCutFlow ) m_tau_cutflow.count( TauCut::all );
 
   // **********************************************************************************************************
   //
@@ -786,9 +787,12 @@ int TauSelector :: passCuts( const xAOD::TauJet* tau ) {
     return 0;
   }
 
-  if( !m_isUsedBefore && m_useCutFlow) m_tau_cutflowHist_1->Fill( m_tau_cutflow_selected, 1 );
-  if ( m_isUsedBefore && m_useCutFlow ) { m_tau_cutflowHist_2->Fill( m_tau_cutflow_selected, 1 ); }
+  if ( m_useCutFlow ) m_tau_cutflow.count( TauCut::selected );
 
   return 1;
 }
 
+std::string TauSelector :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " " + m_vertexContainerName + " TauTracks *TrackParticles";
+}
@@ -0,0 +1,135 @@
+#include <xAODAnaHelpers/TimingRegistry.h>
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <TTree.h>
+
+bool xAH::TimingRegistry::s_enabled = false;
+std::map<std::string, xAH::TimingRegistry::Entry> xAH::TimingRegistry::s_entries = {};
+std::vector<const xAH::TimingRegistry::Entry*> xAH::TimingRegistry::s_ordered = {};
+xAH::LatencyStats xAH::TimingRegistry::s_overhead;
+
+void xAH::LatencyStats::add( double seconds ) {
+  int bin = 0;
+  if ( seconds >= MinTime ) {
+    bin = 1 + static_cast<int>( std::log10( seconds / MinTime ) * NBinsPerDecade );
+    if ( bin > NBins ) bin = NBins + 1;
+  }
+  ++m_counts[bin];
+  ++m_entries;
+  m_total += seconds;
+}
+
+double xAH::LatencyStats::quantile( double q ) const {
+  if ( m_entries == 0 ) return 0.;
+
+  const double target = q * m_entries;
+  double cumulative = 0.;
+  for ( int bin = 0; bin < NBins + 2; ++bin ) {
+    if ( m_counts[bin] == 0 ) continue;
+    if ( cumulative + m_counts[bin] >= target ) {
+      if ( bin == 0 )         return MinTime;
+      if ( bin == NBins + 1 ) return MinTime * std::pow( 10., static_cast<double>(NBins) / NBinsPerDecade );
+      // log-linear interpolation inside the bin
+      const double fraction = ( target - cumulative ) / m_counts[bin];
+      return MinTime * std::pow( 10., ( bin - 1 + fraction ) / NBinsPerDecade );
+    }
+    cumulative += m_counts[bin];
+  }
+  return MinTime * std::pow( 10., static_cast<double>(NBins) / NBinsPerDecade );
+}
+
+xAH::LatencyStats* xAH::TimingRegistry::stats( const std::string& algorithm, const std::string& step, const std::string& systematic ) {
+  const std::string key = algorithm + "/" + step + "/" + systematic;
+  auto it = s_entries.find( key );
+  if ( it == s_entries.end() ) {
+    it = s_entries.emplace( key, Entry{ algorithm, step, systematic, LatencyStats() } ).first;
+    s_ordered.push_back( &it->second );
+  }
+  return &it->second.stats;
+}
+
+std::string xAH::TimingRegistry::summary() {
+  // total time of the sequence, i.e. of the algorithms themselves (not of their systematics)
+  double total = 0.;
+  for ( const Entry* entry : s_ordered ) {
+    if ( entry->systematic.empty() ) total += entry->stats.total();
+  }
+
+  std::stringstream ss;
+  ss << std::left << std::setw(40) << "algorithm" << std::setw(12) << "step" << std::setw(30) << "systematic"
+     << std::right << std::setw(10) << "calls" << std::setw(12) << "mean [ms]" << std::setw(12) << "p50 [ms]"
+     << std::setw(12) << "p95 [ms]" << std::setw(12) << "p99 [ms]" << std::setw(12) << "total [s]" << std::setw(9) << "frac" << "\n";
+  ss << std::fixed;
+  for ( const Entry* entry : s_ordered ) {
+    const LatencyStats& stats = entry->stats;
+    ss << std::left << std::setw(40) << entry->algorithm << std::setw(12) << entry->step << std::setw(30) << entry->systematic
+       << std::right << std::setw(10) << stats.entries() << std::setprecision(3)
+       << std::setw(12) << 1e3 * stats.mean()
+       << std::setw(12) << 1e3 * stats.quantile(0.50)
+       << std::setw(12) << 1e3 * stats.quantile(0.95)
+       << std::setw(12) << 1e3 * stats.quantile(0.99)
+       << std::setw(12) << stats.total() << std::setprecision(1)
+       << std::setw(8) << ( ( total > 0. && entry->systematic.empty() ) ? 100. * stats.total() / total : 0. ) << "%\n";
+  }
+  ss << std::setprecision(3) << "total time in the algorithms: " << total << " s, of which timing overhead: " << s_overhead.total()
+     << " s (" << std::setprecision(2) << ( ( total > 0. ) ? 100. * s_overhead.total() / total : 0. ) << "%)\n";
+  return ss.str();
+}
+
+void xAH::TimingRegistry::fillTree( TTree* tree ) {
+  std::string algorithm, step, systematic;
+  unsigned long long calls(0);
+  double mean(0), p50(0), p95(0), p99(0), total(0);
+
+  tree->Branch( "algorithm",  &algorithm );
+  tree->Branch( "step",       &step );
+  tree->Branch( "systematic", &systematic );
+  tree->Branch( "calls",      &calls, "calls/l" );
+  tree->Branch( "mean",       &mean,  "mean/D" );
+  tree->Branch( "p50",        &p50,   "p50/D" );
+  tree->Branch( "p95",        &p95,   "p95/D" );
+  tree->Branch( "p99",        &p99,   "p99/D" );
+  tree->Branch( "total",      &total, "total/D" );
+
+  auto fill = [&]( const std::string& alg, const std::string& st, const std::string& syst, const LatencyStats& stats ) {
+    algorithm = alg; step = st; systematic = syst;
+    calls = stats.entries();
+    mean  = stats.mean();
+    p50   = stats.quantile(0.50);
+    p95   = stats.quantile(0.95);
+    p99   = stats.quantile(0.99);
+    total = stats.total();
+    tree->Fill();
+  };
+
+  for ( const Entry* entry : s_ordered ) fill( entry->algorithm, entry->step, entry->systematic, entry->stats );
+  fill( "AlgorithmTimer", "overhead", "", s_overhead );
+
+  tree->ResetBranchAddresses();
+}
+
+bool xAH::TimingRegistry::writeJSON( const std::string& fileName ) {
+  std::ofstream out( fileName );
+  if ( !out.is_open() ) return false;
+
+  auto write = [&out]( const std::string& alg, const std::string& st, const std::string& syst, const LatencyStats& stats ) {
+    out << "  {\"algorithm\": \"" << alg << "\", \"step\": \"" << st << "\", \"systematic\": \"" << syst << "\""
+        << ", \"calls\": " << stats.entries() << std::scientific << std::setprecision(6)
+        << ", \"mean\": " << stats.mean() << ", \"p50\": " << stats.quantile(0.50) << ", \"p95\": " << stats.quantile(0.95)
+        << ", \"p99\": " << stats.quantile(0.99) << ", \"total\": " << stats.total() << "}";
+  };
+
+  out << "[\n";
+  for ( const Entry* entry : s_ordered ) {
+    write( entry->algorithm, entry->step, entry->systematic, entry->stats );
+    out << ",\n";
+  }
+  write( "AlgorithmTimer", "overhead", "", s_overhead );
+  out << "\n]\n";
+
+  return out.good();
+}
@@ -90,3 +90,8 @@ EL::StatusCode TrackHistsAlgo :: histFinalize ()
   ANA_CHECK( xAH::Algorithm::algFinalize());
   return EL::StatusCode::SUCCESS;
 }
+
+std::string TrackHistsAlgo :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + " " + m_vertexContainerName;
+}
@@ -116,6 +116,15 @@ EL::StatusCode TrackSelector :: initialize ()
     m_failKeys.push_back(token);
   }
 
+  if( m_doTracksInJets ) {
+    m_inTracksAcc.reset   ( new SG::AuxElement::ConstAccessor< std::vector<const xAOD::TrackParticle*> >( m_inContainerName ) );
+    m_inVtxAcc.reset      ( new SG::AuxElement::ConstAccessor< const xAOD::Vertex* >( m_inContainerName+"_vtx" ) );
+    m_outTracksDecor.reset( new SG::AuxElement::Decorator< std::vector<const xAOD::TrackParticle*> >( m_outContainerName ) );
+    m_outVtxDecor.reset   ( new SG::AuxElement::Decorator< const xAOD::Vertex* >( m_outContainerName+"_vtx" ) );
+    for( const auto& passKey : m_passKeys ) m_passAccs.emplace_back( passKey );
+    for( const auto& failKey : m_failKeys ) m_failAccs.emplace_back( failKey );
+  }
+
 
   if( m_inContainerName.empty() ) {
     ANA_MSG_ERROR( "InputContainer is empty!");
@@ -249,53 +258,45 @@ EL::StatusCode TrackSelector :: executeTracksInJets ()
 
   int nPass(0); int nObj(0);
 
-  //
-  //  Accessor for adding the output jets
-  //
-  xAOD::Jet::Decorator<vector<const xAOD::TrackParticle*> > m_track_decoration(m_outContainerName.c_str());
-  xAOD::Jet::Decorator<const xAOD::Vertex*>                 m_vtx_decoration  ((m_outContainerName+"_vtx").c_str());
-
   //
   // loop on Jets
   //
   for ( auto jet_itr : *inJets ) {
 
     //
-    //  output container with in the jet
+    // tracks with in the jet, and the vertex they were associated to
     //
-    vector<const xAOD::TrackParticle*> outputTracks;
+    const vector<const xAOD::TrackParticle*>& inputTracks = (*m_inTracksAcc)(*jet_itr);
+    const xAOD::Vertex* pvx                                = (*m_inVtxAcc)(*jet_itr);
+    nObj += inputTracks.size();
 
     //
-    // loop on tracks with in jet
+    // Get cut desicions
     //
-    const vector<const xAOD::TrackParticle*> inputTracks = jet_itr->auxdata< vector<const xAOD::TrackParticle*>  >(m_inContainerName);
-    const xAOD::Vertex* pvx                              = jet_itr->auxdata< const xAOD::Vertex*                 >(m_inContainerName+"_vtx");
-    for(const xAOD::TrackParticle* trkInJet: inputTracks){
-
-      nObj++;
-
-      //
-      // Get cut desicion
-      //
-      int passSel = this->PassCuts( trkInJet, pvx );
-
-      //
-      // if
-      //
-      if(passSel) {
-	nPass++;
-	outputTracks.push_back(trkInJet);
+    if( m_batchTracksInJets ) {
+      this->PassCutsBatch( inputTracks, pvx );
+    } else {
+      m_batch.pass.resize( inputTracks.size() );
+      for( std::size_t i = 0; i < inputTracks.size(); ++i ) {
+        m_batch.pass[i] = this->PassCuts( inputTracks[i], pvx );
       }
-    }// tracks
+    }
 
-    m_numObject     += nObj;
-    m_numObjectPass += nPass;
+    // collected first: the output decoration may be the input one
+    m_selectedTracks.clear();
+    for( std::size_t i = 0; i < inputTracks.size(); ++i ) {
+      if( m_batch.pass[i] ) m_selectedTracks.push_back( inputTracks[i] );
+    }
+    nPass += m_selectedTracks.size();
 
-    m_track_decoration(*jet_itr)  = outputTracks;
-    m_vtx_decoration(*jet_itr)    = jet_itr->auxdata<const xAOD::Vertex*>(m_inContainerName+"_vtx");
+    (*m_outTracksDecor)(*jet_itr).assign( m_selectedTracks.begin(), m_selectedTracks.end() );
+    (*m_outVtxDecor)(*jet_itr)    = pvx;
 
   }//jets
 
+  m_numObject     += nObj;
+  m_numObjectPass += nPass;
+
   m_numEventPass++;
   return EL::StatusCode::SUCCESS;
 }
@@ -350,6 +351,117 @@ EL::StatusCode TrackSelector :: histFinalize ()
   return EL::StatusCode::SUCCESS;
 }
 
+void TrackSelector :: PassCutsBatch( const std::vector<const xAOD::TrackParticle*>& tracks, const xAOD::Vertex *pvx ) {
+
+  const std::size_t n = tracks.size();
+  TrackBatch& b = m_batch;
+  b.pass.assign( n, 1 );
+  if( n == 0 ) return;
+
+  //
+  // gather the parameters needed by the configured cuts, one array each
+  //
+  const bool cutPt     = ( m_pT_max != 1e8 || m_pT_min != 1e8 );
+  const bool cutEta    = ( m_eta_max != 1e8 || m_eta_min != 1e8 );
+  const bool cutZ0     = ( m_z0_max != 1e8 || m_z0sinT_max != 1e8 );
+  const bool cutChi2   = ( m_chi2NdofCut_max != 1e8 || m_chi2Prob_max != 1e8 );
+
+  if( cutPt )  { b.pt.resize( n );  for( std::size_t i = 0; i < n; ++i ) b.pt[i]  = tracks[i]->pt(); }
+  if( cutEta ) { b.eta.resize( n ); for( std::size_t i = 0; i < n; ++i ) b.eta[i] = tracks[i]->eta(); }
+  if( m_d0_max != 1e8 ) { b.d0.resize( n ); for( std::size_t i = 0; i < n; ++i ) b.d0[i] = tracks[i]->d0(); }
+  if( cutZ0 ) {
+    const float pvz = HelperFunctions::getPrimaryVertexZ(pvx);
+    b.z0.resize( n );
+    b.sinTheta.resize( n );
+    for( std::size_t i = 0; i < n; ++i ) {
+      b.z0[i]       = (tracks[i]->z0() + tracks[i]->vz() - pvz);
+      b.sinTheta[i] = sin(tracks[i]->theta());
+    }
+  }
+  if( cutChi2 ) {
+    b.chi2.resize( n );
+    b.ndof.resize( n );
+    for( std::size_t i = 0; i < n; ++i ) {
+      b.chi2[i] = tracks[i]->chiSquared();
+      b.ndof[i] = tracks[i]->numberDoF();
+    }
+  }
+  // the hit counts are left at -1 when missing, as in PassCuts
+  if( m_nBL_min != 1e8 ) {
+    b.nBL.resize( n );
+    for( std::size_t i = 0; i < n; ++i ) {
+      uint8_t nBL = -1;
+      if(!tracks[i]->summaryValue(nBL, xAOD::numberOfBLayerHits)) ANA_MSG_ERROR( "BLayer hits not filled");
+      b.nBL[i] = nBL;
+    }
+  }
+  if( m_nSi_min != 1e8 ) {
+    b.nSi.resize( n );
+    for( std::size_t i = 0; i < n; ++i ) {
+      uint8_t nSCT = -1;
+      uint8_t nPix = -1;
+      if(!tracks[i]->summaryValue(nPix, xAOD::numberOfPixelHits)) ANA_MSG_ERROR( "Pix hits not filled");
+      if(!tracks[i]->summaryValue(nSCT, xAOD::numberOfSCTHits))   ANA_MSG_ERROR( "SCT hits not filled");
+      b.nSi[i] = nSCT + nPix;
+    }
+  }
+  if( m_nPixHoles_max != 1e8 ) {
+    b.nPixHoles.resize( n );
+    for( std::size_t i = 0; i < n; ++i ) {
+      uint8_t nPixHoles = -1;
+      if(!tracks[i]->summaryValue(nPixHoles, xAOD::numberOfPixelHoles)) ANA_MSG_ERROR( "Pix holes not filled");
+      b.nPixHoles[i] = nPixHoles;
+    }
+  }
+
+  //
+  // apply each cut to all the tracks: the loops have no branch and vectorise
+  //
+  char* pass = b.pass.data();
+  if( m_pT_max != 1e8 )  { const double* pt  = b.pt.data();  for( std::size_t i = 0; i < n; ++i ) pass[i] &= !(pt[i]  > m_pT_max); }
+  if( m_pT_min != 1e8 )  { const double* pt  = b.pt.data();  for( std::size_t i = 0; i < n; ++i ) pass[i] &= !(pt[i]  < m_pT_min); }
+  if( m_eta_max != 1e8 ) { const double* eta = b.eta.data(); for( std::size_t i = 0; i < n; ++i ) pass[i] &= !(eta[i] > m_eta_max); }
+  if( m_eta_min != 1e8 ) { const double* eta = b.eta.data(); for( std::size_t i = 0; i < n; ++i ) pass[i] &= !(eta[i] < m_eta_min); }
+  if( m_d0_max != 1e8 )  { const float* d0  = b.d0.data();  for( std::size_t i = 0; i < n; ++i ) pass[i] &= !(fabs(d0[i]) > m_d0_max); }
+  if( m_z0_max != 1e8 )  { const float* z0  = b.z0.data();  for( std::size_t i = 0; i < n; ++i ) pass[i] &= !(fabs(z0[i]) > m_z0_max); }
+  if( m_z0sinT_max != 1e8 ) {
+    const float* z0 = b.z0.data();
+    const float* sinT = b.sinTheta.data();
+    for( std::size_t i = 0; i < n; ++i ) pass[i] &= !(fabs(z0[i]*sinT[i]) > m_z0sinT_max);
+  }
+  if( m_nBL_min != 1e8 )       { const uint8_t* nBL = b.nBL.data();       for( std::size_t i = 0; i < n; ++i ) pass[i] &= !(nBL[i] < m_nBL_min); }
+  if( m_nSi_min != 1e8 )       { const uint16_t* nSi = b.nSi.data();      for( std::size_t i = 0; i < n; ++i ) pass[i] &= !(nSi[i] < m_nSi_min); }
+  if( m_nPixHoles_max != 1e8 ) { const uint8_t* nPH = b.nPixHoles.data(); for( std::size_t i = 0; i < n; ++i ) pass[i] &= !(nPH[i] > m_nPixHoles_max); }
+  if( m_chi2NdofCut_max != 1e8 ) {
+    const float* chi2 = b.chi2.data();
+    const float* ndof = b.ndof.data();
+    for( std::size_t i = 0; i < n; ++i ) {
+      const float chi2NDoF = (ndof[i] > 0) ? chi2[i]/ndof[i] : -1;
+      pass[i] &= !(chi2NDoF > m_chi2NdofCut_max);
+    }
+  }
+  // not vectorisable, so only for the tracks still passing
+  if( m_chi2Prob_max != 1e8 ) {
+    for( std::size_t i = 0; i < n; ++i ) {
+      if( pass[i] && TMath::Prob(b.chi2[i], b.ndof[i]) > m_chi2Prob_max ) pass[i] = 0;
+    }
+  }
+
+  //
+  //  Pass and Fail Keys
+  //
+  for( const auto& passAcc : m_passAccs ) {
+    for( std::size_t i = 0; i < n; ++i ) {
+      if( pass[i] && !(passAcc(*tracks[i]) == '1') ) pass[i] = 0;
+    }
+  }
+  for( const auto& failAcc : m_failAccs ) {
+    for( std::size_t i = 0; i < n; ++i ) {
+      if( pass[i] && !(failAcc(*tracks[i]) == '0') ) pass[i] = 0;
+    }
+  }
+}
+
 int TrackSelector :: PassCuts( const xAOD::TrackParticle* trk, const xAOD::Vertex *pvx ) {
 
 
@@ -455,4 +567,7 @@ int TrackSelector :: PassCuts( const xAOD::TrackParticle* trk, const xAOD::Verte
   return 1;
 }
 
-
+std::string TrackSelector :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_inJetContainerName + " " + m_eventInfoContainerName + " " + m_vertexContainerName;
+}
@@ -18,6 +18,8 @@ StatusCode TracksInJetHists::initialize() {
   // TrackHists
   //
   m_trkPlots = new TrackHists(m_name, "IPDetails HitCounts TPErrors Chi2Details Debugging vsLumiBlock");
+  m_trkPlots -> setLazyBooking( m_lazyBooking );
+  m_trkPlots -> setStorage( m_storage );
   m_trkPlots -> initialize();
 
   //
@@ -58,6 +60,12 @@ void TracksInJetHists::record(EL::Worker* wk) {
   m_trkPlots -> record( wk );
 }
 
+HistogramManager::MemoryUsage TracksInJetHists::memoryUsage() const {
+  MemoryUsage usage = HistogramManager::memoryUsage();
+  usage += m_trkPlots -> memoryUsage();
+  return usage;
+}
+
 
 
 StatusCode TracksInJetHists::execute( const xAOD::TrackParticle* trk, const xAOD::Jet* jet,  const xAOD::Vertex *pvx, float eventWeight,  const xAOD::EventInfo* eventInfo ) {
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <EventLoop/Job.h>
 #include <EventLoop/StatusCode.h>
 #include <EventLoop/Worker.h>
@@ -610,3 +612,24 @@ EL::StatusCode TreeAlgo :: histFinalize () { return EL::StatusCode::SUCCESS; }
 HelpTreeBase* TreeAlgo :: createTree(xAOD::TEvent *event, TTree* tree, TFile* file, const float units, bool debug, xAOD::TStore* store) {
     return new HelpTreeBase( event, tree, file, units, debug, store );
 }
+
+std::string TreeAlgo :: declaredInputs () const
+{
+  std::string inputs = m_eventInfoContainerName + " " + m_evtContainerName + " " + m_muContainerName + " " + m_elContainerName + " "
+                       + m_jetContainerName + " " + m_truthJetContainerName + " " + m_trigJetContainerName + " " + m_fatJetContainerName + " "
+                       + m_truthFatJetContainerName + " " + m_tauContainerName + " " + m_METContainerName + " " + m_METReferenceContainerName + " "
+                       + m_photonContainerName + " " + m_clusterContainerName + " " + m_truthParticlesContainerName + " " + m_trackParticlesContainerName + " "
+                       + m_l1JetContainerName;
+  if ( m_retrievePV ) inputs += " " + m_vertexContainerName;
+
+  // what the detail strings read through the element links of the objects (one jet detail string per container, separated by |)
+  std::string jetDetails = m_jetDetailStr + " " + m_trigJetDetailStr + " " + m_truthJetDetailStr + " " + m_fatJetDetailStr + " " + m_truthFatJetDetailStr;
+  std::replace( jetDetails.begin(), jetDetails.end(), '|', ' ' );
+  inputs += HelperClasses::EventInfoSwitch(m_evtDetailStr).inputs();
+  inputs += HelperClasses::TriggerInfoSwitch(m_trigDetailStr).inputs();
+  inputs += HelperClasses::JetInfoSwitch(jetDetails).inputs();
+  inputs += HelperClasses::MuonInfoSwitch(m_muDetailStr).inputs();
+  inputs += HelperClasses::ElectronInfoSwitch(m_elDetailStr).inputs();
+  inputs += HelperClasses::TauInfoSwitch(m_tauDetailStr).inputs();
+  return inputs;
+}
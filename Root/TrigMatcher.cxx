@@ -168,3 +168,8 @@ EL::StatusCode TrigMatcher :: executeMatching ( const xAOD::IParticleContainer*
 
   return EL::StatusCode::SUCCESS;
 }
+
+std::string TrigMatcher :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName + HelperClasses::TriggerInfoSwitch("basic").inputs();
+}
@@ -103,10 +103,11 @@ EL::StatusCode TruthSelector :: initialize ()
     //
     m_truth_cutflowHist_1 = (TH1D*)file->Get("cutflow_truths_1");
 
-    m_truth_cutflow_all             = m_truth_cutflowHist_1->GetXaxis()->FindBin("all");
-    m_truth_cutflow_ptmax_cut       = m_truth_cutflowHist_1->GetXaxis()->FindBin("ptmax_cut");
-    m_truth_cutflow_ptmin_cut       = m_truth_cutflowHist_1->GetXaxis()->FindBin("ptmin_cut");
-    m_truth_cutflow_eta_cut         = m_truth_cutflowHist_1->GetXaxis()->FindBin("eta_cut");
+    m_truth_cutflow.setHist( m_truth_cutflowHist_1 );
+    m_truth_cutflow.bookBin( TruthCut::all,   "all" );
+    m_truth_cutflow.bookBin( TruthCut::ptmax, "ptmax_cut" );
+    m_truth_cutflow.bookBin( TruthCut::ptmin, "ptmin_cut" );
+    m_truth_cutflow.bookBin( TruthCut::eta,   "eta_cut" );
 
   }
 
@@ -270,6 +271,7 @@ EL::StatusCode TruthSelector :: finalize ()
     ANA_MSG_INFO( "Filling cutflow");
     m_cutflowHist ->SetBinContent( m_cutflow_bin, m_numEventPass        );
     m_cutflowHistW->SetBinContent( m_cutflow_bin, m_weightNumEventPass  );
+    m_truth_cutflow.flush();
   }
 
   return EL::StatusCode::SUCCESS;
@@ -287,18 +289,18 @@ EL::StatusCode TruthSelector :: histFinalize ()
 int TruthSelector :: PassCuts( const xAOD::TruthParticle* truthPart ) {
 
   // fill cutflow bin 'all' before any cut
-  if(m_useCutFlow) m_truth_cutflowHist_1->Fill( m_truth_cutflow_all, 1 );
+  if ( m_useCutFlow ) m_truth_cutflow.count( TruthCut::all );
 
   // pT
   if ( m_pT_max != 1e8 ) {
     if ( truthPart->pt() > m_pT_max ) { return 0; }
   }
-  if(m_useCutFlow) m_truth_cutflowHist_1->Fill( m_truth_cutflow_ptmax_cut, 1 );
+  if ( m_useCutFlow ) m_truth_cutflow.count( TruthCut::ptmax );
 
   if ( m_pT_min != 1e8 ) {
     if ( truthPart->pt() < m_pT_min ) { return 0; }
   }
-  if(m_useCutFlow) m_truth_cutflowHist_1->Fill( m_truth_cutflow_ptmin_cut, 1 );
+  if ( m_useCutFlow ) m_truth_cutflow.count( TruthCut::ptmin );
 
   // eta
   if ( m_eta_max != 1e8 ) {
@@ -307,7 +309,7 @@ int TruthSelector :: PassCuts( const xAOD::TruthParticle* truthPart ) {
   if ( m_eta_min != 1e8 ) {
     if ( fabs(truthPart->eta()) < m_eta_min ) { return 0; }
   }
-  if(m_useCutFlow) m_truth_cutflowHist_1->Fill( m_truth_cutflow_eta_cut, 1 );
+  if ( m_useCutFlow ) m_truth_cutflow.count( TruthCut::eta );
 
   // mass
   if ( m_mass_max != 1e8 ) {
@@ -329,4 +331,7 @@ int TruthSelector :: PassCuts( const xAOD::TruthParticle* truthPart ) {
   return 1;
 }
 
-
+std::string TruthSelector :: declaredInputs () const
+{
+  return m_inContainerName + " " + m_eventInfoContainerName;
+}
@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-,
+from __future__ import absolute_import
+from __future__ import print_function
+import logging
+logger = logging.getLogger("xAH.inputs")
+
+def _first_file(sh):
+  for sample in sh:
+    for fname in sample.makeFileList():
+      return str(fname)
+  return None
+
+def branch_sizes(fname, tree_name, declared_inputs):
+  """The compressed size of every top-level branch of the tree `tree_name` in `fname`, split by whether the containers in
+  `declared_inputs` (in the format of xAH::Algorithm::declaredInputs) include it. Returns ({branch: bytes} kept, {branch: bytes} not read)."""
+  import ROOT
+  f = ROOT.TFile.Open(fname)
+  if not f or f.IsZombie():
+    raise IOError("Could not open {0:s}".format(fname))
+  tree = f.Get(tree_name)
+  if not tree:
+    raise IOError("No tree {0:s} in {1:s}".format(tree_name, fname))
+
+  # the matching is the one InputCache does in the job
+  inputCache = ROOT.InputCache()
+  inputCache.m_declaredInputs = ' '.join(declared_inputs)
+  undeclared = set(str(b) for b in inputCache.undeclaredBranches(tree))
+
+  kept, pruned = {}, {}
+  for branch in tree.GetListOfBranches():
+    name = branch.GetName()
+    (pruned if name in undeclared else kept)[name] = branch.GetZipBytes("*")
+  f.Close()
+  return kept, pruned
+
+def report(declared_inputs, all_inputs, sh, tree_name, num_largest=20):
+  """Print what each algorithm declares to read (a list of (algorithm name, [inputs])), and what --pruneInputs would not read
+  from the first input file of the SampleHandler `sh`."""
+  logger.info("Input containers declared by the algorithms:")
+  width = max([len(name) for name, _ in declared_inputs] + [0])
+  for name, inputs in declared_inputs:
+    logger.info("  {0:{1}s}  {2:s}".format(name, width, "(not declared, may read anything)" if '*' in inputs else ' '.join(inputs)))
+
+  undeclared_algs = [name for name, inputs in declared_inputs if '*' in inputs]
+  if undeclared_algs:
+    logger.warning("--pruneInputs would do nothing: %s may read any container", ', '.join(undeclared_algs))
+    return
+
+  fname = _first_file(sh)
+  if fname is None:
+    logger.warning("No input file to estimate the size of the branches from")
+    return
+  kept, pruned = branch_sizes(fname, tree_name, sorted(all_inputs))
+  total = sum(kept.values()) + sum(pruned.values())
+  logger.info("In %s, --pruneInputs would read %d of the %d branches and skip %.1f MB of the %.1f MB compressed (%.1f%%)",
+              fname, len(kept), len(kept) + len(pruned), sum(pruned.values())/1e6, total/1e6, 100.*sum(pruned.values())/max(total, 1))
+  logger.info("Largest branches not read:")
+  for name, size in sorted(pruned.items(), key=lambda b: b[1], reverse=True)[:num_largest]:
+    logger.info("  %10.2f MB  %s", size/1e6, name)
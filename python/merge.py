@@ -0,0 +1,224 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-,
+from __future__ import absolute_import
+from __future__ import print_function
+import logging
+logger = logging.getLogger("xAH.merge")
+
+import multiprocessing
+import os
+import shutil
+import tempfile
+
+# histograms holding event counts and sums of weights, checked after merging
+_count_hist_prefixes = ('MetaData_EventCount', 'cutflow')
+
+def _scan_directory(directory, prefix=''):
+  """Returns (size in memory of the largest non-tree object, total uncompressed size of the trees, count histograms) of a directory."""
+  import ROOT
+  max_object, trees, counts = 0, 0, {}
+  for key in directory.GetListOfKeys():
+    # only the highest cycle of each key is merged
+    if directory.GetKey(key.GetName()).GetCycle() != key.GetCycle(): continue
+    name = prefix + key.GetName()
+    cls = ROOT.TClass.GetClass(key.GetClassName())
+    if not cls: continue
+    if cls.InheritsFrom(ROOT.TDirectory.Class()):
+      sub_max, sub_trees, sub_counts = _scan_directory(key.ReadObj(), name + '/')
+      max_object = max(max_object, sub_max)
+      trees += sub_trees
+      counts.update(sub_counts)
+    elif cls.InheritsFrom(ROOT.TTree.Class()):
+      trees += key.GetObjlen()
+    else:
+      max_object = max(max_object, key.GetObjlen())
+      if cls.InheritsFrom(ROOT.TH1.Class()) and key.GetName().startswith(_count_hist_prefixes):
+        counts[name] = _bin_contents(key.ReadObj())
+  return max_object, trees, counts
+
+def _bin_contents(hist):
+  """Contents of a 1D histogram, keyed by bin label when the bins are labelled (so that cutflows merged by label compare right)."""
+  axis = hist.GetXaxis()
+  contents = {}
+  for i in range(1, hist.GetNbinsX()+1):
+    label = axis.GetBinLabel(i) or str(i)
+    contents[label] = contents.get(label, 0.) + hist.GetBinContent(i)
+  return contents
+
+def scan(fname):
+  """Returns a dict with the size on disk, the memory needed to merge the file and its count histograms, or None if it can not be read."""
+  import ROOT
+  f = ROOT.TFile.Open(fname)
+  if not f or f.IsZombie() or f.TestBit(ROOT.TFile.kRecovered):
+    return None
+  max_object, trees, counts = _scan_directory(f)
+  info = {'name': fname, 'size': f.GetSize(), 'max_object': max_object, 'trees': trees, 'counts': counts, 'compress': f.GetCompressionSettings()}
+  f.Close()
+  return info
+
+def _scan_star(fname):
+  return (fname, scan(fname))
+
+def _merge_group(args):
+  """Merge `inputs` into `output` with TFileMerger. Trees are fast-cloned (baskets copied without decompression) when possible."""
+  output, inputs, compress = args
+  import ROOT
+  ROOT.gErrorIgnoreLevel = ROOT.kWarning
+  merger = ROOT.TFileMerger(False, False)
+  merger.SetPrintLevel(0)
+  merger.SetFastMethod(True)
+  merger.SetMaxOpenedFiles(len(inputs)+1)
+  if not merger.OutputFile(output, "RECREATE", compress):
+    return (output, False)
+  for fname in inputs:
+    if not merger.AddFile(fname, False):
+      return (output, False)
+  return (output, bool(merger.Merge()))
+
+def plan(infos, memory_limit_mb, fanin=None):
+  """Returns (fan-in, number of parallel merges) fitting in `memory_limit_mb` for the scanned files `infos`.
+
+  Merging k files holds k copies of the largest histogram in memory, plus a tree basket buffer per file.
+  """
+  per_file = max(info['max_object'] for info in infos) + 2*1024*1024
+  limit = memory_limit_mb*1024*1024
+  max_fanin = max(2, int(limit / per_file))
+  fanin = min(fanin or 64, max_fanin)
+  parallel = max(1, int(limit / (fanin*per_file)))
+  return fanin, parallel
+
+def check_counts(infos, outputs):
+  """Compare the count histograms summed over the merged `outputs` to the sum of those of the inputs, returns False on any mismatch."""
+  expected = {}
+  for info in infos:
+    for name, contents in info['counts'].items():
+      summed = expected.setdefault(name, {})
+      for label, value in contents.items():
+        summed[label] = summed.get(label, 0.) + value
+
+  merged = {}
+  for output in outputs:
+    info = scan(output)
+    if info is None:
+      logger.error("could not read back %s", output)
+      return False
+    for name, contents in info['counts'].items():
+      summed = merged.setdefault(name, {})
+      for label, value in contents.items():
+        summed[label] = summed.get(label, 0.) + value
+
+  ok = True
+  for name, contents in sorted(expected.items()):
+    merged_contents = merged.get(name)
+    if merged_contents is None:
+      logger.error("%s is missing from the merged output", name)
+      ok = False
+      continue
+    for label, value in contents.items():
+      if abs(merged_contents.get(label, 0.) - value) > 1e-6*max(1., abs(value)):
+        logger.error("%s[%s] = %g after merging, but the inputs sum up to %g", name, label, merged_contents.get(label, 0.), value)
+        ok = False
+  for name in sorted(n for n in expected if n.startswith('MetaData_EventCount') and n in merged):
+    contents = merged[name]
+    logger.info("%s: %s", name, ", ".join("{0}={1:g}".format(label, contents[label]) for label in sorted(contents)))
+  return ok
+
+def merge(output, inputs, nprocesses=None, memory_limit_mb=2000, fanin=None, max_size_gb=-1, skip_bad=False):
+  """Merge the ROOT files `inputs` into `output` in a parallel reduction tree.
+
+  The inputs are merged in groups of `fanin` files, `nprocesses` groups at a time (fewer if they would not fit in `memory_limit_mb`),
+  then the outputs of the groups are merged again until one file is left. With `max_size_gb` > 0 the reduction stops before an output
+  would get larger than that, and `output.0.root`, `output.1.root`, ... are written instead.
+
+  The count histograms (``MetaData_EventCount*`` and ``cutflow*``) of the inputs are summed up and compared to the merged ones, so that
+  a wrong sum of weights never goes unnoticed. Returns the list of files written.
+  """
+  nprocesses = nprocesses or multiprocessing.cpu_count()
+  if output.endswith('.root'): output = output[:-5]
+
+  pool = multiprocessing.Pool(max(1, min(nprocesses, len(inputs))))
+  try:
+    scanned = pool.map(_scan_star, inputs)
+    bad = [fname for fname, info in scanned if info is None]
+    if bad:
+      if not skip_bad:
+        raise IOError("Could not read {0:d} input file(s): {1}".format(len(bad), ", ".join(bad)))
+      logger.warning("skipping %d unreadable input file(s): %s", len(bad), ", ".join(bad))
+    infos = [info for _, info in scanned if info is not None]
+    if not infos:
+      raise IOError("No input file to merge into {0:s}".format(output))
+
+    fanin, parallel = plan(infos, memory_limit_mb, fanin)
+    parallel = min(parallel, nprocesses)
+    compress = infos[0]['compress']
+    logger.info("merging %d files into %s: %d files per merge, %d merges in parallel", len(infos), output, fanin, parallel)
+
+    max_size = max_size_gb*1e9 if max_size_gb > 0 else float('inf')
+    workdir = tempfile.mkdtemp(prefix='xAH_merge_', dir=os.path.dirname(os.path.abspath(output)))
+    # (file, size on disk, is it a temporary file)
+    level = [(info['name'], info['size'], False) for info in sorted(infos, key=lambda i: i['name'])]
+    final = []
+    step = 0
+    while level:
+      groups, group, group_size = [], [], 0
+      for fname, size, temporary in level:
+        if size >= max_size:
+          final.append((fname, size, temporary))
+          continue
+        if group and (len(group) == fanin or group_size + size >= max_size):
+          groups.append(group)
+          group, group_size = [], 0
+        group.append((fname, size, temporary))
+        group_size += size
+      if group: groups.append(group)
+
+      # a level where nothing can be combined any more is final
+      if all(len(g) == 1 for g in groups):
+        final.extend(g[0] for g in groups)
+        break
+
+      jobs = []
+      next_level = []
+      for i, g in enumerate(groups):
+        if len(g) == 1:
+          next_level.append(g[0])
+          continue
+        out = os.path.join(workdir, 'step{0:d}_{1:d}.root'.format(step, i))
+        jobs.append((out, [fname for fname, _, _ in g], compress))
+
+      merge_pool = multiprocessing.Pool(max(1, min(parallel, len(jobs))))
+      try:
+        results = merge_pool.map(_merge_group, jobs)
+      finally:
+        merge_pool.close()
+        merge_pool.join()
+      failed = [out for out, ok in results if not ok]
+      if failed:
+        raise RuntimeError("TFileMerger failed for {0}".format(", ".join(failed)))
+
+      for out, inputs_of_group, _ in jobs:
+        next_level.append((out, os.path.getsize(out), True))
+      # the temporary files of the previous level are not needed any more
+      for g in groups:
+        if len(g) == 1: continue
+        for fname, _, temporary in g:
+          if temporary: os.remove(fname)
+      level = next_level
+      step += 1
+
+    written = []
+    final.sort(key=lambda f: f[0])
+    for i, (fname, _, temporary) in enumerate(final):
+      target = output + '.root' if len(final) == 1 else '{0:s}.{1:d}.root'.format(output, i)
+      if temporary: shutil.move(fname, target)
+      else: shutil.copy(fname, target)
+      written.append(target)
+    shutil.rmtree(workdir, True)
+
+    if not check_counts(infos, written):
+      raise RuntimeError("The event counts of {0:s} do not match those of its inputs".format(", ".join(written)))
+
+    return written
+  finally:
+    pool.close()
+    pool.join()
@@ -0,0 +1,223 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-,
+from __future__ import absolute_import
+from __future__ import print_function
+import logging
+logger = logging.getLogger("xAH.multicore")
+
+import multiprocessing
+import os
+import shutil
+import subprocess
+import sys
+
+try:
+  import Queue as queue  # python 2
+except ImportError:
+  import queue
+
+def _file_size(fname):
+  try:
+    return os.path.getsize(fname)
+  except OSError:
+    # remote files count the same, so that they get spread evenly
+    return 1
+
+def _events_per_file(sample, fnames):
+  """The number of events of each file, if the sample was scanned (see :mod:`xAODAnaHelpers.scan`), or None."""
+  import ROOT
+  per_file = sample.meta().get(ROOT.SH.MetaFields.numEventsPerFile)
+  try:
+    entries = list(per_file.value) if per_file else None
+  except AttributeError:
+    return None
+  return entries if entries is not None and len(entries) == len(fnames) else None
+
+def make_chunks(sh, nchunks):
+  """Split the files of every sample of the SampleHandler `sh` into at most `nchunks` chunks of similar total size.
+
+  The size of a file is its number of events when the samples were scanned, and its size on disk otherwise.
+  Files are assigned largest first to the currently smallest chunk of their sample. Returns a list of (sample, [files], size)
+  sorted by decreasing size, which is the order the workers take them in.
+  """
+  chunks = []
+  samples = list(sh)
+  total_size = 0
+  sample_files = []
+  for sample in samples:
+    fnames = [str(f) for f in sample.makeFileList()]
+    sizes = _events_per_file(sample, fnames) or [_file_size(f) for f in fnames]
+    files = sorted(zip(sizes, fnames), reverse=True)
+    sample_files.append(files)
+    total_size += sum(size for size, _ in files)
+
+  for sample, files in zip(samples, sample_files):
+    if not files: continue
+    sample_size = sum(size for size, _ in files)
+    # share the chunks between the samples according to their size
+    n = max(1, min(len(files), int(round(float(nchunks)*sample_size/max(total_size, 1)))))
+    bins = [[0, []] for _ in range(n)]
+    for size, fname in files:
+      smallest = min(bins, key=lambda b: b[0])
+      smallest[0] += size
+      smallest[1].append(fname)
+    chunks.extend((sample, sorted(fnames), size) for size, fnames in bins if fnames)
+
+  return sorted(chunks, key=lambda c: c[2], reverse=True)
+
+def _chunk_meta(chunk_sample, sample, fnames):
+  """Copy the metadata of `sample` to `chunk_sample`, which only has the files `fnames` of it: the event counts are recomputed
+  for these files when the sample was scanned, and dropped otherwise."""
+  import ROOT
+  chunk_sample.meta().fetch(sample.meta())
+  chunk_sample.meta().remove(ROOT.SH.MetaFields.numEventsPerFile)
+  sample_fnames = [str(f) for f in sample.makeFileList()]
+  entries = _events_per_file(sample, sample_fnames)
+  if entries is None:
+    chunk_sample.meta().remove(ROOT.SH.MetaFields.numEvents)
+  else:
+    entries = dict(zip(sample_fnames, entries))
+    chunk_sample.meta().setDouble(ROOT.SH.MetaFields.numEvents, float(sum(entries[fname] for fname in fnames)))
+
+def _chunk_dir(submit_dir, index):
+  return os.path.join(submit_dir, 'multicore', 'chunk_{0:04d}'.format(index))
+
+def _run_worker(worker_id, job, submit_dir, chunks, work_queue, results):
+  import ROOT
+  # keep the output of each worker apart
+  log_file = os.path.join(submit_dir, 'multicore', 'worker_{0:d}.log'.format(worker_id))
+  fd = os.open(log_file, os.O_WRONLY|os.O_CREAT|os.O_TRUNC, 0o644)
+  sys.stdout.flush(); sys.stderr.flush()
+  os.dup2(fd, 1); os.dup2(fd, 2)
+
+  while True:
+    # one None per worker is queued after the chunks
+    index = work_queue.get()
+    if index is None:
+      break
+
+    sample, fnames, _ = chunks[index]
+    chunk_sample = ROOT.SH.SampleLocal(sample.name())
+    ROOT.SetOwnership(chunk_sample, False)  # owned by the SampleHandler
+    for fname in fnames:
+      chunk_sample.add(fname)
+    _chunk_meta(chunk_sample, sample, fnames)
+    sh_chunk = ROOT.SH.SampleHandler()
+    sh_chunk.add(chunk_sample)
+
+    # the job and everything set up so far is this process' copy of the parent's
+    job.sampleHandler(sh_chunk)
+    try:
+      ROOT.EL.DirectDriver().submit(job, _chunk_dir(submit_dir, index))
+      results.put((index, worker_id, True))
+    except Exception:
+      logger.exception("chunk {0:d} failed".format(index))
+      results.put((index, worker_id, False))
+
+def _merge(args):
+  output, inputs = args
+  if not os.path.isdir(os.path.dirname(output)):
+    os.makedirs(os.path.dirname(output))
+  if len(inputs) == 1:
+    shutil.copy(inputs[0], output)
+    return (output, 0)
+
+  import ROOT
+  f = ROOT.TFile.Open(inputs[0])
+  is_xAOD = bool(f and f.Get("CollectionTree"))
+  if f: f.Close()
+
+  # xAOD outputs need their metadata merged properly, histograms, cutflows and ntuples are fine with hadd
+  command = (['xAODMerge', output] if is_xAOD else ['hadd', '-f', output]) + inputs
+  with open(os.devnull, 'w') as devnull:
+    return (output, subprocess.call(command, stdout=devnull, stderr=subprocess.STDOUT))
+
+def merge_outputs(submit_dir, nchunks, nprocesses):
+  """Merge the outputs of all the chunks into submit_dir: the hist-<sample>.root files and the data-<stream> directories, under
+  the same names as a single EventLoop job. The EventLoop job metadata of the chunks is not merged, so submit_dir cannot be read
+  back with EL::Driver::retrieve."""
+  to_merge = {}
+  for index in range(nchunks):
+    chunk_dir = _chunk_dir(submit_dir, index)
+    for dirpath, dirnames, filenames in os.walk(chunk_dir):
+      relpath = os.path.relpath(dirpath, chunk_dir)
+      # only the outputs: the histogram files and the data-<stream> directories
+      if relpath != '.' and not relpath.startswith('data-'): continue
+      for fname in filenames:
+        if not fname.endswith('.root'): continue
+        if relpath == '.' and not fname.startswith('hist-'): continue
+        output = os.path.normpath(os.path.join(submit_dir, relpath, fname))
+        to_merge.setdefault(output, []).append(os.path.join(dirpath, fname))
+
+  logger.info("merging %d output files from %d chunks", len(to_merge), nchunks)
+  pool = multiprocessing.Pool(max(1, min(nprocesses, len(to_merge))))
+  try:
+    statuses = pool.map(_merge, sorted(to_merge.items()))
+  finally:
+    pool.close()
+    pool.join()
+
+  failed = [output for output, status in statuses if status != 0]
+  for output in failed:
+    logger.error("could not merge %s", output)
+  return not failed
+
+def submit(job, submit_dir, nworkers=None, chunks_per_worker=1, keep_chunks=False):
+  """Run the EventLoop `job` on all the cores of this machine.
+
+  Everything set up by the caller (dictionaries, configuration, sample scanning and metadata) is done once, then `nworkers`
+  processes are forked and share it. The input files are split in about `chunks_per_worker` chunks per worker, and each worker
+  takes the next chunk from a common queue when it is done with the previous one. Each chunk is run with the DirectDriver in
+  its own directory, which runs the initialization of all the algorithms (and of their CP tools) again: more than one chunk per
+  worker only pays off when the input files have very different sizes. The outputs of all the chunks are merged into
+  `submit_dir` at the end (see :func:`merge_outputs`).
+
+  The job options that count events (maximum and skipped events) would apply to each chunk separately, they are rejected.
+  """
+  nworkers = nworkers or multiprocessing.cpu_count()
+
+  import ROOT
+  for opt in [ROOT.EL.Job.optMaxEvents, ROOT.EL.Job.optSkipEvents]:
+    if job.options().castDouble(opt, 0) > 0:
+      raise ValueError("The option {0:s} cannot be used with the multicore driver".format(str(opt)))
+
+  chunks = make_chunks(job.sampleHandler(), nworkers*max(1, chunks_per_worker))
+  if not chunks:
+    raise ValueError("No input files to run on.")
+  nworkers = min(nworkers, len(chunks))
+  logger.info("running %d chunks on %d workers", len(chunks), nworkers)
+
+  os.makedirs(os.path.join(submit_dir, 'multicore'))
+
+  work_queue = multiprocessing.Queue()
+  for index in range(len(chunks)):
+    work_queue.put(index)
+  for _ in range(nworkers):
+    work_queue.put(None)
+  results = multiprocessing.Queue()
+
+  workers = [multiprocessing.Process(target=_run_worker, args=(i, job, submit_dir, chunks, work_queue, results)) for i in range(nworkers)]
+  for worker in workers: worker.start()
+
+  done = {}
+  while len(done) < len(chunks):
+    try:
+      index, worker_id, success = results.get(timeout=10)
+    except queue.Empty:
+      if not any(worker.is_alive() for worker in workers): break
+      continue
+    done[index] = success
+    logger.info("chunk %d/%d (%s, %d files) %s on worker %d", len(done), len(chunks), chunks[index][0].name(), len(chunks[index][1]), "done" if success else "FAILED", worker_id)
+
+  for worker in workers: worker.join()
+
+  failed = [index for index in range(len(chunks)) if not done.get(index, False)]
+  if failed:
+    raise RuntimeError("{0:d} chunk(s) failed, see the logs in {1:s}: {2}".format(len(failed), os.path.join(submit_dir, 'multicore'), failed))
+
+  if not merge_outputs(submit_dir, len(chunks), nworkers):
+    raise RuntimeError("Could not merge the outputs, the chunks are kept in {0:s}".format(os.path.join(submit_dir, 'multicore')))
+
+  if not keep_chunks:
+    for index in range(len(chunks)):
+      shutil.rmtree(_chunk_dir(submit_dir, index), True)
@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-,
+from __future__ import absolute_import
+from __future__ import print_function
+import logging
+logger = logging.getLogger("xAH.pick")
+
+import os
+
+def read_pick_list(fname):
+  """Read the (run number, event number) pairs of a text file, one per line as ``run event`` or ``run:event``. Lines starting with # are ignored."""
+  pairs = []
+  with open(fname) as f:
+    for line in f:
+      line = line.split('#')[0].replace(':', ' ').replace(',', ' ').split()
+      if not line: continue
+      if len(line) != 2:
+        raise ValueError("Expected 'runNumber eventNumber', got {0:s} in {1:s}".format(' '.join(line), fname))
+      pairs.append((int(line[0]), int(line[1])))
+  return pairs
+
+def lookup(index_files, pairs):
+  """Find the input file and entry of each (run number, event number) in the event indices written by BasicEventSelection.
+
+  Returns ({file name: sorted list of entries}, [pairs that are not in the indices]).
+  """
+  import ROOT
+  index = ROOT.TChain("eventIndex")
+  files = ROOT.TChain("eventIndexFiles")
+  for fname in index_files:
+    index.Add(fname)
+    files.Add(fname)
+  if index.GetEntries() == 0:
+    raise IOError("No event index found in {0}".format(", ".join(index_files)))
+
+  file_names = {}
+  for entry in files:
+    file_names[int(entry.fileId)] = str(entry.fileName)
+
+  # a binary search in the sorted (runNumber, eventNumber) index
+  index.BuildIndex("runNumber", "eventNumber")
+  picked, missing = {}, []
+  for run, event in pairs:
+    i = index.GetEntryNumberWithIndex(run, event)
+    if i < 0:
+      missing.append((run, event))
+      continue
+    index.GetEntry(i)
+    picked.setdefault(file_names[int(index.fileId)], set()).add(int(index.entry))
+
+  logger.info("found %d of the %d events to pick in %d files", len(pairs)-len(missing), len(pairs), len(picked))
+  for run, event in missing:
+    logger.warning("run %d, event %d is not in the event index", run, event)
+  return dict((fname, sorted(entries)) for fname, entries in picked.items()), missing
+
+def entries_option(picked):
+  """The EventPicker::m_entries option for `picked`."""
+  return ' '.join('{0:s}|{1:s}'.format(fname, ','.join(str(entry) for entry in entries)) for fname, entries in sorted(picked.items()))
+
+def _normalize(fname):
+  if fname.startswith('file://'): fname = fname[len('file://'):]
+  return os.path.realpath(fname) if '://' not in fname else fname
+
+def restrict_samples(sh, picked):
+  """A SampleHandler with the samples of `sh` reduced to the files that have events to pick. Files are matched by path, or by base name."""
+  import ROOT
+  paths = set(_normalize(fname) for fname in picked)
+  basenames = set(os.path.basename(fname) for fname in picked)
+  sh_picked = ROOT.SH.SampleHandler()
+  for sample in sh:
+    fnames = [str(f) for f in sample.makeFileList()]
+    keep = [f for f in fnames if _normalize(f) in paths] or [f for f in fnames if os.path.basename(f) in basenames]
+    if not keep: continue
+    sample_picked = ROOT.SH.SampleLocal(sample.name())
+    ROOT.SetOwnership(sample_picked, False)  # owned by the SampleHandler
+    for fname in keep:
+      sample_picked.add(fname)
+    sample_picked.meta().fetch(sample.meta())
+    sh_picked.add(sample_picked)
+    logger.info("\t%s: %d of %d files", sample.name(), len(keep), len(fnames))
+  return sh_picked
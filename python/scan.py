@@ -0,0 +1,209 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-,
+from __future__ import absolute_import
+from __future__ import print_function
+import logging
+logger = logging.getLogger("xAH.scan")
+
+import json
+import os
+import threading
+from multiprocessing.pool import ThreadPool
+
+# bump when the content of an entry changes, so that old caches are ignored
+_cache_version = 1
+default_cache = os.path.join(os.path.expanduser('~'), '.xAH_scan_cache.json')
+
+def _is_local(fname):
+  return '://' not in fname or fname.startswith('file://')
+
+def _local_path(fname):
+  return os.path.abspath(fname[len('file://'):] if fname.startswith('file://') else fname)
+
+class ScanCache(object):
+  """Results of :func:`scan_file` for local files, keyed by path and valid as long as the size and the modification time of the file do not change."""
+  def __init__(self, path=None):
+    self.path = path
+    self._entries = {}
+    self._lock = threading.Lock()
+    self._dirty = False
+    if path and os.path.isfile(path):
+      try:
+        with open(path) as f:
+          content = json.load(f)
+        if content.get('version') == _cache_version:
+          self._entries = content.get('files', {})
+      except ValueError:
+        logger.warning("ignoring the corrupted scan cache %s", path)
+
+  @staticmethod
+  def _stamp(fname):
+    if not _is_local(fname): return None
+    try:
+      st = os.stat(_local_path(fname))
+    except OSError:
+      return None
+    return [st.st_size, int(st.st_mtime)]
+
+  def get(self, fname, tree_name):
+    stamp = self._stamp(fname)
+    if stamp is None: return None
+    with self._lock:
+      entry = self._entries.get(_local_path(fname))
+    if entry is None or entry['stamp'] != stamp or entry['tree'] != tree_name: return None
+    return entry['info']
+
+  def put(self, fname, tree_name, info):
+    stamp = self._stamp(fname)
+    if stamp is None: return
+    with self._lock:
+      self._entries[_local_path(fname)] = {'stamp': stamp, 'tree': tree_name, 'info': info}
+      self._dirty = True
+
+  def save(self):
+    if not self.path or not self._dirty: return
+    tmp = '{0:s}.{1:d}'.format(self.path, os.getpid())
+    with open(tmp, 'w') as f:
+      json.dump({'version': _cache_version, 'files': self._entries}, f)
+    # atomic, so that concurrent jobs never read a partial cache
+    os.rename(tmp, self.path)
+    self._dirty = False
+
+def _release_gil(ROOT):
+  """Let the other threads run while ROOT is busy opening and reading a file (``_threaded`` in the old PyROOT, ``__release_gil__``
+  in cppyy). Returns False if this version of PyROOT supports neither, in which case the threads would only take turns."""
+  released = True
+  for method in (ROOT.TFile.Open, ROOT.TTree.GetEntry):
+    method_released = False
+    for attr in ('_threaded', '__release_gil__'):
+      # only a property of the method proxy does something: setattr would also add a plain attribute to any other object
+      if not hasattr(method, attr): continue
+      try:
+        setattr(method, attr, True)
+      except (AttributeError, TypeError):
+        continue
+      method_released = method_released or bool(getattr(method, attr))
+    released = released and method_released
+  return released
+
+# the transient trees are kept in a global registry, only one thread at a time may use them
+_transient_lock = threading.Lock()
+
+def _sum_of_weights(ROOT, f):
+  """(number of events, sum of weights, sum of squared weights) of the AllExecutedEvents CutBookkeeper with the highest cycle, or None."""
+  meta_tree = f.Get('MetaData')
+  if not meta_tree: return None
+  with _transient_lock:
+    try:
+      return _read_cutbookkeepers(ROOT, meta_tree)
+    finally:
+      ROOT.xAOD.ClearTransientTrees()
+
+def _read_cutbookkeepers(ROOT, meta_tree):
+  event = ROOT.xAOD.TEvent(ROOT.xAOD.TEvent.kClassAccess)
+  transient = ROOT.xAOD.MakeTransientMetaTree(event, meta_tree)
+  if not transient or transient.GetEntry(0) <= 0: return None
+  try:
+    cbks = transient.CutBookkeepers
+  except AttributeError:
+    return None
+  best, max_cycle = None, -1
+  for cbk in cbks:
+    if cbk.name() == 'AllExecutedEvents' and cbk.inputStream() == 'StreamAOD' and cbk.cycle() > max_cycle:
+      best, max_cycle = cbk, cbk.cycle()
+  if best is None: return None
+  return (best.nAcceptedEvents(), best.sumOfEventWeights(), best.sumOfEventWeightsSquared())
+
+def scan_file(fname, tree_name='CollectionTree'):
+  """Returns {'entries': entries of `tree_name`, 'cbk': [events, sumw, sumw2] before any skimming or None}, or None if the file can not be read."""
+  import ROOT
+  f = ROOT.TFile.Open(fname)
+  if not f or f.IsZombie():
+    return None
+  tree = f.Get(tree_name)
+  # files without the tree (everything skimmed away) are fine and count as empty
+  info = {'entries': int(tree.GetEntries()) if tree else 0, 'cbk': None}
+  try:
+    cbk = _sum_of_weights(ROOT, f)
+    if cbk is not None: info['cbk'] = list(cbk)
+  except Exception:
+    logger.debug("could not read the CutBookkeepers of %s", fname, exc_info=True)
+  f.Close()
+  return info
+
+def scan_samples(sh, nthreads=8, cache_path=default_cache, tree_name='CollectionTree'):
+  """Fill the number of events of each local sample of the SampleHandler `sh`, like ``SH::scanNEvents`` does, opening `nthreads` files at a time.
+
+  Sets ``SH::MetaFields::numEvents`` and ``SH::MetaFields::numEventsPerFile`` (used by the batch drivers for ``--optEventsPerWorker`` and by
+  the multicore driver to balance its chunks). When the files have CutBookkeepers, the number of events and the sum of weights before
+  any skimming are saved in the ``xAH_initialNEvents``, ``xAH_initialSumW`` and ``xAH_initialSumW2`` metadata of the sample.
+  Samples that are not local (grid, rucio) are scanned with ``SH::scanNEvents``, one file at a time and without the cache.
+  """
+  import ROOT
+
+  cache = ScanCache(cache_path)
+  samples = []
+  for sample in sh:
+    if not isinstance(sample, ROOT.SH.SampleLocal):
+      logger.info("scanning %s with SH::scanNEvents", sample.name())
+      ROOT.SH.scanNEvents(sample)
+      continue
+    samples.append((sample, [str(fname) for fname in sample.makeFileList()]))
+
+  # remote files are never cached, they are scanned every time
+  results = {}
+  for _, fnames in samples:
+    for fname in fnames:
+      results[fname] = cache.get(fname, tree_name)
+  to_scan = sorted(fname for fname, info in results.items() if info is None)
+
+  nthreads = max(1, min(nthreads, len(to_scan)))
+  if nthreads > 1 and not _release_gil(ROOT):
+    logger.warning("this PyROOT cannot release the GIL while ROOT reads a file, scanning the files one at a time")
+    nthreads = 1
+  if nthreads > 1:
+    # ROOT stays in its thread-safe mode (global locks taken on every TFile/TTree/dictionary access) for the rest of the job,
+    # which slows the event loop down a little: only turned on when the files are really opened from several threads
+    ROOT.EnableThreadSafety()
+  logger.info("scanning %d files (%d already known) with %d threads", len(to_scan), len(results)-len(to_scan), nthreads)
+
+  failed = []
+  def _scan(fname):
+    info = scan_file(fname, tree_name)
+    if info is None:
+      failed.append(fname)
+      return
+    results[fname] = info
+    cache.put(fname, tree_name, info)
+
+  if to_scan:
+    if nthreads > 1:
+      pool = ThreadPool(nthreads)
+      try:
+        pool.map(_scan, to_scan, chunksize=1)
+      finally:
+        pool.close()
+        pool.join()
+    else:
+      for fname in to_scan: _scan(fname)
+  cache.save()
+
+  if failed:
+    raise IOError("Could not read {0:d} file(s): {1}".format(len(failed), ", ".join(sorted(failed))))
+
+  for sample, fnames in samples:
+    infos = [results[fname] for fname in fnames]
+    entries = ROOT.std.vector('Long64_t')()
+    for info in infos: entries.push_back(info['entries'])
+    meta = sample.meta()
+    meta.setDouble(ROOT.SH.MetaFields.numEvents, float(sum(info['entries'] for info in infos)))
+    per_file = ROOT.SH.MetaVector('Long64_t')(ROOT.SH.MetaFields.numEventsPerFile, entries)
+    ROOT.SetOwnership(per_file, False)  # owned by the MetaObject
+    meta.addReplace(per_file)
+
+    cbks = [info['cbk'] for info in infos]
+    if cbks and all(cbk is not None for cbk in cbks):
+      meta.setDouble('xAH_initialNEvents', float(sum(cbk[0] for cbk in cbks)))
+      meta.setDouble('xAH_initialSumW',    sum(cbk[1] for cbk in cbks))
+      meta.setDouble('xAH_initialSumW2',   sum(cbk[2] for cbk in cbks))
+    logger.info("\t%s: %d events in %d files", sample.name(), sum(info['entries'] for info in infos), len(fnames))
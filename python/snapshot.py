@@ -0,0 +1,169 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-,
+from __future__ import absolute_import
+from __future__ import print_function
+import logging
+logger = logging.getLogger("xAH.snapshot")
+
+import hashlib
+import json
+import os
+import shutil
+import socket
+
+# bump when the content of a snapshot changes, so that old snapshots are rebuilt
+_snapshot_version = 1
+
+# the options of xAH_run.py that do not change the samples or the configured algorithms
+_runtime_only_args = set(['snapshot', 'submit_dir', 'force_overwrite', 'log_level', 'num_events', 'skip_events', 'variable_stats',
+                          'timing', 'timing_json', 'memory', 'memory_interval', 'scan_threads', 'scan_cache', 'cache_size',
+                          'cache_learn_entries', 'cache_branches', 'pin_only', 'async_prefetch', 'prefetch_next_file', 'read_stats',
+                          'prune_inputs', 'keep_inputs', 'input_report'])
+
+def _file_stamp(path):
+  try:
+    st = os.stat(path)
+  except OSError:
+    return None
+  return [st.st_size, int(st.st_mtime)]
+
+def _content_hash(path):
+  with open(path, 'rb') as f:
+    return hashlib.sha1(f.read()).hexdigest()
+
+def make_key(args, metadata_dir=None):
+  """The hash a snapshot is valid for: the content of the config file and of the input file lists (and of the ``.config`` file
+  with their metadata next to each of them), the options of xAH_run.py
+  that change the job, the size and modification time of the local inputs (and of their directory, for new files) and of the
+  metadata files, and the release."""
+  parts = {'version': _snapshot_version}
+  parts['config'] = _content_hash(args.config)
+  parts['args'] = sorted((k, repr(v)) for k, v in vars(args).items() if k not in _runtime_only_args)
+
+  inputs = []
+  for fname in args.input_filename:
+    if args.use_inputFileList and os.path.isfile(fname):
+      inputs.append((fname, _content_hash(fname)))
+      # the metadata of the list, as xAH_run.py finds it
+      sname = '.'.join(os.path.basename(fname).split('.')[:-1])
+      fcname = os.path.dirname(fname)+'/'+sname+'.config'
+      if os.path.exists(fcname):
+        inputs.append((fcname, _content_hash(fcname)))
+    elif '://' not in fname:
+      inputs.append((fname, _file_stamp(fname), _file_stamp(os.path.dirname(os.path.abspath(fname)))))
+  parts['inputs'] = inputs
+
+  if metadata_dir and os.path.isdir(metadata_dir):
+    parts['metadata'] = sorted((f, _file_stamp(os.path.join(metadata_dir, f))) for f in os.listdir(metadata_dir))
+  parts['release'] = sorted((k, v) for k, v in os.environ.items() if k.startswith('Analysis') and k.endswith('_VERSION'))
+
+  return hashlib.sha1(json.dumps(parts, sort_keys=True).encode('utf-8')).hexdigest()
+
+def _job_file(path):
+  return os.path.join(path, 'job.root')
+
+def _samples_dir(path):
+  return os.path.join(path, 'samples')
+
+class Snapshot(object):
+  """What :func:`load` returns: the SampleHandler with all its metadata, and a :class:`xAODAnaHelpers.Config` with the configured algorithms."""
+  def __init__(self, samples, configurator):
+    self.samples = samples
+    self.configurator = configurator
+
+def load(path, key):
+  """The snapshot in the directory `path` if it was made for `key`, None otherwise."""
+  if not os.path.isfile(_job_file(path)): return None
+  import ROOT
+  f = ROOT.TFile.Open(_job_file(path))
+  if not f or f.IsZombie():
+    logger.warning("ignoring the unreadable snapshot %s", path)
+    return None
+  try:
+    stored_key = f.Get('key')
+    if not stored_key or str(stored_key.GetString()) != key:
+      logger.info("the snapshot %s is out of date, rebuilding it", path)
+      return None
+
+    content = json.loads(str(f.Get('config').GetString()))
+    from xAODAnaHelpers import Config
+    configurator = Config()
+    for name in content['algorithms']:
+      alg = f.Get(str(name))
+      if not alg:
+        logger.warning("the algorithm %s is missing from the snapshot %s, rebuilding it", name, path)
+        return None
+      configurator._algorithms.append(alg)
+    configurator._log = [tuple(entry) for entry in content['log']]
+    configurator._outputs = set(str(output) for output in content['outputs'])
+  finally:
+    f.Close()
+
+  samples = ROOT.SH.SampleHandler()
+  samples.load(_samples_dir(path))
+  return Snapshot(samples, configurator)
+
+def _stored_key(path):
+  """The key the snapshot in the directory `path` was made for, or None."""
+  import ROOT
+  if not os.path.isfile(_job_file(path)): return None
+  f = ROOT.TFile.Open(_job_file(path))
+  if not f or f.IsZombie(): return None
+  try:
+    stored_key = f.Get('key')
+    return str(stored_key.GetString()) if stored_key else None
+  finally:
+    f.Close()
+
+def save(path, key, samples, configurator):
+  """Write the SampleHandler `samples` (as set up for the job) and the algorithms of `configurator` to the directory `path`.
+  Only the algorithms deriving from EL::Algorithm can be written: if there are others, no snapshot is made.
+  A snapshot is only a shortcut for the next jobs: failing to write it is not an error, and False is returned."""
+  import ROOT
+  if not all(isinstance(alg, ROOT.TObject) for alg in configurator._algorithms):
+    logger.warning("not writing the snapshot %s: only EL::Algorithm can be saved", path)
+    return False
+
+  # written aside and renamed, so that a job running at the same time (on this machine or another one) never reads half a snapshot
+  tmp = '{0:s}.{1:s}.{2:d}'.format(os.path.normpath(path), socket.gethostname(), os.getpid())
+  old = tmp + '.old'
+  try:
+    shutil.rmtree(tmp, True)
+    os.makedirs(tmp)
+    samples.save(_samples_dir(tmp))
+
+    names = []
+    f = ROOT.TFile.Open(_job_file(tmp), 'RECREATE')
+    for index, alg in enumerate(configurator._algorithms):
+      names.append('alg_{0:03d}'.format(index))
+      f.WriteTObject(alg, names[-1])
+    content = {'algorithms': names, 'log': configurator._log, 'outputs': sorted(configurator._outputs)}
+    f.WriteTObject(ROOT.TObjString(json.dumps(content, default=str)), 'config')
+    f.WriteTObject(ROOT.TObjString(key), 'key')
+    f.Close()
+
+    if os.path.exists(path):
+      if _stored_key(path) == key:
+        # written by another job in the meantime
+        logger.info("the snapshot %s is already up to date", path)
+        return True
+      # the out of date snapshot is moved aside rather than deleted in place, a job may still be reading it
+      os.rename(path, old)
+      os.rename(tmp, path)
+    else:
+      try:
+        os.rename(tmp, path)
+      except OSError:
+        # another job got there first
+        if not os.path.isdir(path): raise
+        logger.info("the snapshot %s was written by another job", path)
+        return True
+  except Exception as e:
+    logger.warning("could not write the snapshot %s: %s", path, e)
+    return False
+  finally:
+    shutil.rmtree(tmp, True)
+    shutil.rmtree(old, True)
+
+  logger.info("wrote the snapshot %s", path)
+  return True
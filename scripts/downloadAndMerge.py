@@ -15,6 +15,9 @@
 #import
 import os, sys, subprocess, glob, shutil
 import argparse
+import logging
+logging.basicConfig(format='%(asctime)s %(name)s %(levelname)s %(message)s', level=logging.INFO)
+from xAODAnaHelpers.merge import merge
 parser = argparse.ArgumentParser(description="%prog [options]", formatter_class=argparse.ArgumentDefaultsHelpFormatter)
 parser.add_argument("--container", dest='container', default="None",
      help="Name of dataset to be downloaded, may include wildcards")
@@ -25,12 +28,16 @@ parser.add_argument("--types", dest='types', default="tree",
 parser.add_argument("--outPath", dest='outPath', default="./gridOutput/",
      help="Output path")
 parser.add_argument("--mergeRawDatasets", dest='mergeRawDatasets', default="True",
-     help="Merge raw datasets (hadd)")
+     help="Merge raw datasets (xAH_merge.py)")
 parser.add_argument("--doFax", dest='doFax', default=False, action="store_true", help="Use get-fax")
 parser.add_argument("--renameRawDatasets", dest='renameRawDatasets', default="False",
      help="Rename raw datasets")
-parser.add_argument("--maxSize", dest='maxSize', default=-1,
+parser.add_argument("--maxSize", dest='maxSize', default=-1, type=float,
      help="Attempted max size (in GB) of output files. Files larger than this will not be merged. -1 for no size limit ")
+parser.add_argument("--nProcesses", dest='nProcesses', default=None, type=int,
+     help="Number of merges run in parallel (default: number of cores)")
+parser.add_argument("--memoryLimit", dest='memoryLimit', default=2000, type=float,
+     help="Memory limit (in MB) for all the merges running at the same time")
 args = parser.parse_args()
 
 def main():
@@ -43,14 +50,6 @@ def main():
   mergeRawDatasets = args.mergeRawDatasets
   renameRawDatasets = args.renameRawDatasets
 
-  ##******************************************
-  # check that hadd exists
-  devnull = open(os.devnull)
-  try :
-    subprocess.call(["hadd"], stdout=devnull, stderr=devnull)
-  except OSError as e:
-    print "Error, hadd not available"
-    exit(1)
   #------------------------------------------
   #get current directory
   currentDir = os.getcwd()
@@ -161,52 +160,8 @@ def main():
       inputFilesName = glob.glob(inputFilesNameWildCard)
 
       if (mergeRawDatasets=="True") :
-        print '   hadding inputFilesName: %s'%inputFilesNameWildCard
-        if outputFileName.endswith('.root'):
-          outputFileName = outputFileName[:-5] #strip .root
-
-        if args.maxSize <= 0:
-          os.system('hadd '+outputFileName+'.root '+inputFilesNameWildCard)
-        else:
-          ## Get file sizes
-          fileSizes = []
-          for iFile,theFile in enumerate(inputFilesName) :
-            fileSizes.append( os.path.getsize(theFile)/1E9 ) #save as GB
-          ## Select combinations of files
-          filesToMerge = [ [] ]
-          fileSizesToMerge = [ [] ]
-          while len( inputFilesName ) > 0:
-            if len(fileSizesToMerge[-1])==0 or float(sum( fileSizesToMerge[-1] )+fileSizes[0]) < float(args.maxSize):
-              #If current list is empty or new size will be below threshold,
-              #Add to current merge list and stay on this list
-              filesToMerge[-1].append( inputFilesName[0] )
-              fileSizesToMerge[-1].append( fileSizes[0] )
-
-            else: #combined size is too large
-              ## Move on to next merge list then add file
-              filesToMerge.append( [] )
-              fileSizesToMerge.append( [] )
-              filesToMerge[-1].append( inputFilesName[0] )
-              fileSizesToMerge[-1].append( fileSizes[0] )
-
-
-            inputFilesName = inputFilesName[1:] #remove first element
-            fileSizes = fileSizes[1:] #remove first element
-
-          #for iMerge, theseFilesToMerge in enumerate( filesToMerge ):
-          #  print theseFilesToMerge
-          #  print fileSizesToMerge[iMerge]
-          #  print sum(fileSizesToMerge[iMerge])
-
-          ## Combine
-          for iMerge, theseFilesToMerge in enumerate( filesToMerge ):
-            if len( filesToMerge) == 1: #Only one output file
-              os.system('hadd '+outputFileName+'.root '+' '.join(theseFilesToMerge) )
-            elif len(theseFilesToMerge) == 1:
-              os.system("mv "+theseFilesToMerge[0]+" "+outputFileName+"."+str(iMerge)+".root")
-            else:
-              os.system('hadd '+outputFileName+'.'+str(iMerge)+'.root '+' '.join(theseFilesToMerge) )
-
+        print '   merging inputFilesName: %s'%inputFilesNameWildCard
+        merge(outputFileName, inputFilesName, nprocesses=args.nProcesses, memory_limit_mb=args.memoryLimit, max_size_gb=args.maxSize)
 
       elif (renameRawDatasets=="True") :
         print 'renaming ', inputFilesName
@@ -0,0 +1,38 @@
+#!/usr/bin/env python
+
+##******************************************
+#xAH_merge.py
+#merge the ROOT outputs of xAODAnaHelpers jobs (histograms, cutflows, trees) in parallel, within a memory limit
+#EXAMPLE xAH_merge.py -o merged.root gridOutput/rawDownload/user.*.tree.root/*.root* -j 8 --memory 4000
+##******************************************
+
+from __future__ import print_function
+import argparse
+import glob
+import logging
+import sys
+
+parser = argparse.ArgumentParser(description="Merge ROOT files in a parallel reduction tree. Trees are fast-cloned when possible, and the MetaData_EventCount and cutflow histograms of the output are checked against the sum of the inputs.",
+                                 formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+parser.add_argument('inputs', metavar='input', nargs='+', help='input files (wildcards are expanded)')
+parser.add_argument('-o', '--output', dest='output', required=True, help='output file name')
+parser.add_argument('-j', '--nProcesses', dest='nProcesses', type=int, default=None, help='number of merges run in parallel (default: number of cores)')
+parser.add_argument('--memory', dest='memory', type=float, default=2000, help='memory limit (in MB) for all the merges running at the same time')
+parser.add_argument('--fanin', dest='fanin', type=int, default=None, help='maximum number of files merged at once (default: as many as fit in the memory limit, up to 64)')
+parser.add_argument('--maxSize', dest='maxSize', type=float, default=-1, help='attempted max size (in GB) of the output files, output.N.root files are written if needed. -1 for no size limit')
+parser.add_argument('--skipBad', dest='skipBad', action='store_true', default=False, help='skip the unreadable input files instead of failing')
+parser.add_argument('--log-level', dest='log_level', type=str, default='info', choices=['debug', 'info', 'warning', 'error'], help='logging level')
+
+if __name__ == "__main__":
+  args = parser.parse_args()
+
+  logging.basicConfig(format='%(asctime)s %(name)s %(levelname)s %(message)s', level=getattr(logging, args.log_level.upper()))
+  from xAODAnaHelpers import merge
+
+  inputs = sorted(set(f for pattern in args.inputs for f in (glob.glob(pattern) or [pattern])))
+  try:
+    written = merge.merge(args.output, inputs, nprocesses=args.nProcesses, memory_limit_mb=args.memory, fanin=args.fanin, max_size_gb=args.maxSize, skip_bad=args.skipBad)
+  except Exception as e:
+    logging.getLogger("xAH.merge").error(str(e))
+    sys.exit(1)
+  print("\n".join(written))
@@ -96,6 +96,26 @@ parser.add_argument('--inputSH', action='store_true', dest='use_SH', default=Fal
 parser.add_argument('--scanXRD', action='store_true', dest='use_scanXRD', default=False, help='If enabled, will search the xrootd server for the given pattern')
 parser.add_argument('-l', '--log-level', type=str, default='info', help='Logging level. See https://docs.python.org/3/howto/logging.html for more info.')
 parser.add_argument('--stats', action='store_true', dest='variable_stats', default=False, help='If enabled, will variable usage statistics.')
+parser.add_argument('--timing', action='store_true', dest='timing', default=False, help='If enabled, will time each algorithm (and each systematic of the calibrators) and print a summary at the end of the job. The summary is also saved as the xAH_timing tree of the histogram output.')
+parser.add_argument('--timingJSON', dest='timing_json', metavar='<file>', type=str, default='', help='With --timing, also write the timing summary to this JSON file.')
+parser.add_argument('--memory', action='store_true', dest='memory', default=False, help='If enabled, will account for the heap allocated by each algorithm and sample the memory usage of the job. The summary is printed at the end of the job and saved as the xAH_memory and xAH_memory_events trees of the cutflow output.')
+parser.add_argument('--memoryInterval', dest='memory_interval', metavar='<n>', type=int, default=100, help='With --memory, read the memory usage only every n events.')
+parser.add_argument('--pickEvents', dest='pick_events', metavar='<file>', type=str, default='', help='Only run on the events listed in this text file, one "runNumber eventNumber" per line. Their input file and entry are looked up in the --eventIndex files, and only the input files containing them are read.')
+parser.add_argument('--eventIndex', dest='event_index', metavar='<file>', type=str, nargs='+', default=[], help='With --pickEvents, the event index (event_index output of BasicEventSelection with m_writeEventIndex) of the jobs that ran on the input files.')
+parser.add_argument('--scanEvents', action='store_true', dest='scan_events', default=False, help='If enabled, will count the events of every local input file (done anyway with --optEventsPerWorker), so that the jobs can be split by number of events. The files are opened in parallel and the counts are cached.')
+parser.add_argument('--scanThreads', dest='scan_threads', metavar='<n>', type=int, default=8, help='Number of input files opened at the same time when counting events.')
+parser.add_argument('--scanCache', dest='scan_cache', metavar='<file>', type=str, default=os.path.join(os.path.expanduser('~'), '.xAH_scan_cache.json'), help='Where to cache the number of events of each local input file. The entry of a file is used as long as its size and modification time do not change. Set to an empty string to disable.')
+parser.add_argument('--snapshot', dest='snapshot', metavar='<dir>', type=str, default='', help='Save the samples (with their metadata) and the configured algorithms to this directory, and load them from it instead of scanning the inputs and running the configuration again as long as the configuration file, the inputs, the metadata and the options that change the job are the same.')
+parser.add_argument('--cacheSize', dest='cache_size', metavar='<MB>', type=float, default=50, help='Size of the TTreeCache of each input file, in MB (0 to disable the cache).')
+parser.add_argument('--cacheLearnEntries', dest='cache_learn_entries', metavar='<n>', type=int, default=50, help='Number of entries the TTreeCache watches to learn which branches are read.')
+parser.add_argument('--cacheBranches', dest='cache_branches', metavar='<container>', type=str, nargs='+', default=[], help='Input containers whose branches are put in the TTreeCache from the first entry on, instead of being found in the learning phase. Use "auto" for the input containers of the configured algorithms.')
+parser.add_argument('--pinOnly', action='store_true', dest='pin_only', default=False, help='With --cacheBranches, only cache those branches (no learning phase). The other branches are then read one basket at a time.')
+parser.add_argument('--asyncPrefetch', action='store_true', dest='async_prefetch', default=False, help='Read the next block of the TTreeCache in the background while the current one is processed.')
+parser.add_argument('--prefetchNextFile', action='store_true', dest='prefetch_next_file', default=False, help='Open the next input file in the background while the current one is processed (direct driver only).')
+parser.add_argument('--pruneInputs', action='store_true', dest='prune_inputs', default=False, help='Only read the input containers declared by the configured algorithms: the other branches are disabled. The job stops if an algorithm reads an undeclared branch.')
+parser.add_argument('--keepInputs', dest='keep_inputs', metavar='<container>', type=str, nargs='+', default=[], help='With --pruneInputs, input containers to read on top of the declared ones (wildcards allowed, e.g. "*TrackParticles").')
+parser.add_argument('--inputReport', action='store_true', dest='input_report', default=False, help='Print the input containers declared by each configured algorithm, and the size of the branches of the first input file that --pruneInputs would not read, then exit without running.')
+parser.add_argument('--readStats', action='store_true', dest='read_stats', default=False, help='Print the bytes read, the number of read calls and the TTreeCache hit rate of each input file at the end of the job.')
 
 # first is the driver common arguments
 drivers_common = argparse.ArgumentParser(add_help=False, description='Common Driver Arguments')
@@ -166,6 +186,12 @@ local = drivers_parser.add_parser('local',
                                   formatter_class=lambda prog: CustomFormatter(prog, max_help_position=30),
                                   parents=[drivers_common])
 
+multicore = drivers_parser.add_parser('multicore',
+                                      help='Run your jobs locally on all the cores of the machine',
+                                      usage=baseUsageStr.format('multicore'),
+                                      formatter_class=lambda prog: CustomFormatter(prog, max_help_position=30),
+                                      parents=[drivers_common])
+
 # define arguments for prooflite driver
 prooflite.add_argument('--optPerfTree',          metavar='', type=int, required=False, default=None, help='the option to turn on the performance tree in PROOF.  if this is set to 1, it will write out the tree')
 prooflite.add_argument('--optBackgroundProcess', metavar='', type=int, required=False, default=None, help='the option to do processing in a background process in PROOF')
@@ -197,6 +223,11 @@ prun.add_argument('--optVoms',                 metavar='', type=int, required=Fa
 prun.add_argument('--optGridOutputSampleName', metavar='', type=str, required=False, help='Define output grid sample name', default='user.%nickname%.%in:name[2]%.%in:name[3]%.%in:name[6]%.%in:name[7]%_xAH')
 prun.add_argument('--singleTask',              action='store_true',  required= False, default=False, help='Submit all input datasets under a single task.')
 
+# define arguments for multicore driver
+multicore.add_argument('--nWorkers',        dest='nWorkers', metavar='', type=int, required=False, default=None, help='the number of worker processes (default: the number of cores)')
+multicore.add_argument('--chunksPerWorker', dest='chunksPerWorker', metavar='', type=int, required=False, default=1, help='the number of chunks the input files are split in per worker. The workers take the next chunk when done with the previous one: more chunks balance the load better when the input files are very uneven, but every chunk initializes all the algorithms (and their CP tools) again')
+multicore.add_argument('--keepChunks',      dest='keepChunks', action='store_true', required=False, default=False, help='keep the outputs of each chunk after merging them')
+
 # define arguments for condor driver
 condor.add_argument('--optCondorConf', metavar='', type=str, required=False, default='stream_output = true', help='the name of the option for supplying extra parameters for condor systems')
 
@@ -268,6 +299,10 @@ if __name__ == "__main__":
       if not isSLC6:
         raise EnvironmentError('We think you\'re not running on SLC6. Grid jobs cannot be submitted from this machine.')
 
+    # each chunk of the multicore driver is a job of its own, which would skip and count the events separately
+    if args.driver == "multicore" and (args.num_events > 0 or args.skip_events > 0):
+      raise ValueError('--nevents and --skip cannot be used with the multicore driver, run with the direct driver instead.')
+
     # check submission directory
     if args.force_overwrite:
       xAH_logger.info("removing {0:s}".format(args.submit_dir))
@@ -330,130 +365,158 @@ if __name__ == "__main__":
       if getattr(ROOT.EL, 'LocalDriver') is None:
         raise KeyError('Cannot load the Local driver from EventLoop. Did you not compile it?')
 
-    # create a new sample handler to describe the data files we use
-    xAH_logger.info("creating new sample handler")
-    sh_all = ROOT.SH.SampleHandler()
-
-    # this portion is just to output for verbosity
-    if args.use_SH:
-      xAH_logger.info("\t\tReading in file(s) using SH::SampleHandler::load(dir)")
-    elif args.use_inputFileList:
-      xAH_logger.info("\t\tReading in file(s) containing list of files")
-      if args.use_scanRucio:
-        xAH_logger.info("\t\tAdding samples using scanRucio")
-      elif use_scanEOS:
-        xAH_logger.info("\t\tAdding samples using scanEOS")
-      else:
-        xAH_logger.info("\t\tAdding using readFileList")
-    else:
-      if args.use_scanRucio:
-        xAH_logger.info("\t\tAdding samples using scanRucio")
-      elif use_scanEOS:
-        xAH_logger.info("\t\tAdding samples using scanEOS")
-      else:
-        xAH_logger.info("\t\tAdding samples using scanDir")
+    path_metadata=ROOT.PathResolverFindCalibDirectory("xAODAnaHelpers/metadata")
 
-    for fname in args.input_filename:
+    # the samples and algorithms of a previous job with the same configuration and inputs
+    snap, snapshot_key = None, None
+    if args.snapshot and args.pick_events:
+      xAH_logger.warning("not using the snapshot {0:s} with --pickEvents".format(args.snapshot))
+    elif args.snapshot:
+      from xAODAnaHelpers import snapshot
+      snapshot_key = snapshot.make_key(args, path_metadata)
+      snap = snapshot.load(args.snapshot, snapshot_key)
+      if snap is not None:
+        xAH_logger.info("loaded the samples and algorithms from the snapshot {0:s}".format(args.snapshot))
+        sh_all = snap.samples
+        sh_all.printContent()
+
+    if snap is None:
+      # create a new sample handler to describe the data files we use
+      xAH_logger.info("creating new sample handler")
+      sh_all = ROOT.SH.SampleHandler()
+
+      # this portion is just to output for verbosity
       if args.use_SH:
-        sh_all.load(fname)
+        xAH_logger.info("\t\tReading in file(s) using SH::SampleHandler::load(dir)")
       elif args.use_inputFileList:
-        # Read the filelist
-        filelist=[]
-        with open(fname, 'r') as f:
-          for line in f:
-            if line.startswith('#') : continue
-            if not line.strip()     : continue
-            line = line.strip()
-            filelist.append(line)
-        # Iterate over the filelist and add each item to the SampleHandler
-        if use_scanEOS or args.use_scanXRD or (args.use_scanRucio and not singleTask):
-          for line in filelist:
-            if args.use_scanRucio:
-              ROOT.SH.scanRucio(sh_all, line)
-            elif use_scanEOS:
-              base = os.path.basename(line)
-              eosDataSet = os.path.dirname(line)
-              ROOT.SH.ScanDir().sampleDepth(0).samplePattern(eosDataSet).scanEOS(sh_all,base)
-            elif args.use_scanXRD:
-              # assume format like root://someserver//path/to/files/*pattern*.root
-              server, path = line.replace('root://', '').split('//')
-              sh_list = ROOT.SH.DiskListXRD(server, os.path.join('/', path), True)
-              ROOT.SH.ScanDir().scan(sh_all, sh_list)
-            else:
-              raise Exception("What just happened?")
-        elif args.use_scanRucio and singleTask:
-          ROOT.xAH.addRucio(sh_all,os.path.basename(fname),
-                            ','.join(filelist))
+        xAH_logger.info("\t\tReading in file(s) containing list of files")
+        if args.use_scanRucio:
+          xAH_logger.info("\t\tAdding samples using scanRucio")
+        elif use_scanEOS:
+          xAH_logger.info("\t\tAdding samples using scanEOS")
         else:
-          # Sample name
-          sname='.'.join(os.path.basename(fname).split('.')[:-1]) # input filelist name without extension
-          # Read settings
-          fcname=os.path.dirname(fname)+'/'+sname+'.config' # replace .txt with .config
-          config={}
-          if os.path.exists(fcname): # load configuration if it exists
-            with open(fcname, 'r') as f:
-              for line in f:
-                line=line.strip()
-                parts=line.split('=')
-                if len(parts)!=2: continue
-                config[parts[0].strip()]=parts[1].strip()
-
-          ROOT.SH.readFileList(sh_all, sname, fname)
-          if 'xsec'    in config: sh_all.get(sname).meta().setDouble(ROOT.SH.MetaFields.crossSection    ,float(config['xsec'   ]))
-          if 'filteff' in config: sh_all.get(sname).meta().setDouble(ROOT.SH.MetaFields.filterEfficiency,float(config['filteff']))
-          if 'nEvents' in config: sh_all.get(sname).meta().setDouble(ROOT.SH.MetaFields.numEvents       ,float(config['nEvents']))
+          xAH_logger.info("\t\tAdding using readFileList")
       else:
-
         if args.use_scanRucio:
-          ROOT.SH.scanRucio(sh_all, fname)
+          xAH_logger.info("\t\tAdding samples using scanRucio")
         elif use_scanEOS:
-          tag=args.inputTag
-          if ( tag == "" ):
-            tag="*"
-          print("Running on EOS directory "+fname+" with tag "+tag)
-          ROOT.SH.ScanDir().filePattern(tag).scanEOS(sh_all,fname)
-        elif args.use_scanXRD:
-          # assume format like root://someserver//path/to/files/*pattern*.root
-          server, path = fname.replace('root://', '').split('//')
-          sh_list = ROOT.SH.DiskListXRD(server, os.path.join(path, ''), True)
-          ROOT.SH.ScanDir().scan(sh_all, sh_list)
+          xAH_logger.info("\t\tAdding samples using scanEOS")
+        else:
+          xAH_logger.info("\t\tAdding samples using scanDir")
+
+      for fname in args.input_filename:
+        if args.use_SH:
+          sh_all.load(fname)
+        elif args.use_inputFileList:
+          # Read the filelist
+          filelist=[]
+          with open(fname, 'r') as f:
+            for line in f:
+              if line.startswith('#') : continue
+              if not line.strip()     : continue
+              line = line.strip()
+              filelist.append(line)
+          # Iterate over the filelist and add each item to the SampleHandler
+          if use_scanEOS or args.use_scanXRD or (args.use_scanRucio and not singleTask):
+            for line in filelist:
+              if args.use_scanRucio:
+                ROOT.SH.scanRucio(sh_all, line)
+              elif use_scanEOS:
+                base = os.path.basename(line)
+                eosDataSet = os.path.dirname(line)
+                ROOT.SH.ScanDir().sampleDepth(0).samplePattern(eosDataSet).scanEOS(sh_all,base)
+              elif args.use_scanXRD:
+                # assume format like root://someserver//path/to/files/*pattern*.root
+                server, path = line.replace('root://', '').split('//')
+                sh_list = ROOT.SH.DiskListXRD(server, os.path.join('/', path), True)
+                ROOT.SH.ScanDir().scan(sh_all, sh_list)
+              else:
+                raise Exception("What just happened?")
+          elif args.use_scanRucio and singleTask:
+            ROOT.xAH.addRucio(sh_all,os.path.basename(fname),
+                              ','.join(filelist))
+          else:
+            # Sample name
+            sname='.'.join(os.path.basename(fname).split('.')[:-1]) # input filelist name without extension
+            # Read settings
+            fcname=os.path.dirname(fname)+'/'+sname+'.config' # replace .txt with .config
+            config={}
+            if os.path.exists(fcname): # load configuration if it exists
+              with open(fcname, 'r') as f:
+                for line in f:
+                  line=line.strip()
+                  parts=line.split('=')
+                  if len(parts)!=2: continue
+                  config[parts[0].strip()]=parts[1].strip()
+
+            ROOT.SH.readFileList(sh_all, sname, fname)
+            if 'xsec'    in config: sh_all.get(sname).meta().setDouble(ROOT.SH.MetaFields.crossSection    ,float(config['xsec'   ]))
+            if 'filteff' in config: sh_all.get(sname).meta().setDouble(ROOT.SH.MetaFields.filterEfficiency,float(config['filteff']))
+            if 'nEvents' in config: sh_all.get(sname).meta().setDouble(ROOT.SH.MetaFields.numEvents       ,float(config['nEvents']))
         else:
-          # need to parse and split it up
-          fname_base = os.path.basename(fname)
-          sample_dir = os.path.dirname(os.path.abspath(fname))
-          mother_dir = os.path.dirname(sample_dir)
-          sh_list = ROOT.SH.DiskListLocal(mother_dir)
-          ROOT.SH.scanDir(sh_all, sh_list, fname_base, os.path.basename(sample_dir))
-
-    # print out the samples we found
-    xAH_logger.info("\t%d different dataset(s) found", len(sh_all))
-        #if not args.use_scanRucio:
-        #for dataset in sh_all:
-        #xAH_logger.info("\t\t%d files in %s", dataset.numFiles(), dataset.name())
-    sh_all.printContent()
-
-    if len(sh_all) == 0:
-      xAH_logger.info("No datasets found. Exiting.")
-      sys.exit(0)
-
-    if args.optEventsPerWorker is not None:
-      xAH_logger.info("Splitting up events onto each worker. optEventsPerWorker was set!")
-      ROOT.SH.scanNEvents(sh_all)
-
-    # set the name of the tree in our files (should be configurable)
-    sh_all.setMetaString( "nc_tree", args.treeName)
-    #sh_all.setMetaString( "nc_excludeSite", "ANALY_RAL_SL6");
-    sh_all.setMetaString( "nc_grid_filter", "*");
-
-    # This is a fix for running on the grid with release 21.2.X
-    if int(os.environ.get('ROOTCORE_RELEASE_SERIES', 0)) >= 25:
-      xAH_logger.info("Setting nc_cmtConfig to {0:s}".format(os.getenv('Analysis'+ASG_framework_type+'_PLATFORM')))
-      sh_all.setMetaString("nc_cmtConfig", os.getenv('Analysis'+ASG_framework_type+'_PLATFORM'))
 
-    # read susy meta data (should be configurable)
-    path_metadata=ROOT.PathResolverFindCalibDirectory("xAODAnaHelpers/metadata")
-    xAH_logger.info("reading all metadata in {0}".format(path_metadata))
-    ROOT.SH.readSusyMetaDir(sh_all,path_metadata)
+          if args.use_scanRucio:
+            ROOT.SH.scanRucio(sh_all, fname)
+          elif use_scanEOS:
+            tag=args.inputTag
+            if ( tag == "" ):
+              tag="*"
+            print("Running on EOS directory "+fname+" with tag "+tag)
+            ROOT.SH.ScanDir().filePattern(tag).scanEOS(sh_all,fname)
+          elif args.use_scanXRD:
+            # assume format like root://someserver//path/to/files/*pattern*.root
+            server, path = fname.replace('root://', '').split('//')
+            sh_list = ROOT.SH.DiskListXRD(server, os.path.join(path, ''), True)
+            ROOT.SH.ScanDir().scan(sh_all, sh_list)
+          else:
+            # need to parse and split it up
+            fname_base = os.path.basename(fname)
+            sample_dir = os.path.dirname(os.path.abspath(fname))
+            mother_dir = os.path.dirname(sample_dir)
+            sh_list = ROOT.SH.DiskListLocal(mother_dir)
+            ROOT.SH.scanDir(sh_all, sh_list, fname_base, os.path.basename(sample_dir))
+
+      # print out the samples we found
+      xAH_logger.info("\t%d different dataset(s) found", len(sh_all))
+          #if not args.use_scanRucio:
+          #for dataset in sh_all:
+          #xAH_logger.info("\t\t%d files in %s", dataset.numFiles(), dataset.name())
+      sh_all.printContent()
+
+      if len(sh_all) == 0:
+        xAH_logger.info("No datasets found. Exiting.")
+        sys.exit(0)
+
+      if args.pick_events:
+        if not args.event_index:
+          raise ValueError("--pickEvents needs the event index of the input files, give it with --eventIndex")
+        from xAODAnaHelpers import pick
+        xAH_logger.info("Picking the events of {0:s}".format(args.pick_events))
+        picked_entries, _ = pick.lookup(args.event_index, pick.read_pick_list(args.pick_events))
+        sh_all = pick.restrict_samples(sh_all, picked_entries)
+        if len(sh_all) == 0:
+          xAH_logger.info("No input files with events to pick. Exiting.")
+          sys.exit(0)
+
+      if args.optEventsPerWorker is not None or args.scan_events:
+        if args.optEventsPerWorker is not None:
+          xAH_logger.info("Splitting up events onto each worker. optEventsPerWorker was set!")
+        from xAODAnaHelpers import scan
+        scan.scan_samples(sh_all, nthreads=args.scan_threads, cache_path=args.scan_cache, tree_name=args.treeName)
+
+      # set the name of the tree in our files (should be configurable)
+      sh_all.setMetaString( "nc_tree", args.treeName)
+      #sh_all.setMetaString( "nc_excludeSite", "ANALY_RAL_SL6");
+      sh_all.setMetaString( "nc_grid_filter", "*");
+
+      # This is a fix for running on the grid with release 21.2.X
+      if int(os.environ.get('ROOTCORE_RELEASE_SERIES', 0)) >= 25:
+        xAH_logger.info("Setting nc_cmtConfig to {0:s}".format(os.getenv('Analysis'+ASG_framework_type+'_PLATFORM')))
+        sh_all.setMetaString("nc_cmtConfig", os.getenv('Analysis'+ASG_framework_type+'_PLATFORM'))
+
+      # read susy meta data (should be configurable)
+      xAH_logger.info("reading all metadata in {0}".format(path_metadata))
+      ROOT.SH.readSusyMetaDir(sh_all,path_metadata)
 
     # this is the basic description of our job
     xAH_logger.info("creating new job")
@@ -468,9 +531,9 @@ if __name__ == "__main__":
       xAH_logger.info("\tskipping first %d events", args.skip_events)
       job.options().setDouble(ROOT.EL.Job.optSkipEvents, args.skip_events)
 
-    # should be configurable
-    job.options().setDouble(ROOT.EL.Job.optCacheSize, 50*1024*1024)
-    job.options().setDouble(ROOT.EL.Job.optCacheLearnEntries, 50)
+    xAH_logger.info("\tusing a TTreeCache of %g MB, learning from %d entries", args.cache_size, args.cache_learn_entries)
+    job.options().setDouble(ROOT.EL.Job.optCacheSize, args.cache_size*1024*1024)
+    job.options().setDouble(ROOT.EL.Job.optCacheLearnEntries, args.cache_learn_entries)
 
     if args.variable_stats:
       xAH_logger.info("\tprinting variable statistics")
@@ -491,51 +554,54 @@ if __name__ == "__main__":
     # formatted string
     algorithmConfiguration_string = []
 
-    from xAODAnaHelpers import Config
-    configurator = None
-
-    if ".json" in args.config:
-      # parse_json is json.load + stripping comments
-      from xAODAnaHelpers.utils import parse_json
-      xAH_logger.debug("Loading json files")
-      algConfigs = parse_json(args.config)
-      xAH_logger.debug("loaded the json configurations")
-      # add our algorithm to the job
-      configurator = Config()
-      map(lambda x: configurator.setalg(x['class'], x['configs']), algConfigs)
-
+    if snap is not None:
+      configurator = snap.configurator
     else:
-      #  Executing the python
-      #   (configGlobals and configLocals are used to pass vars
-      configGlobals, configLocals = {}, {'args': args}
-      execfile(args.config, configGlobals, configLocals)
-      # Find the created xAODAnaHelpers.config.Config object and add its _algorithms to the Job
-      for k,v in configLocals.iteritems():
-        if isinstance(v, Config):
-          configurator = v
-          break
-
-    # setting sample metadata
-    for pattern, metadata in configurator._samples.iteritems():
-      found_matching_sample = False
-      xAH_logger.debug("Looking for sample(s) that matches pattern {0}".format(pattern))
-      for sample in sh_all:
-        if pattern in sample.name():
-          found_matching_sample = True
-          xAH_logger.info("Setting sample metadata for {0:s}".format(sample.name()))
-          for k,t,v in ((k, type(v), v) for k,v in metadata.iteritems()):
-            if t in [float]:
-              setter = 'setDouble'
-            elif t in [int]:
-              setter = 'setInteger'
-            elif t in [bool]:
-              setter = 'setBool'
-            else:
-              setter = 'setString'
-            getattr(sample.meta(), setter)(k, v)
-            xAH_logger.info("\t - sample.meta().{0:s}({1:s}, {2})".format(setter, k, v))
-        if not found_matching_sample:
-          xAH_logger.warning("No matching sample found for pattern {0}".format(pattern))
+      from xAODAnaHelpers import Config
+      configurator = None
+
+      if ".json" in args.config:
+        # parse_json is json.load + stripping comments
+        from xAODAnaHelpers.utils import parse_json
+        xAH_logger.debug("Loading json files")
+        algConfigs = parse_json(args.config)
+        xAH_logger.debug("loaded the json configurations")
+        # add our algorithm to the job
+        configurator = Config()
+        map(lambda x: configurator.setalg(x['class'], x['configs']), algConfigs)
+
+      else:
+        #  Executing the python
+        #   (configGlobals and configLocals are used to pass vars
+        configGlobals, configLocals = {}, {'args': args}
+        execfile(args.config, configGlobals, configLocals)
+        # Find the created xAODAnaHelpers.config.Config object and add its _algorithms to the Job
+        for k,v in configLocals.iteritems():
+          if isinstance(v, Config):
+            configurator = v
+            break
+
+      # setting sample metadata
+      for pattern, metadata in configurator._samples.iteritems():
+        found_matching_sample = False
+        xAH_logger.debug("Looking for sample(s) that matches pattern {0}".format(pattern))
+        for sample in sh_all:
+          if pattern in sample.name():
+            found_matching_sample = True
+            xAH_logger.info("Setting sample metadata for {0:s}".format(sample.name()))
+            for k,t,v in ((k, type(v), v) for k,v in metadata.iteritems()):
+              if t in [float]:
+                setter = 'setDouble'
+              elif t in [int]:
+                setter = 'setInteger'
+              elif t in [bool]:
+                setter = 'setBool'
+              else:
+                setter = 'setString'
+              getattr(sample.meta(), setter)(k, v)
+              xAH_logger.info("\t - sample.meta().{0:s}({1:s}, {2})".format(setter, k, v))
+          if not found_matching_sample:
+            xAH_logger.warning("No matching sample found for pattern {0}".format(pattern))
 
     for output in configurator._outputs:
       xAH_logger.info('Creating output stream "{}"'.format(output))
@@ -548,8 +614,88 @@ if __name__ == "__main__":
         if isinstance(alg, ROOT.EL.NTupleSvc) and not job.outputHas(alg.GetName()):
           job.outputAdd(ROOT.EL.OutputStream(alg.GetName()))
 
+    if snapshot_key is not None and snap is None:
+      snapshot.save(args.snapshot, snapshot_key, sh_all, configurator)
+
+    # the picked entries are selected before any algorithm reads anything
+    if args.pick_events:
+      picker = ROOT.EventPicker()
+      picker.SetName("xAHEventPicker")
+      picker.m_entries = pick.entries_option(picked_entries)
+      job.algsAdd(picker)
+
+    # the inputs declared by each algorithm, '*' for those that may read anything
+    declared_inputs = []
+    for alg in configurator._algorithms:
+      alg_name = alg.GetName() if hasattr(alg, 'GetName') else alg.name()
+      inputs = str(alg.declaredInputs()).split() if hasattr(alg, 'declaredInputs') else ['*']
+      declared_inputs.append((alg_name, sorted(set(inputs))))
+    undeclared_algs = [alg_name for alg_name, inputs in declared_inputs if '*' in inputs]
+    all_inputs = set(args.keep_inputs)
+    for _, inputs in declared_inputs: all_inputs.update(inputs)
+
+    if args.input_report:
+      from xAODAnaHelpers import inputs as xAH_inputs
+      xAH_inputs.report(declared_inputs, all_inputs, sh_all, args.treeName)
+      sys.exit(0)
+
+    if args.prune_inputs and undeclared_algs:
+      xAH_logger.warning("Not pruning the inputs: %s may read any container", ', '.join(undeclared_algs))
+
+    # the cache is set up before the first algorithm reads anything
+    if args.cache_branches or args.async_prefetch or args.prefetch_next_file or args.read_stats or args.prune_inputs:
+      inputCache = ROOT.InputCache()
+      inputCache.SetName("xAHInputCache")
+      branches = set(b for b in args.cache_branches if b != 'auto')
+      if 'auto' in args.cache_branches:
+        # the containers the algorithms read: those not in the input are simply not found
+        branches.add('EventInfo')
+        branches.update(i for i in all_inputs if i != '*')
+        for configLog in configurator._log:
+          if len(configLog) != 3 or configLog[0] not in undeclared_algs: continue
+          _, option, value = configLog
+          if 'Container' not in option or option.startswith('m_out') or not hasattr(value, 'split'): continue
+          branches.update(value.split())
+      inputCache.m_branches = ' '.join(sorted(branches))
+      if args.prune_inputs and not undeclared_algs:
+        inputCache.m_pruneInputs = True
+        inputCache.m_declaredInputs = ' '.join(sorted(all_inputs))
+        xAH_logger.info("\tonly reading the declared inputs %s", inputCache.m_declaredInputs)
+      inputCache.m_pinOnly = args.pin_only
+      inputCache.m_asyncPrefetch = args.async_prefetch
+      if args.prefetch_next_file:
+        if args.driver == 'direct':
+          inputCache.m_prefetchFiles = ' '.join(str(f) for sample in sh_all for f in sample.makeFileList())
+        else:
+          xAH_logger.warning("--prefetchNextFile is only supported with the direct driver, ignoring it")
+      inputCache.m_printStats = args.read_stats
+      if branches: xAH_logger.info("\tcaching the branches of %s", inputCache.m_branches)
+      job.algsAdd(inputCache)
+
     # Add the algorithms to the job
-    map(job.algsAdd, configurator._algorithms)
+    if args.timing or args.memory:
+      # put a probe before the first algorithm and after each of them: each probe measures the algorithm right before it
+      if args.timing: xAH_logger.info("Timing each algorithm")
+      if args.memory: xAH_logger.info("Accounting for the memory used by each algorithm, sampled every %d events", args.memory_interval)
+      def make_timer(index, timed_alg_name):
+        timer = ROOT.AlgorithmTimer()
+        timer.SetName("xAHTimer_{0:d}".format(index))
+        timer.m_timedAlgorithm = timed_alg_name
+        timer.m_doTiming = args.timing
+        timer.m_doMemory = args.memory
+        timer.m_memorySampleInterval = args.memory_interval
+        return timer
+
+      job.algsAdd(make_timer(0, ''))
+      for index, alg in enumerate(configurator._algorithms, 1):
+        job.algsAdd(alg)
+        timer = make_timer(index, alg.GetName() if hasattr(alg, 'GetName') else alg.name())
+        if index == len(configurator._algorithms):
+          timer.m_writeSummary = True
+          timer.m_jsonFile = args.timing_json
+        job.algsAdd(timer)
+    else:
+      map(job.algsAdd, configurator._algorithms)
 
     for configLog in configurator._log:
       # this is when we have just the algorithm name
@@ -681,8 +827,13 @@ if __name__ == "__main__":
         getattr(driver.options(), setter)(getattr(ROOT.EL.Job, opt), getattr(args, opt))
         xAH_logger.info("\t - driver.options().{0:s}({1:s}, {2})".format(setter, getattr(ROOT.EL.Job, opt), getattr(args, opt)))
 
+    elif (args.driver == "multicore"):
+      from xAODAnaHelpers import multicore
+
     xAH_logger.info("\tsubmit job")
-    if args.driver in ["prun","condor","lsf","slurm","local"] and not args.optBatchWait:
+    if args.driver == "multicore":
+      multicore.submit(job, args.submit_dir, nworkers=args.nWorkers, chunks_per_worker=args.chunksPerWorker, keep_chunks=args.keepChunks)
+    elif args.driver in ["prun","condor","lsf","slurm","local"] and not args.optBatchWait:
       driver.submitOnly(job, args.submit_dir)
     else:
       driver.submit(job, args.submit_dir)
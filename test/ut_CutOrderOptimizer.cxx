@@ -0,0 +1,125 @@
+/********************************************************************************
+ *
+ * ut_CutOrderOptimizer
+ *
+ * Unit test of xAH::CutOrderOptimizer: the cuts are measured during the learning
+ * events, then sorted by time per rejected object, the fixed cuts keeping their
+ * position in the chain.
+ *
+ ********************************************************************************/
+
+// c++ include(s):
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// package include(s):
+#include "xAODAnaHelpers/CutOrderOptimizer.h"
+
+namespace {
+
+  enum class TestCut : unsigned int { all, a, b, c, d, e, NCuts };
+
+  typedef xAH::CutOrderOptimizer<TestCut> Optimizer;
+
+  int nFailures = 0;
+
+  void check( bool condition, const std::string& what ) {
+    if ( condition ) return;
+    std::cerr << "FAILED: " << what << std::endl;
+    ++nFailures;
+  }
+
+  std::string toString( const std::vector<TestCut>& order ) {
+    const char* names[] = { "all", "a", "b", "c", "d", "e" };
+    std::string result;
+    for ( auto cut : order ) result += std::string( names[ static_cast<unsigned int>(cut) ] ) + " ";
+    return result;
+  }
+
+  // record one evaluation of ``cut`` which took ``ms`` milliseconds
+  void evaluate( Optimizer& optimizer, TestCut cut, bool pass, int ms ) {
+    if ( !optimizer.isLearning() ) return;
+    optimizer.record( cut, pass, Optimizer::clock::now() - std::chrono::milliseconds( ms ) );
+  }
+
+  // two learning events with the same measurements:
+  //  a never rejects, b and e reject everything in 1 and 2 ms, d rejects half of the objects in 10 ms, c is slow and selective
+  void learn( Optimizer& optimizer ) {
+    for ( int event = 0; event < 2; ++event ) {
+      evaluate( optimizer, TestCut::a, true,   1 );
+      evaluate( optimizer, TestCut::b, false,  1 );
+      evaluate( optimizer, TestCut::c, false, 50 );
+      evaluate( optimizer, TestCut::d, event, 10 );
+      evaluate( optimizer, TestCut::e, false,  2 );
+      check( optimizer.nextEvent() == ( event == 1 ), "the order changes at the end of the learning phase only" );
+    }
+    check( !optimizer.isLearning(), "the learning phase is over after the learning events" );
+    check( !optimizer.nextEvent(), "the order is only changed once" );
+  }
+
+  const std::vector<TestCut>     defaultOrder = { TestCut::a, TestCut::b, TestCut::c, TestCut::d, TestCut::e };
+  const std::vector<std::string> labels       = { "a", "b", "c", "d", "e" };
+
+}
+
+int main() {
+
+  // without learning events, the default order is kept and nothing is measured
+  {
+    Optimizer optimizer;
+    optimizer.setOrder( defaultOrder, labels );
+    check( !optimizer.isLearning(), "no learning without learning events" );
+    check( optimizer.start() == Optimizer::clock::time_point(), "no timestamp outside of the learning phase" );
+    for ( int event = 0; event < 5; ++event ) check( !optimizer.nextEvent(), "no reordering without learning events" );
+    check( optimizer.order() == defaultOrder, "default order kept without learning events, got " + toString( optimizer.order() ) );
+  }
+
+  // measure, then sort all the cuts by time per rejected object: the cuts that never reject go last
+  {
+    Optimizer optimizer;
+    optimizer.setOrder( defaultOrder, labels );
+    optimizer.setLearningEvents( 2 );
+    check( optimizer.isLearning(), "learning after setLearningEvents" );
+    learn( optimizer );
+
+    check( optimizer.rejection( TestCut::a ) == 0.,  "rejection of a" );
+    check( optimizer.rejection( TestCut::d ) == 0.5, "rejection of d" );
+    check( optimizer.cost( TestCut::c ) >= 0.05,     "cost of c" );
+
+    const std::vector<TestCut> expected = { TestCut::b, TestCut::e, TestCut::d, TestCut::c, TestCut::a };
+    check( optimizer.order() == expected, "measured order: expected " + toString( expected ) + ", got " + toString( optimizer.order() ) );
+  }
+
+  // the fixed cuts keep their position, the others are sorted between them
+  {
+    Optimizer optimizer;
+    optimizer.setOrder( defaultOrder, labels, { TestCut::c } );
+    optimizer.setLearningEvents( 2 );
+    check( optimizer.isFixed( TestCut::c ) && !optimizer.isFixed( TestCut::a ), "fixed cuts" );
+    learn( optimizer );
+
+    const std::vector<TestCut> expected = { TestCut::b, TestCut::a, TestCut::c, TestCut::e, TestCut::d };
+    check( optimizer.order() == expected, "order with fixed cut: expected " + toString( expected ) + ", got " + toString( optimizer.order() ) );
+    check( optimizer.summary().find( "* c" ) != std::string::npos, "fixed cuts are starred in the summary" );
+  }
+
+  // setOrder resets the measurements
+  {
+    Optimizer optimizer;
+    optimizer.setLearningEvents( 2 );
+    optimizer.setOrder( defaultOrder, labels );
+    learn( optimizer );
+    optimizer.setOrder( defaultOrder, labels );
+    check( optimizer.isLearning(), "learning again after setOrder" );
+    check( optimizer.order() == defaultOrder && optimizer.rejection( TestCut::b ) == 0., "setOrder resets the order and the statistics" );
+  }
+
+  if ( nFailures ) {
+    std::cerr << nFailures << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "All checks passed" << std::endl;
+  return 0;
+}
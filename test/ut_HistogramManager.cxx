@@ -0,0 +1,152 @@
+/********************************************************************************
+ *
+ * ut_HistogramManager
+ *
+ * Unit test of the histograms booked lazily or in a compact storage by
+ * HistogramManager: with Sumw2 on by default, after weighted and unweighted
+ * fills, they must have the same bins, errors and output as the histograms
+ * booked eagerly.
+ *
+ ********************************************************************************/
+
+// c++ include(s):
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ROOT include(s):
+#include <TBufferFile.h>
+#include <TH1F.h>
+#include <TH2F.h>
+
+// package include(s):
+#include "xAODAnaHelpers/HistogramManager.h"
+
+namespace {
+
+  int nFailures = 0;
+
+  void check( bool condition, const std::string& what ) {
+    if ( condition ) return;
+    std::cerr << "FAILED: " << what << std::endl;
+    ++nFailures;
+  }
+
+  bool close( double lhs, double rhs ) {
+    return std::abs( lhs - rhs ) <= 1e-5*std::max( 1., std::max( std::abs( lhs ), std::abs( rhs ) ) );
+  }
+
+  class TestHists : public HistogramManager {
+    public:
+      TestHists( const std::string& name ) : HistogramManager( name, "" ) {}
+
+      StatusCode initialize() override {
+        m_h1    = book( m_name, "h1",    "x", 10, 0., 10. );
+        m_h2    = book( m_name, "h2",    "x", 10, 0., 10., "y", 5, 0., 5. );
+        m_empty = book( m_name, "empty", "x", 10, 0., 10. );
+        return StatusCode::SUCCESS;
+      }
+
+      // unweighted fills first, then weighted ones, then unweighted again
+      void fill() {
+        for ( int i = 0; i < 20; ++i ) {
+          m_h1->Fill( 0.5*i );
+          m_h2->Fill( 0.5*i, 0.25*i );
+        }
+        const double weights[] = { 0.5, 2., 1., 1.5 };
+        for ( int i = 0; i < 20; ++i ) {
+          m_h1->Fill( 0.5*i, weights[i%4] );
+          m_h2->Fill( 0.5*i, 0.25*i, weights[i%4] );
+        }
+        for ( int i = 0; i < 5; ++i ) m_h1->Fill( 2.*i );
+        m_h1->Fill( -1. );
+        m_h1->Fill( 11., 3. );
+      }
+
+      std::vector<TH1*> hists() const { return { m_h1, m_h2, m_empty }; }
+
+    private:
+      TH1F* m_h1 = nullptr;
+      TH2F* m_h2 = nullptr;
+      TH1F* m_empty = nullptr;
+  };
+
+  void compare( const TH1* hist, const TH1* reference, const std::string& what ) {
+    check( hist->GetNcells() == reference->GetNcells(), what + ": number of cells" );
+    if ( hist->GetNcells() != reference->GetNcells() ) return;
+    bool sameBins = true;
+    for ( Int_t bin = 0; bin < reference->GetNcells(); ++bin ) {
+      sameBins = sameBins && close( hist->GetBinContent( bin ), reference->GetBinContent( bin ) )
+                          && close( hist->GetBinError( bin ), reference->GetBinError( bin ) );
+    }
+    check( sameBins, what + ": bin contents and errors" );
+    check( close( hist->GetEntries(), reference->GetEntries() ), what + ": entries" );
+    check( close( hist->GetSumOfWeights(), reference->GetSumOfWeights() ), what + ": sum of weights" );
+  }
+
+  // the histogram as written out, read back
+  template<class HIST>
+  HIST readBack( TH1* hist ) {
+    TBufferFile buffer( TBuffer::kWrite );
+    hist->Streamer( buffer );
+    buffer.SetReadMode();
+    buffer.SetBufferOffset( 0 );
+    HIST copy;
+    copy.Streamer( buffer );
+    return copy;
+  }
+
+  void compareOutput( TH1* hist, TH1* reference, const std::string& what ) {
+    if ( dynamic_cast<TH2F*>( reference ) ) {
+      const TH2F output = readBack<TH2F>( hist );
+      check( output.GetSumw2N() == reference->GetSumw2N(), what + ": Sumw2 written" );
+      compare( &output, reference, what + " (written)" );
+    }
+    else {
+      const TH1F output = readBack<TH1F>( hist );
+      check( output.GetSumw2N() == reference->GetSumw2N(), what + ": Sumw2 written" );
+      compare( &output, reference, what + " (written)" );
+    }
+  }
+
+}
+
+int main() {
+
+  TH1::AddDirectory( kFALSE );
+  TH1::SetDefaultSumw2( kTRUE );
+
+  TestHists eager( "eager" );
+  if ( !eager.initialize().isSuccess() ) return 1;
+  eager.fill();
+
+  struct Config { std::string name; bool lazy; xAH::HistStorage storage; };
+  const std::vector<Config> configs = {
+    { "lazy",   true,  xAH::HistStorage::Dense  },
+    { "sparse", false, xAH::HistStorage::Sparse },
+    { "counts", false, xAH::HistStorage::Counts }
+  };
+
+  for ( const auto& config : configs ) {
+    TestHists hists( config.name );
+    hists.setLazyBooking( config.lazy );
+    hists.setStorage( config.storage );
+    if ( !hists.initialize().isSuccess() ) return 1;
+
+    hists.fill();
+    for ( std::size_t i = 0; i < eager.hists().size(); ++i ) {
+      const std::string what = config.name + " " + eager.hists()[i]->GetTitle();
+      compare( hists.hists()[i], eager.hists()[i], what );
+      compareOutput( hists.hists()[i], eager.hists()[i], what );
+    }
+  }
+
+  if ( nFailures ) {
+    std::cerr << nFailures << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "All checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,93 @@
+/********************************************************************************
+ *
+ * ut_InputCache
+ *
+ * Unit test of the matching of the input branches to the declared inputs in
+ * InputCache: the interface, static and dynamic aux branches of a container,
+ * wildcards, and inputs restricted to one aux variable.
+ *
+ ********************************************************************************/
+
+// c++ include(s):
+#include <iostream>
+#include <string>
+#include <vector>
+
+// package include(s):
+#include "xAODAnaHelpers/InputCache.h"
+
+namespace {
+
+  int nFailures = 0;
+
+  void check( bool condition, const std::string& what ) {
+    if ( condition ) return;
+    std::cerr << "FAILED: " << what << std::endl;
+    ++nFailures;
+  }
+
+  void checkSplit( const std::string& branchName, const std::string& container, const std::string& variable ) {
+    const InputCache::Input input = InputCache::splitBranchName( branchName );
+    check( input.container == container && input.variable == variable,
+           "splitBranchName(" + branchName + "): expected " + container + " / " + variable + ", got " + input.container + " / " + input.variable );
+  }
+
+  void checkMatch( const std::string& inputs, const std::string& branchName, bool expected ) {
+    check( InputCache::matches( InputCache::parseInputs( inputs ), branchName ) == expected,
+           "'" + inputs + "' should " + ( expected ? "" : "not " ) + "match " + branchName );
+  }
+
+}
+
+int main() {
+
+  // parsing of the declared inputs
+  {
+    const std::vector<InputCache::Input> inputs = InputCache::parseInputs( " AntiKt4EMTopoJets  Muons.pt\t*TrackParticles " );
+    check( inputs.size() == 3, "three inputs parsed" );
+    if ( inputs.size() == 3 ) {
+      check( inputs[0].container == "AntiKt4EMTopoJets" && inputs[0].variable.empty(), "container input" );
+      check( inputs[1].container == "Muons" && inputs[1].variable == "pt", "Container.variable input" );
+      check( inputs[2].container == "*TrackParticles" && inputs[2].variable.empty(), "wildcard input" );
+    }
+    check( InputCache::parseInputs( "" ).empty(), "no inputs" );
+  }
+
+  // the container and aux variable of a branch
+  checkSplit( "AntiKt4EMTopoJets",              "AntiKt4EMTopoJets", "" );
+  checkSplit( "AntiKt4EMTopoJetsAux.",          "AntiKt4EMTopoJets", "" );
+  checkSplit( "AntiKt4EMTopoJetsAuxDyn.Jvt",    "AntiKt4EMTopoJets", "Jvt" );
+  checkSplit( "EventInfoAuxDyn.mcEventWeights", "EventInfo",         "mcEventWeights" );
+  checkSplit( "Aux.",                           "Aux.",              "" );
+
+  // a container: all of its branches, and nothing else
+  checkMatch( "AntiKt4EMTopoJets", "AntiKt4EMTopoJets",           true );
+  checkMatch( "AntiKt4EMTopoJets", "AntiKt4EMTopoJetsAux.",       true );
+  checkMatch( "AntiKt4EMTopoJets", "AntiKt4EMTopoJetsAuxDyn.Jvt", true );
+  checkMatch( "AntiKt4EMTopoJets", "AntiKt4EMPFlowJetsAuxDyn.Jvt", false );
+  checkMatch( "AntiKt4EMTopoJets", "AntiKt4EMTopoJets_BTaggingAux.", false );
+  checkMatch( "Electrons Muons",   "MuonsAuxDyn.ptcone20",        true );
+  checkMatch( "",                  "Muons",                       false );
+
+  // wildcards, in the container and the variable
+  checkMatch( "*TrackParticles", "InDetTrackParticlesAuxDyn.d0", true );
+  checkMatch( "*TrackParticles", "CombinedMuonTrackParticles",   true );
+  checkMatch( "*TrackParticles", "Muons",                        false );
+  checkMatch( "AntiKt4*Jets",    "AntiKt4EMPFlowJetsAux.",       true );
+  checkMatch( "Muons.pt*",       "MuonsAuxDyn.ptcone20",         true );
+  checkMatch( "Muons.pt*",       "MuonsAuxDyn.eta",              false );
+
+  // Container.variable: that dynamic variable, and the branches of the container that are not dynamic variables
+  checkMatch( "Muons.pt", "MuonsAuxDyn.pt",  true );
+  checkMatch( "Muons.pt", "MuonsAuxDyn.eta", false );
+  checkMatch( "Muons.pt", "Muons",           true );
+  checkMatch( "Muons.pt", "MuonsAux.",       true );
+  checkMatch( "Muons.pt", "ElectronsAuxDyn.pt", false );
+
+  if ( nFailures ) {
+    std::cerr << nFailures << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "All checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,451 @@
+/********************************************************************************
+ *
+ * xAODAnaHelpers_benchmarks
+ *
+ * Micro-benchmarks of the per-event hot paths of xAODAnaHelpers, run on synthetic
+ * in-memory xAOD containers so that no input file (and no EventLoop job) is needed.
+ *
+ *   xAODAnaHelpers_benchmarks [--events N] [--repeat N] [--warmup N] [--seed N]
+ *                             [--filter <substring>] [--json <file>]
+ *
+ * Every benchmark is run over the same set of events --warmup times, then --repeat
+ * times; the time of each repetition is divided by the number of events (and of
+ * objects) and the median, minimum, mean and median absolute deviation over the
+ * repetitions are reported, on the terminal and optionally in a JSON file that
+ * can be compared between releases.
+ *
+ ********************************************************************************/
+
+// c++ include(s):
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ROOT include(s):
+#include <TH1.h>
+#include <TTree.h>
+
+// EDM include(s):
+#include "xAODRootAccess/Init.h"
+#include "xAODRootAccess/TStore.h"
+#include "xAODEventInfo/EventInfo.h"
+#include "xAODEventInfo/EventAuxInfo.h"
+#include "xAODJet/JetContainer.h"
+#include "xAODJet/JetAuxContainer.h"
+#include "xAODEgamma/ElectronContainer.h"
+#include "xAODEgamma/ElectronAuxContainer.h"
+#include "xAODMuon/MuonContainer.h"
+#include "xAODMuon/MuonAuxContainer.h"
+#include "xAODTracking/TrackParticleContainer.h"
+#include "xAODTracking/TrackParticleAuxContainer.h"
+#include "AthContainers/ConstDataVector.h"
+
+// package include(s):
+#include "xAODAnaHelpers/HelperFunctions.h"
+#include "xAODAnaHelpers/HelperClasses.h"
+#include "xAODAnaHelpers/HelpTreeBase.h"
+#include "xAODAnaHelpers/JetHists.h"
+#include "xAODAnaHelpers/CutOrderOptimizer.h"
+#include "xAODAnaHelpers/JetReclusteringEngine.h"
+#include "xAODAnaHelpers/MemoryRegistry.h"
+
+namespace {
+
+  typedef std::chrono::steady_clock Clock;
+
+  /** one synthetic event: the containers own their objects and aux stores */
+  struct SyntheticEvent {
+    xAOD::JetContainer*           jets      = nullptr;
+    xAOD::ElectronContainer*      electrons = nullptr;
+    xAOD::MuonContainer*          muons     = nullptr;
+    xAOD::TrackParticleContainer* tracks    = nullptr;
+  };
+
+  /** a benchmark: called once per event, returns the number of objects it processed */
+  struct Benchmark {
+    std::string name;
+    std::function<std::size_t( const SyntheticEvent& )> run;
+  };
+
+  struct Result {
+    std::string name;
+    double objectsPerEvent = 0.;
+    double median = 0.;   // [ns/event]
+    double min    = 0.;   // [ns/event]
+    double mean   = 0.;   // [ns/event]
+    double mad    = 0.;   // [ns/event]
+  };
+
+  /**
+      Build the containers of nEvents events, with multiplicities and spectra roughly those of a
+      2-lepton analysis after the derivation: steeply falling pT, flat eta, Poisson multiplicities.
+   */
+  std::vector<SyntheticEvent> makeEvents( unsigned int nEvents, unsigned int seed ) {
+
+    std::mt19937_64 rng( seed );
+    std::poisson_distribution<int>         nJets( 6. ), nElectrons( 1.5 ), nMuons( 1.5 ), nTracks( 250. );
+    std::exponential_distribution<double>  jetPt( 1. / 40e3 ), lepPt( 1. / 25e3 ), trkPt( 1. / 2e3 );
+    std::uniform_real_distribution<double> flat( 0., 1. );
+
+    auto uniform = [&]( double lo, double hi ) { return lo + ( hi - lo ) * flat( rng ); };
+
+    static SG::AuxElement::Decorator<char>  passSelDecor( "passSel" );
+    static SG::AuxElement::Decorator<float> jvtDecor( "Jvt" );
+    static SG::AuxElement::Decorator<float> detEtaDecor( "DetectorEta" );
+
+    std::vector<SyntheticEvent> events( nEvents );
+    for ( auto& event : events ) {
+
+      event.jets = new xAOD::JetContainer();
+      event.jets->setStore( new xAOD::JetAuxContainer() );
+      for ( int i = 0, n = nJets( rng ); i < n; ++i ) {
+        xAOD::Jet* jet = new xAOD::Jet();
+        event.jets->push_back( jet );
+        const double pt  = 20e3 + jetPt( rng );
+        const double eta = uniform( -4.5, 4.5 );
+        jet->setJetP4( xAOD::JetFourMom_t( pt, eta, uniform( -M_PI, M_PI ), uniform( 0.05, 0.15 ) * pt ) );
+        jvtDecor( *jet )    = flat( rng );
+        detEtaDecor( *jet ) = eta + uniform( -0.05, 0.05 );
+        passSelDecor( *jet ) = ( pt > 25e3 && std::fabs( eta ) < 2.8 );
+      }
+
+      event.electrons = new xAOD::ElectronContainer();
+      event.electrons->setStore( new xAOD::ElectronAuxContainer() );
+      for ( int i = 0, n = nElectrons( rng ); i < n; ++i ) {
+        xAOD::Electron* el = new xAOD::Electron();
+        event.electrons->push_back( el );
+        const double pt = 7e3 + lepPt( rng );
+        el->setP4( pt, uniform( -2.47, 2.47 ), uniform( -M_PI, M_PI ), 0.511 );
+        passSelDecor( *el ) = ( pt > 10e3 );
+      }
+
+      event.muons = new xAOD::MuonContainer();
+      event.muons->setStore( new xAOD::MuonAuxContainer() );
+      for ( int i = 0, n = nMuons( rng ); i < n; ++i ) {
+        xAOD::Muon* mu = new xAOD::Muon();
+        event.muons->push_back( mu );
+        const double pt = 5e3 + lepPt( rng );
+        mu->setP4( pt, uniform( -2.7, 2.7 ), uniform( -M_PI, M_PI ) );
+        passSelDecor( *mu ) = ( pt > 10e3 );
+      }
+
+      event.tracks = new xAOD::TrackParticleContainer();
+      event.tracks->setStore( new xAOD::TrackParticleAuxContainer() );
+      for ( int i = 0, n = nTracks( rng ); i < n; ++i ) {
+        xAOD::TrackParticle* trk = new xAOD::TrackParticle();
+        event.tracks->push_back( trk );
+        const double pt    = 400. + trkPt( rng );
+        const double theta = 2. * std::atan( std::exp( -uniform( -2.5, 2.5 ) ) );
+        const double sign  = ( flat( rng ) < 0.5 ) ? -1. : 1.;
+        trk->setDefiningParameters( uniform( -1., 1. ), uniform( -100., 100. ), uniform( -M_PI, M_PI ), theta, sign * std::sin( theta ) / pt );
+        passSelDecor( *trk ) = ( pt > 1e3 );
+      }
+
+    }
+
+    return events;
+  }
+
+  double median( std::vector<double> values ) {
+    if ( values.empty() ) return 0.;
+    std::sort( values.begin(), values.end() );
+    const std::size_t n = values.size();
+    return ( n % 2 ) ? values[n/2] : 0.5 * ( values[n/2 - 1] + values[n/2] );
+  }
+
+  Result runBenchmark( const Benchmark& benchmark, const std::vector<SyntheticEvent>& events, unsigned int nWarmup, unsigned int nRepeat ) {
+
+    std::size_t nObjects = 0;
+    auto pass = [&]() {
+      nObjects = 0;
+      const auto start = Clock::now();
+      for ( const auto& event : events ) nObjects += benchmark.run( event );
+      return std::chrono::duration<double, std::nano>( Clock::now() - start ).count() / events.size();
+    };
+
+    for ( unsigned int i = 0; i < nWarmup; ++i ) pass();
+
+    std::vector<double> times;
+    times.reserve( nRepeat );
+    for ( unsigned int i = 0; i < nRepeat; ++i ) times.push_back( pass() );
+
+    Result result;
+    result.name            = benchmark.name;
+    result.objectsPerEvent = static_cast<double>( nObjects ) / events.size();
+    result.median          = median( times );
+    result.min             = *std::min_element( times.begin(), times.end() );
+    double sum = 0.;
+    for ( double t : times ) sum += t;
+    result.mean = sum / times.size();
+    std::vector<double> deviations;
+    for ( double t : times ) deviations.push_back( std::fabs( t - result.median ) );
+    result.mad = median( deviations );
+    return result;
+  }
+
+  bool writeJSON( const std::string& fileName, const std::vector<Result>& results, unsigned int nEvents, unsigned int nRepeat, unsigned int seed ) {
+    std::ofstream out( fileName );
+    if ( !out.is_open() ) return false;
+
+    out << "{\n  \"events\": " << nEvents << ", \"repeat\": " << nRepeat << ", \"seed\": " << seed << ",\n  \"benchmarks\": [\n";
+    for ( std::size_t i = 0; i < results.size(); ++i ) {
+      const Result& r = results[i];
+      out << "    {\"name\": \"" << r.name << "\", \"objects_per_event\": " << r.objectsPerEvent
+          << ", \"median_ns_per_event\": " << r.median << ", \"min_ns_per_event\": " << r.min
+          << ", \"mean_ns_per_event\": " << r.mean << ", \"mad_ns_per_event\": " << r.mad
+          << ", \"median_ns_per_object\": " << ( ( r.objectsPerEvent > 0. ) ? r.median / r.objectsPerEvent : 0. ) << "}"
+          << ( ( i + 1 < results.size() ) ? ",\n" : "\n" );
+    }
+    out << "  ]\n}\n";
+    return out.good();
+  }
+
+  void usage( const char* exe ) {
+    std::cout << "usage: " << exe << " [--events N] [--repeat N] [--warmup N] [--seed N] [--filter <substring>] [--json <file>]\n"
+              << "  --events  number of synthetic events (default 2000)\n"
+              << "  --repeat  number of timed passes over the events per benchmark (default 20)\n"
+              << "  --warmup  number of untimed passes before the timed ones (default 3)\n"
+              << "  --seed    seed of the event generation (default 12345)\n"
+              << "  --filter  only run the benchmarks whose name contains this string\n"
+              << "  --json    also write the results to this JSON file\n";
+  }
+
+}
+
+int main( int argc, char* argv[] ) {
+
+  unsigned int nEvents(2000), nRepeat(20), nWarmup(3), seed(12345);
+  std::string filter(""), jsonFile("");
+
+  for ( int i = 1; i < argc; ++i ) {
+    const std::string arg = argv[i];
+    if ( arg == "-h" || arg == "--help" ) { usage( argv[0] ); return 0; }
+    if ( i + 1 >= argc ) { usage( argv[0] ); return 1; }
+    if      ( arg == "--events" ) nEvents  = std::stoul( argv[++i] );
+    else if ( arg == "--repeat" ) nRepeat  = std::stoul( argv[++i] );
+    else if ( arg == "--warmup" ) nWarmup  = std::stoul( argv[++i] );
+    else if ( arg == "--seed" )   seed     = std::stoul( argv[++i] );
+    else if ( arg == "--filter" ) filter   = argv[++i];
+    else if ( arg == "--json" )   jsonFile = argv[++i];
+    else { usage( argv[0] ); return 1; }
+  }
+  if ( nEvents == 0 || nRepeat == 0 ) { usage( argv[0] ); return 1; }
+
+  if ( !xAOD::Init( "xAODAnaHelpers_benchmarks" ).isSuccess() ) return 1;
+  TH1::AddDirectory( kFALSE );
+
+  // the store the algorithms record their per-event objects in; the synthetic containers themselves are not in it
+  xAOD::TStore store;
+
+  xAOD::EventInfo* eventInfo = new xAOD::EventInfo();
+  eventInfo->setStore( new xAOD::EventAuxInfo() );
+  eventInfo->setEventTypeBitmask( xAOD::EventInfo::IS_SIMULATION );
+  if ( !store.record( eventInfo, "EventInfo" ).isSuccess() ) return 1;
+
+  std::cout << "Generating " << nEvents << " synthetic events (seed " << seed << ")" << std::endl;
+  const std::vector<SyntheticEvent> events = makeEvents( nEvents, seed );
+
+  // a realistic number of objects in the store for the retrieval benchmark
+  const std::vector<std::string> storeKeys = { "SelectedJets", "SelectedElectrons", "SelectedMuons", "SelectedTracks" };
+  for ( const auto& key : storeKeys ) {
+    for ( const std::string syst : { "", "_JET_JER__1up", "_EG_SCALE_ALL__1down", "_MUON_ID__1up" } ) {
+      if ( !store.record( new ConstDataVector<xAOD::JetContainer>( SG::VIEW_ELEMENTS ), key + syst ).isSuccess() ) return 1;
+    }
+  }
+
+  // n-tuple filling (kept in memory: only the Fill* calls are timed, not the TTree::Fill)
+  TTree* tree = new TTree( "nominal", "benchmark tree" );
+  HelpTreeBase helpTree( tree, nullptr, nullptr, &store );
+  helpTree.AddJets( "kinematic" );
+  helpTree.AddElectrons( "kinematic" );
+  helpTree.AddMuons( "kinematic" );
+
+  JetHists jetHists( "benchmark/", "kinematic" );
+  if ( !jetHists.initialize().isSuccess() ) return 1;
+
+  // the kinematic cut chain run by the selectors' passCuts, in a deliberately poor default order
+  enum class BenchCut { jvt, eta, ptmin, NCuts };
+  static SG::AuxElement::ConstAccessor<float> jvtAcc( "Jvt" );
+  auto applyCut = []( BenchCut cut, const xAOD::Jet* jet ) {
+    switch ( cut ) {
+      case BenchCut::jvt   : return ( jet->pt() > 60e3 || std::fabs( jet->eta() ) > 2.4 || jvtAcc( *jet ) > 0.59 );
+      case BenchCut::eta   : return ( std::fabs( jet->eta() ) < 2.5 );
+      case BenchCut::ptmin : return ( jet->pt() > 50e3 );
+      default              : return true;
+    }
+  };
+  const std::vector<BenchCut> defaultOrder = { BenchCut::jvt, BenchCut::eta, BenchCut::ptmin };
+  const std::vector<std::string> cutLabels = { "jvt", "eta", "ptmin" };
+  xAH::CutOrderOptimizer<BenchCut> fixedOrder, adaptiveOrder;
+  fixedOrder.setOrder( defaultOrder, cutLabels );
+  adaptiveOrder.setLearningEvents( std::min( 200u, nEvents ) );
+  adaptiveOrder.setOrder( defaultOrder, cutLabels );
+
+  auto passCuts = [&applyCut]( xAH::CutOrderOptimizer<BenchCut>& cutOrder, const xAOD::JetContainer* jets ) {
+    std::size_t nPass = 0;
+    for ( auto jet : *jets ) {
+      bool pass = true;
+      for ( auto cut : cutOrder.order() ) {
+        auto start = cutOrder.start();
+        pass = applyCut( cut, jet );
+        cutOrder.record( cut, pass, start );
+        if ( !pass ) break;
+      }
+      nPass += pass;
+    }
+    cutOrder.nextEvent();
+    return nPass;
+  };
+
+  xAH::JetReclusteringEngine rcEngine( 1.0, 0.05 );
+
+  const std::vector<Benchmark> benchmarks = {
+
+    { "makeSubsetCont_jets_passSel", [&]( const SyntheticEvent& event ) {
+        ConstDataVector<xAOD::JetContainer> selected( SG::VIEW_ELEMENTS );
+        ConstDataVector<xAOD::JetContainer>* out = &selected;
+        xAOD::JetContainer* in = event.jets;
+        HelperFunctions::makeSubsetCont( in, out, "passSel", HelperClasses::ToolName::SELECTOR ).ignore();
+        return event.jets->size();
+      } },
+
+    { "makeSubsetCont_tracks_passSel", [&]( const SyntheticEvent& event ) {
+        ConstDataVector<xAOD::TrackParticleContainer> selected( SG::VIEW_ELEMENTS );
+        ConstDataVector<xAOD::TrackParticleContainer>* out = &selected;
+        xAOD::TrackParticleContainer* in = event.tracks;
+        HelperFunctions::makeSubsetCont( in, out, "passSel", HelperClasses::ToolName::SELECTOR ).ignore();
+        return event.tracks->size();
+      } },
+
+    { "retrieve_TStore", [&]( const SyntheticEvent& ) {
+        std::size_t n = 0;
+        for ( const auto& key : storeKeys ) {
+          ConstDataVector<xAOD::JetContainer>* cont( nullptr );
+          n += HelperFunctions::retrieve( cont, key, nullptr, &store ).isSuccess();
+        }
+        return n;
+      } },
+
+    { "pt_order_jets_leading2", [&]( const SyntheticEvent& event ) {
+        // the ordering is cached in the store until the end of the event
+        const std::vector<unsigned int>* order = HelperFunctions::pt_order( event.jets, "benchJets", &store, 2 );
+        store.remove( "ptOrder_benchJets" ).ignore();
+        return ( order ) ? event.jets->size() : 0;
+      } },
+
+    { "jetReclustering_R10", [&]( const SyntheticEvent& event ) {
+        return HelperFunctions::jetReclustering( event.jets, 1.0, 0.05 ).size();
+      } },
+
+    { "JetReclusteringEngine_recluster_R10", [&]( const SyntheticEvent& event ) {
+        return rcEngine.recluster( event.jets ).size();
+      } },
+
+    { "jetTrimming_R10", [&]( const SyntheticEvent& event ) {
+        return HelperFunctions::jetTrimming( event.jets, 0.3, 0.05 ).size();
+      } },
+
+    { "JetHists_kinematic", [&]( const SyntheticEvent& event ) {
+        jetHists.execute( event.jets, 1.0, eventInfo ).ignore();
+        return event.jets->size();
+      } },
+
+    { "HelpTreeBase_FillJets_kinematic", [&]( const SyntheticEvent& event ) {
+        helpTree.FillJets( event.jets );
+        return event.jets->size();
+      } },
+
+    { "HelpTreeBase_FillElectrons_kinematic", [&]( const SyntheticEvent& event ) {
+        helpTree.FillElectrons( event.electrons, nullptr );
+        return event.electrons->size();
+      } },
+
+    { "HelpTreeBase_FillMuons_kinematic", [&]( const SyntheticEvent& event ) {
+        helpTree.FillMuons( event.muons, nullptr );
+        return event.muons->size();
+      } },
+
+    { "passCuts_jets_defaultOrder", [&]( const SyntheticEvent& event ) {
+        passCuts( fixedOrder, event.jets );
+        return event.jets->size();
+      } },
+
+    { "passCuts_jets_adaptiveOrder", [&]( const SyntheticEvent& event ) {
+        passCuts( adaptiveOrder, event.jets );
+        return event.jets->size();
+      } },
+
+  };
+
+  std::vector<Result> results;
+  for ( const auto& benchmark : benchmarks ) {
+    if ( !filter.empty() && benchmark.name.find( filter ) == std::string::npos ) continue;
+    results.push_back( runBenchmark( benchmark, events, nWarmup, nRepeat ) );
+  }
+
+  std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12) << "obj/event"
+            << std::setw(14) << "median [ns]" << std::setw(14) << "min [ns]" << std::setw(14) << "MAD [ns]" << std::setw(14) << "ns/object" << "\n";
+  std::cout << std::fixed << std::setprecision(1);
+  for ( const auto& r : results ) {
+    std::cout << std::left << std::setw(40) << r.name << std::right << std::setw(12) << r.objectsPerEvent
+              << std::setw(14) << r.median << std::setw(14) << r.min << std::setw(14) << r.mad
+              << std::setw(14) << ( ( r.objectsPerEvent > 0. ) ? r.median / r.objectsPerEvent : 0. ) << "\n";
+  }
+  std::cout << "(times per event, over " << nRepeat << " passes on " << nEvents << " events)" << std::endl;
+
+  if ( !jsonFile.empty() ) {
+    if ( !writeJSON( jsonFile, results, nEvents, nRepeat, seed ) ) {
+      std::cerr << "Could not write " << jsonFile << std::endl;
+      return 1;
+    }
+    std::cout << "Results written to " << jsonFile << std::endl;
+  }
+
+  // memory of the JetHists sets of a 100-systematic job where only 10 variations ever have jets to fill, in each storage
+  if ( filter.empty() || std::string( "JetHists_booking_100syst" ).find( filter ) != std::string::npos ) {
+    std::cout << "\nJetHists booking, 100 systematics of which 10 are filled:\n";
+    const std::vector<std::pair<std::string, xAH::HistStorage> > configs = {
+      { "eager", xAH::HistStorage::Dense }, { "lazy", xAH::HistStorage::Dense }, { "sparse", xAH::HistStorage::Sparse }, { "counts", xAH::HistStorage::Counts } };
+    for ( const auto& config : configs ) {
+      const double heapBefore = xAH::MemoryRegistry::heapInUse();
+      std::vector<JetHists*> systHists;
+      for ( int i = 0; i < 100; ++i ) {
+        JetHists* hists = new JetHists( "syst" + std::to_string( i ) + "/", "kinematic clean energy layer trackPV JVT flavorTag truth" );
+        hists->setLazyBooking( config.first == "lazy" );
+        hists->setStorage( config.second );
+        if ( !hists->initialize().isSuccess() ) return 1;
+        systHists.push_back( hists );
+      }
+      for ( int i = 0; i < 10; ++i ) {
+        for ( const auto& event : events ) systHists[i]->execute( event.jets, 1.0, eventInfo ).ignore();
+      }
+      const double heapAfter = xAH::MemoryRegistry::heapInUse();
+
+      HistogramManager::MemoryUsage usage;
+      for ( auto hists : systHists ) usage += hists->memoryUsage();
+      std::cout << std::setprecision(1) << "  " << std::left << std::setw(6) << config.first << std::right << ": " << usage.allocated << " of " << usage.booked
+                << " histograms allocated, " << usage.allocatedBytes / 1048576. << " MB of bins, " << ( heapAfter - heapBefore ) / 1048576.
+                << " MB of heap" << std::endl;
+
+      // the histograms are kept until the end of the program, like the outputs of an EventLoop job
+    }
+  }
+
+  for ( auto& event : events ) {
+    delete event.jets->getStore(); delete event.jets;
+    delete event.electrons->getStore(); delete event.electrons;
+    delete event.muons->getStore(); delete event.muons;
+    delete event.tracks->getStore(); delete event.tracks;
+  }
+
+  return 0;
+}
@@ -25,6 +25,9 @@
 #include <AsgTools/MsgStreamMacros.h>
 #include <AsgTools/MessageCheck.h>
 
+// per-systematic timing
+#include "xAODAnaHelpers/TimingRegistry.h"
+
 namespace xAH {
 
     /**
@@ -120,6 +123,19 @@ namespace xAH {
          */
         StatusCode parseSystValVector();
 
+        /**
+            @rst
+                The input containers this algorithm reads, as space-separated names. A name can contain the wildcards of ``fnmatch``
+                (``*TrackParticles``) and can be restricted to some aux variables with ``Container.variable``. Only the options are
+                used, so that it can be called on the submission node (``xAH_run.py --inputReport``).
+
+                ``*`` means the algorithm may read anything: this is what is returned unless the algorithm overrides it. The inputs of
+                all the algorithms of a job are kept, and the other branches disabled, by :cpp:class:`InputCache` (``xAH_run.py --pruneInputs``).
+
+            @endrst
+         */
+        virtual std::string declaredInputs() const;
+
         /** If the xAOD has a different EventInfo container name, set it here */
         std::string m_eventInfoContainerName = "EventInfo";
 
@@ -256,6 +272,39 @@ namespace xAH {
         template <typename T>
 	void setToolName(__attribute__((unused)) asg::AnaToolHandle<T>& handle, __attribute__((unused)) const std::string& name = "") const { }
 
+        /**
+            @rst
+                Resolve the timers used by :cpp:func:`xAH::Algorithm::timeSystematic`, one per entry of ``systList`` (a list of
+                ``CP::SystematicSet``), when the timing of the job is enabled (see :cpp:class:`AlgorithmTimer`). Call it in ``initialize()``,
+                once the list of systematics is final.
+
+            @endrst
+         */
+        template< typename SystList >
+        void setSystematicTimers( const SystList& systList ) {
+          m_systTimers.clear();
+          if ( !xAH::TimingRegistry::enabled() ) return;
+          for ( const auto& syst : systList ) {
+            m_systTimers.push_back( xAH::TimingRegistry::stats( m_name, "execute", syst.name().empty() ? "nominal" : syst.name() ) );
+          }
+        }
+
+        /**
+            @rst
+                Time the iteration ``iSyst`` of a loop over the systematics given to :cpp:func:`xAH::Algorithm::setSystematicTimers`, and
+                do nothing if the timing is disabled. The time is accumulated until the returned object goes out of scope::
+
+                    for ( std::size_t iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
+                      auto systTimer = this->timeSystematic( iSyst );
+                      // ...
+                    }
+
+            @endrst
+         */
+        xAH::ScopedTimer timeSystematic( std::size_t iSyst ) const {
+          return xAH::ScopedTimer( ( iSyst < m_systTimers.size() ) ? m_systTimers[iSyst] : nullptr );
+        }
+
         /// @brief Return a ``std::string`` representation of ``this``
         std::string getAddress() const {
           const void * address = static_cast<const void*>(this);
@@ -292,6 +341,9 @@ namespace xAH {
             @endrst
          */
         std::map<std::string, bool> m_toolAlreadyUsed; //!
+
+        /// @brief the timers of :cpp:func:`xAH::Algorithm::timeSystematic`, parallel to the list of systematics
+        std::vector<xAH::LatencyStats*> m_systTimers; //!
   };
 
 }
@@ -0,0 +1,88 @@
+#ifndef xAODAnaHelpers_AlgorithmTimer_H
+#define xAODAnaHelpers_AlgorithmTimer_H
+
+// algorithm wrapper
+#include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/TimingRegistry.h"
+#include "xAODAnaHelpers/MemoryRegistry.h"
+
+/**
+  @rst
+    Timing probe: measures the time spent in the ``execute()`` and ``postExecute()`` of the algorithm run right before it.
+
+    ``xAH_run.py --timing`` puts one probe in front of the first algorithm and one after each algorithm of the job, so that the time
+    between two consecutive probes is the time spent in the algorithm in between. The algorithms themselves are not modified, and
+    a probe costs two clock readings per event, which is reported as overhead in the summary. The probes also switch on the
+    per-systematic timing of the algorithms using :cpp:func:`xAH::Algorithm::timeSystematic`.
+
+    The last probe (:cpp:member:`~AlgorithmTimer::m_writeSummary`) prints one line per algorithm (mean, median, 95% and 99%
+    quantiles of the time per event) at the end of the job, saves the same content in the ``xAH_timing`` tree of the histogram
+    output and, optionally, in a JSON file.
+
+    With :cpp:member:`~AlgorithmTimer::m_doMemory` (``xAH_run.py --memory``), the probes also read the heap in use, so that the memory
+    allocated by each algorithm in ``histInitialize()``, ``initialize()`` and ``execute()`` is accounted for in :cpp:class:`xAH::MemoryRegistry`.
+    The last probe prints the memory summary and saves it in the ``xAH_memory`` and ``xAH_memory_events`` trees of the cutflow output stream.
+
+    .. note:: An algorithm rejecting the event with ``skipEvent()`` is not timed for that event, since the next probe is not run.
+
+  @endrst
+*/
+class AlgorithmTimer : public xAH::Algorithm
+{
+  public:
+    /// @brief Time the algorithms
+    bool m_doTiming = true;
+    /// @brief Name of the algorithm timed by this probe, i.e. the one run right before it. Empty for the first probe of the sequence
+    std::string m_timedAlgorithm = "";
+    /// @brief Print the timing summary and save it in the output at the end of the job (set for the last probe only)
+    bool m_writeSummary = false;
+    /// @brief If not empty, also write the timing summary to this JSON file
+    std::string m_jsonFile = "";
+
+    /// @brief Account for the heap allocated by the algorithms
+    bool m_doMemory = false;
+    /// @brief Read the memory usage in ``execute()`` only every this many events (the first event is always sampled)
+    int m_memorySampleInterval = 100;
+    /// @brief Output stream the memory summary trees are written to, together with the cutflow
+    std::string m_cutFlowStreamName = "cutflow";
+
+  private:
+    xAH::LatencyStats* m_executeStats = nullptr; //!
+    xAH::LatencyStats* m_postExecuteStats = nullptr; //!
+
+    static xAH::TimingRegistry::clock::time_point s_executeMark; //!
+    static xAH::TimingRegistry::clock::time_point s_postExecuteMark; //!
+
+    xAH::MemoryRegistry::Entry* m_executeMemory = nullptr; //!
+
+    static unsigned long long s_nEvents; //!
+    static bool   s_sampleEvent; //!
+    static double s_heapMark; //!
+    static double s_eventHeapStart; //!
+
+    /// @brief attribute the heap allocated since the previous probe to :cpp:member:`~AlgorithmTimer::m_timedAlgorithm`
+    void accountHeap( const std::string& step );
+
+  public:
+    // this is a standard constructor
+    AlgorithmTimer ();
+
+    // these are the functions inherited from Algorithm
+    virtual EL::StatusCode setupJob (EL::Job& job);
+    virtual EL::StatusCode fileExecute ();
+    virtual EL::StatusCode histInitialize ();
+    virtual EL::StatusCode changeInput (bool firstFile);
+    virtual EL::StatusCode initialize ();
+    virtual EL::StatusCode execute ();
+    virtual EL::StatusCode postExecute ();
+    virtual EL::StatusCode finalize ();
+    virtual EL::StatusCode histFinalize ();
+    virtual std::string declaredInputs () const;
+
+    /// @cond
+    // this is needed to distribute the algorithm to the workers
+    ClassDef(AlgorithmTimer, 1);
+    /// @endcond
+};
+
+#endif
@@ -11,6 +11,10 @@
 #ifndef xAODAnaHelpers_BasicEventSelection_H
 #define xAODAnaHelpers_BasicEventSelection_H
 
+// c++ include(s):
+#include <map>
+#include <set>
+
 // ROOT include(s):
 #include "TH1D.h"
 
@@ -184,6 +188,16 @@ class BasicEventSelection : public xAH::Algorithm
     /** Check for duplicated events in MC */
     bool m_checkDuplicatesMC = false;
 
+    /**
+      @rst
+        Write an index of the input file and entry of each event, sorted by run and event number, to the ``eventIndex`` and ``eventIndexFiles``
+        trees of the ``m_eventIndexStreamName`` stream. Give it to ``xAH_run.py --eventIndex`` together with ``--pickEvents`` to rerun on a few events only.
+      @endrst
+    */
+    bool m_writeEventIndex = false;
+    /// @brief Output stream of the event index
+    std::string m_eventIndexStreamName = "event_index";
+
   private:
 
     std::set<std::pair<uint32_t,uint32_t> > m_RunNr_VS_EvtNr; //!
@@ -243,6 +257,20 @@ class BasicEventSelection : public xAH::Algorithm
     int      m_duplRunNumber;
     long int m_duplEventNumber;
 
+    /** Event index, sorted and written out in finalize() */
+    struct EventIndexEntry {
+      uint32_t runNumber;
+      unsigned long long eventNumber;
+      uint32_t fileId;
+      long long entry;
+      bool operator<(const EventIndexEntry& other) const {
+        return runNumber < other.runNumber || ( runNumber == other.runNumber && eventNumber < other.eventNumber );
+      }
+    };
+    std::vector<EventIndexEntry> m_eventIndex; //!
+    std::map<uint32_t, std::string> m_eventIndexFiles; //!
+    uint32_t m_eventIndexFileId = 0; //!
+
     // variables that don't get filled at submission time should be
     // protected from being send from the submission node to the worker
     // node (done by the //!)
@@ -258,6 +286,9 @@ class BasicEventSelection : public xAH::Algorithm
     */
     StatusCode autoconfigurePileupRWTool();
 
+    /** @brief Sort the event index and write it to the ``m_eventIndexStreamName`` stream */
+    StatusCode writeEventIndex();
+
   public:
     // Tree *myTree; //!
     // TH1 *myHist; //!
@@ -276,6 +307,7 @@ class BasicEventSelection : public xAH::Algorithm
     virtual EL::StatusCode postExecute ();
     virtual EL::StatusCode finalize ();
     virtual EL::StatusCode histFinalize ();
+    virtual std::string declaredInputs () const;
 
     /// @cond
     // this is needed to distribute the algorithm to the workers
@@ -0,0 +1,173 @@
+#ifndef xAODAnaHelpers_CutOrderOptimizer_H
+#define xAODAnaHelpers_CutOrderOptimizer_H
+
+/** @file CutOrderOptimizer.h
+ *  @brief Reorder a chain of independent object cuts to minimise the time spent per object
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace xAH {
+
+  /**
+      @rst
+          Self-tuning order for the cuts applied by a selector ``passCuts()``.
+
+          The selection decision of an object is the logical AND of all its cuts, so when no cutflow is being filled the order in which the
+          cuts are evaluated does not change the result. During the first N events (see :cpp:func:`~xAH::CutOrderOptimizer::setLearningEvents`) the
+          cuts are run in their default order, and for each cut the number of evaluations, rejections and the time spent are recorded.
+          Afterwards the cuts are sorted by increasing *time per rejected object*, which is the order minimising the expected cost per
+          object for independent cuts, and that order is used for the rest of the job.
+
+          The enum must be an ``enum class`` whose last enumerator is ``NCuts`` (the same one used by :cpp:class:`xAH::CutflowCounter`)::
+
+              // initialize()
+              m_cutOrder.setOrder( { ElectronCut::author, ElectronCut::OQ, ... }, { "author_cut", "OQ_cut", ... } );
+              m_cutOrder.setLearningEvents( m_nAdaptiveCutOrderEvents );
+
+              // execute()
+              if ( m_cutOrder.nextEvent() ) { ANA_MSG_INFO( "New order of the cuts:\n" << m_cutOrder.summary() ); }
+
+              // passCuts()
+              for ( auto cut : m_cutOrder.order() ) {
+                auto start = m_cutOrder.start();
+                bool pass = this->applyCut( cut, ... );
+                m_cutOrder.record( cut, pass, start );
+                if ( !pass ) return 0;
+              }
+
+          The cuts must be pure predicates: the selectors decorate the object outside of the chain (the variables read by the cuts before it,
+          the tool decisions computed by the cuts after it, on the selected objects only), so the decorations do not depend on the order.
+          A cut which has to stay where it is can still be given as ``fixed`` to :cpp:func:`~xAH::CutOrderOptimizer::setOrder`: it keeps its
+          position in the chain, and the other cuts are only reordered between the fixed ones.
+
+      @endrst
+   */
+  template< typename CutEnum >
+  class CutOrderOptimizer {
+    public:
+      typedef std::chrono::steady_clock clock;
+
+      /** @brief number of cuts in the enum */
+      static constexpr std::size_t NCuts = static_cast<std::size_t>(CutEnum::NCuts);
+
+      /**
+          @brief set the default order of the cuts (and optionally their names, for printouts), and reset all the statistics
+          @param fixed  cuts which keep their position in the chain
+       */
+      void setOrder( const std::vector<CutEnum>& order, const std::vector<std::string>& labels = {}, const std::vector<CutEnum>& fixed = {} ) {
+        m_order = order;
+        m_labels.fill( "" );
+        for ( std::size_t i = 0; i < order.size() && i < labels.size(); ++i ) {
+          m_labels[ static_cast<std::size_t>(order[i]) ] = labels[i];
+        }
+        m_fixed.fill( false );
+        for ( auto cut : fixed ) m_fixed[ static_cast<std::size_t>(cut) ] = true;
+        m_stats.fill( Stats() );
+        m_nEvents = 0;
+        m_learning = ( m_learningEvents > 0 );
+      }
+
+      /** @brief number of events used to measure rejection and cost of every cut. Set it to zero to always use the default order */
+      void setLearningEvents( int nEvents ) {
+        m_learningEvents = nEvents;
+        m_learning = ( m_learningEvents > 0 && m_nEvents < m_learningEvents );
+      }
+
+      /** @brief the order the cuts should be evaluated in */
+      inline const std::vector<CutEnum>& order() const { return m_order; }
+
+      /** @brief true if ``cut`` keeps its position in the chain */
+      inline bool isFixed( CutEnum cut ) const { return m_fixed[ static_cast<std::size_t>(cut) ]; }
+
+      /** @brief true while the statistics are being collected */
+      inline bool isLearning() const { return m_learning; }
+
+      /** @brief timestamp to pass to :cpp:func:`xAH::CutOrderOptimizer::record` (only read while learning) */
+      inline clock::time_point start() const { return m_learning ? clock::now() : clock::time_point(); }
+
+      /** @brief book-keep the outcome of one evaluation of ``cut`` */
+      inline void record( CutEnum cut, bool pass, const clock::time_point& start ) {
+        if ( !m_learning ) return;
+        Stats& stats = m_stats[ static_cast<std::size_t>(cut) ];
+        stats.calls++;
+        if ( !pass ) stats.rejects++;
+        stats.time += std::chrono::duration<double>( clock::now() - start ).count();
+      }
+
+      /**
+          @brief Call once per event: when the learning phase is over, the cuts get reordered
+          @returns true if the order has been changed in this call
+       */
+      bool nextEvent() {
+        if ( !m_learning ) return false;
+        if ( ++m_nEvents < m_learningEvents ) return false;
+        m_learning = false;
+        // only the cuts between two fixed ones are sorted
+        auto first = m_order.begin();
+        while ( first != m_order.end() ) {
+          auto last = std::find_if( first, m_order.end(), [this]( CutEnum cut ) { return this->isFixed(cut); } );
+          std::stable_sort( first, last, [this]( CutEnum a, CutEnum b ) { return this->score(a) < this->score(b); } );
+          first = ( last == m_order.end() ) ? last : last + 1;
+        }
+        return true;
+      }
+
+      /** @brief fraction of the objects reaching ``cut`` that were rejected by it during the learning phase */
+      double rejection( CutEnum cut ) const {
+        const Stats& stats = m_stats[ static_cast<std::size_t>(cut) ];
+        return ( stats.calls ) ? static_cast<double>(stats.rejects) / stats.calls : 0.;
+      }
+
+      /** @brief average time [s] spent per evaluation of ``cut`` during the learning phase */
+      double cost( CutEnum cut ) const {
+        const Stats& stats = m_stats[ static_cast<std::size_t>(cut) ];
+        return ( stats.calls ) ? stats.time / stats.calls : 0.;
+      }
+
+      /** @brief one line per cut, in the current order, with the statistics collected during the learning phase (fixed cuts are starred) */
+      std::string summary() const {
+        std::stringstream ss;
+        for ( auto cut : m_order ) {
+          ss << "\t " << ( isFixed(cut) ? "* " : "  " ) << std::left << std::setw(16) << m_labels[ static_cast<std::size_t>(cut) ]
+             << " rejection: " << std::setw(10) << rejection(cut)
+             << " time/call [us]: " << 1e6 * cost(cut) << "\n";
+        }
+        return ss.str();
+      }
+
+    private:
+      struct Stats {
+        unsigned long long calls = 0;
+        unsigned long long rejects = 0;
+        double time = 0.;
+      };
+
+      /** @brief expected time spent per rejected object: cuts that never reject go last, in their default order */
+      double score( CutEnum cut ) const {
+        const Stats& stats = m_stats[ static_cast<std::size_t>(cut) ];
+        if ( stats.rejects == 0 ) return std::numeric_limits<double>::infinity();
+        return stats.time / stats.rejects;
+      }
+
+      std::vector<CutEnum> m_order;
+      std::array<Stats, NCuts> m_stats;
+      std::array<std::string, NCuts> m_labels;
+      std::array<bool, NCuts> m_fixed {};
+      int  m_learningEvents = 0;
+      int  m_nEvents = 0;
+      bool m_learning = false;
+  };
+
+}
+#endif
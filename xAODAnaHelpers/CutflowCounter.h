@@ -0,0 +1,109 @@
+#ifndef xAODAnaHelpers_CutflowCounter_H
+#define xAODAnaHelpers_CutflowCounter_H
+
+/** @file CutflowCounter.h
+ *  @brief Accumulate object-level cutflows in plain counters
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+#include <array>
+#include <cstddef>
+
+#include <TH1D.h>
+#include <TArrayD.h>
+
+namespace xAH {
+
+  /**
+      @rst
+          Per-instance object cutflow, indexed by a cut enum known at compile time.
+
+          The selectors used to call ``TH1::Fill`` on the shared object cutflow histogram after every single cut for every single object.
+          Instead, each selector now increments a plain counter per cut, and the counts are added to the histogram only once, in ``finalize()``,
+          by :cpp:func:`xAH::CutflowCounter::flush`. The resulting histogram (contents, errors, entries and statistics) is the same as filling it
+          with unit weights one object at a time.
+
+          The enum must be an ``enum class`` whose last enumerator is ``NCuts``::
+
+              enum class ElectronCut : unsigned int { all, author, ..., NCuts };
+
+              xAH::CutflowCounter<ElectronCut> m_el_cutflow; //!
+
+              // initialize()
+              m_el_cutflow.setHist( m_el_cutflowHist_1 );
+              m_el_cutflow.bookBin( ElectronCut::all, "all" );
+
+              // passCuts()
+              if ( m_useCutFlow ) m_el_cutflow.count( ElectronCut::all );
+
+              // finalize()
+              m_el_cutflow.flush();
+
+          A selector that was already run earlier in the job writes its cutflow to a second histogram (``cutflow_<obj>_2``). The labels
+          are then booked in both histograms, by calling :cpp:func:`~xAH::CutflowCounter::setHist` and
+          :cpp:func:`~xAH::CutflowCounter::bookBin` for each of them in turn, and the counts are flushed into the last one set.
+
+      @endrst
+   */
+  template< typename CutEnum >
+  class CutflowCounter {
+    public:
+      /** @brief number of cuts in the enum */
+      static constexpr std::size_t NCuts = static_cast<std::size_t>(CutEnum::NCuts);
+
+      CutflowCounter() { m_bins.fill(-1); m_counts.fill(0); }
+
+      /** @brief set the histogram the counts will be flushed into */
+      void setHist( TH1D* hist ) { m_hist = hist; }
+
+      /** @brief find (or create) the bin labelled ``label`` in the current histogram and associate it to ``cut`` */
+      int bookBin( CutEnum cut, const char* label ) {
+        int bin = m_hist->GetXaxis()->FindBin( label );
+        m_bins[ static_cast<std::size_t>(cut) ] = bin;
+        return bin;
+      }
+
+      /** @brief one more object survived ``cut`` */
+      inline void count( CutEnum cut ) { ++m_counts[ static_cast<std::size_t>(cut) ]; }
+
+      /** @brief number of objects counted so far (and not flushed yet) for ``cut`` */
+      inline unsigned long long counts( CutEnum cut ) const { return m_counts[ static_cast<std::size_t>(cut) ]; }
+
+      /** @brief add all the accumulated counts to the histogram, and reset the counters */
+      void flush() {
+        if ( !m_hist ) return;
+
+        // what TH1::Fill( bin, 1 ) would have done n times
+        double stats[4] = {0., 0., 0., 0.};
+        m_hist->GetStats( stats );
+        double entries = m_hist->GetEntries();
+        TArrayD* sumw2 = ( m_hist->GetSumw2N() ) ? m_hist->GetSumw2() : nullptr;
+
+        for ( std::size_t i = 0; i < NCuts; ++i ) {
+          const int bin = m_bins[i];
+          const double n = static_cast<double>( m_counts[i] );
+          if ( bin < 0 || n == 0. ) continue;
+
+          m_hist->AddBinContent( bin, n );
+          if ( sumw2 ) { sumw2->fArray[bin] += n; }
+          entries  += n;
+          stats[0] += n;
+          stats[1] += n;
+          stats[2] += n * bin;
+          stats[3] += n * bin * bin;
+        }
+
+        m_hist->PutStats( stats );
+        m_hist->SetEntries( entries );
+        m_counts.fill(0);
+      }
+
+    private:
+      TH1D* m_hist = nullptr;
+      std::array<int, NCuts> m_bins;
+      std::array<unsigned long long, NCuts> m_counts;
+  };
+
+}
+#endif
@@ -112,6 +112,7 @@ public:
   virtual EL::StatusCode postExecute ();
   virtual EL::StatusCode finalize ();
   virtual EL::StatusCode histFinalize ();
+  virtual std::string declaredInputs () const;
 
   /// @cond
   // this is needed to distribute the algorithm to the workers
@@ -11,9 +11,12 @@
 // EDM include(s):
 #include "xAODEgamma/ElectronContainer.h"
 #include "xAODTracking/Vertex.h"
+#include "xAODEventInfo/EventInfo.h"
 
 // package include(s):
 #include "xAODAnaHelpers/ParticlePIDManager.h"
+#include "xAODAnaHelpers/CutflowCounter.h"
+#include "xAODAnaHelpers/CutOrderOptimizer.h"
 
 // ROOT include(s):
 #include "TH1D.h"
@@ -50,6 +53,19 @@ public:
 
   bool m_useCutFlow = true;
 
+  /**
+    @rst
+      When no cutflow is filled (:cpp:member:`~ElectronSelector::m_useCutFlow` is ``false``), measure rejection and time per call of every cut
+      during the first :cpp:member:`~ElectronSelector::m_nAdaptiveCutOrderEvents` events, then apply the cuts in the order minimising the time
+      spent per electron. ``passSel`` is unchanged. The cuts do not decorate the electron: the track decorations (``z0sintheta``, ``d0sig``,
+      ``bLayerPass``) are set on every electron before the cuts, and the PID and isolation decisions computed by the cuts are decorated
+      after them, on the selected electrons only. The rejected electrons keep the PID defaults (-1) and no isolation decoration, in any order.
+    @endrst
+  */
+  bool m_adaptiveCutOrder = false;
+  /// @brief Number of events used to measure the cuts when :cpp:member:`~ElectronSelector::m_adaptiveCutOrder` is enabled
+  int  m_nAdaptiveCutOrderEvents = 100;
+
   /* configuration variables */
 
   /// @brief The name of the input container for this algorithm read from ``TEvent`` or ``TStore``
@@ -149,6 +165,15 @@ public:
   /** @brief Loosest cut-based PID operating point to save */
   std::string    m_CutBasedOperatingPoint = "Loose";
 
+  /**
+    @rst
+      When the PID tools are run (:cpp:member:`~ElectronSelector::m_readIDFlagsFromDerivation` is ``false``), evaluate the operating points
+      from the loosest to the tightest and stop at the first failing one: being the menus nested, the electron is decorated as failing all
+      the tighter operating points without calling their tools.
+    @endrst
+  */
+  bool           m_nestedPIDWPs = false;
+
 /* isolation */
   /** @brief reject objects which do not pass this isolation cut - default = "" (no cut) */
   std::string    m_MinIsoWPCut = "";
@@ -230,18 +255,33 @@ private:
   TH1D* m_el_cutflowHist_1 = nullptr;            //!
   TH1D* m_el_cutflowHist_2 = nullptr;            //!
 
-  int   m_el_cutflow_all;              //!
-  int   m_el_cutflow_author_cut;       //!
-  int   m_el_cutflow_OQ_cut;           //!
-  int   m_el_cutflow_ptmax_cut;        //!
-  int   m_el_cutflow_ptmin_cut;        //!
-  int   m_el_cutflow_eta_cut;          //!
-  int   m_el_cutflow_z0sintheta_cut;   //!
-  int   m_el_cutflow_d0_cut;           //!
-  int   m_el_cutflow_d0sig_cut;        //!
-  int   m_el_cutflow_BL_cut;           //!
-  int   m_el_cutflow_PID_cut;          //!
-  int   m_el_cutflow_iso_cut;          //!
+  /// @brief cuts in the object-level cutflow, in the order they are applied
+  enum class ElectronCut : unsigned int {
+    all, author, OQ, ptmax, ptmin, eta, z0sintheta, d0, d0sig, BL, PID, iso,
+    NCuts
+  };
+  /** @rst
+    per-instance counters for the object-level cutflow, flushed into :cpp:member:`~ElectronSelector::m_el_cutflowHist_1` (or ``_2``) in ``finalize()``
+  @endrst */
+  xAH::CutflowCounter<ElectronCut> m_el_cutflow; //!
+  /// @brief order in which the cuts are applied (see :cpp:member:`~ElectronSelector::m_adaptiveCutOrder`)
+  xAH::CutOrderOptimizer<ElectronCut> m_el_cutOrder; //!
+
+  /// @brief apply a single cut of the chain: returns false if the electron fails it. It does not decorate the electron
+  bool applyCut( ElectronCut cut, const xAOD::Electron* electron );
+  /// @brief compute and decorate the track variables read by the cuts, and set the default PID decorations
+  void decorateTrackVariables( const xAOD::Electron* electron, const xAOD::Vertex *primaryVertex, const xAOD::EventInfo* eventInfo );
+
+  /// @brief track variables of the electron being selected, set by decorateTrackVariables()
+  struct TrackVariables {
+    bool  hasTrack = false;
+    float z0sintheta = 1e8;
+    float d0sig = 0.;
+    bool  bLayerPass = false;
+  };
+  TrackVariables m_el_track; //!
+  /// @brief PID and isolation decisions computed by the cuts for the electron being selected, decorated if it passes all of them
+  std::vector< std::pair<std::string, char> > m_el_toolDecisions; //!
 
   std::vector<std::string> m_IsoKeys;  //!
 
@@ -293,12 +333,13 @@ public:
   virtual EL::StatusCode postExecute ();
   virtual EL::StatusCode finalize ();
   virtual EL::StatusCode histFinalize ();
+  virtual std::string declaredInputs () const;
 
   /* added functions not from Algorithm */
 
   bool executeSelection( const xAOD::ElectronContainer* inElectrons, float mcEvtWeight, bool countPass,
-                         ConstDataVector<xAOD::ElectronContainer>* selectedElectrons );
-  virtual int passCuts( const xAOD::Electron* electron, const xAOD::Vertex *primaryVertex );
+                         ConstDataVector<xAOD::ElectronContainer>* selectedElectrons, const xAOD::EventInfo* eventInfo );
+  virtual int passCuts( const xAOD::Electron* electron, const xAOD::Vertex *primaryVertex, const xAOD::EventInfo* eventInfo );
 
   /// @cond
   /* this is needed to distribute the algorithm to the workers */
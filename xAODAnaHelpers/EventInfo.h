@@ -3,9 +3,12 @@
 
 #include <TTree.h>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "xAODEventInfo/EventInfo.h"
 #include "xAODTracking/VertexContainer.h"
+#include "xAODCaloEvent/CaloClusterContainer.h"
 
 #include <xAODAnaHelpers/HelperClasses.h>
 
@@ -91,6 +94,16 @@ namespace xAH {
     std::vector<float> m_caloCluster_phi;
     std::vector<float> m_caloCluster_e;
 
+  private:
+
+    /// @brief the enabled event shapes: name of the container and member its density goes into
+    std::vector<std::pair<std::string, double EventInfo::*> > m_eventShapes;
+    /// @brief whether the event shapes missing from the input were already removed from m_eventShapes
+    bool m_eventShapesChecked = false;
+
+    /// @brief fill the caloCluster vectors from the raw (EM scale) columns of the clusters in one pass
+    void fillCaloClusters( const xAOD::CaloClusterContainer* caloClusters );
+
   };
 
   template <typename T_BR> void EventInfo::connectBranch(TTree *tree, std::string name, T_BR *variable)
@@ -0,0 +1,60 @@
+#ifndef xAODAnaHelpers_EventPicker_H
+#define xAODAnaHelpers_EventPicker_H
+
+// c++ include(s):
+#include <map>
+#include <set>
+
+// algorithm wrapper
+#include "xAODAnaHelpers/Algorithm.h"
+
+/**
+  @rst
+    Keeps only the given entries of the input files, and skips all the other events before anything is read from them.
+
+    It is put in front of the algorithms by ``xAH_run.py --pickEvents events.txt --eventIndex event_index.root``, which looks the run and
+    event numbers listed in ``events.txt`` up in the event index written by :cpp:member:`BasicEventSelection::m_writeEventIndex` and only runs
+    on the input files that contain them. Since the skipped entries are never read, rerunning a few hundred events takes seconds.
+
+  @endrst
+*/
+class EventPicker : public xAH::Algorithm
+{
+  public:
+    /**
+      @rst
+        The entries to keep in each input file, as ``file|entry,entry,... file|entry,...``. The file names are the ones of the event index,
+        which are matched to the input files by their full name, or by their base name if there is no match.
+      @endrst
+    */
+    std::string m_entries = "";
+
+  private:
+    std::map<std::string, std::set<long long> > m_entriesPerFile; //!
+    const std::set<long long>* m_currentEntries = nullptr; //!
+    unsigned long long m_numPicked = 0; //!
+
+  public:
+    // this is a standard constructor
+    EventPicker ();
+
+    // these are the functions inherited from Algorithm
+    virtual EL::StatusCode setupJob (EL::Job& job);
+    virtual EL::StatusCode fileExecute ();
+    virtual EL::StatusCode histInitialize ();
+    virtual EL::StatusCode changeInput (bool firstFile);
+    virtual EL::StatusCode initialize ();
+    virtual EL::StatusCode execute ();
+    virtual EL::StatusCode postExecute ();
+    virtual EL::StatusCode finalize ();
+    virtual EL::StatusCode histFinalize ();
+    virtual std::string declaredInputs () const;
+
+    /// @cond
+    // this is needed to distribute the algorithm to the workers
+    ClassDef(EventPicker, 1);
+    /// @endcond
+
+};
+
+#endif
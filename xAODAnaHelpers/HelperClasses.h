@@ -2,6 +2,7 @@
 #define xAODAnaHelpers_HELPERCLASSES_H
 
 #include <map>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
 
@@ -147,6 +148,9 @@ namespace HelperClasses {
         m_weightsSys     weightsSys     exact
         ================ ============== =======
 
+        .. note:: ``caloClusters`` only reads the EM scale energy, eta, phi and mass columns of ``CaloCalTopoClusters``. Run with
+                  ``xAH_run.py --mode branch`` so that the other variables of the clusters are not read from the input at all.
+
     @endrst
    */
   class EventInfoSwitch : public InfoSwitch {
@@ -162,6 +166,8 @@ namespace HelperClasses {
     bool m_caloClus;
     bool m_weightsSys;
     EventInfoSwitch(const std::string configStr) : InfoSwitch(configStr) { initialize(); };
+    /// @brief the input containers, besides the one of the objects, that these switches read, see :cpp:func:`xAH::Algorithm::declaredInputs`
+    std::string inputs() const;
   protected:
     void initialize();
   };
@@ -195,6 +201,8 @@ namespace HelperClasses {
     bool m_prescales;
     bool m_prescalesLumi;
     TriggerInfoSwitch(const std::string configStr) : InfoSwitch(configStr) { initialize(); };
+    /// @brief the input containers, besides the one of the objects, that these switches read, see :cpp:func:`xAH::Algorithm::declaredInputs`
+    std::string inputs() const;
   protected:
     void initialize();
   };
@@ -297,6 +305,8 @@ namespace HelperClasses {
 
     MuonInfoSwitch(const std::string configStr) : IParticleInfoSwitch(configStr) { initialize(); };
     virtual ~MuonInfoSwitch() {}
+    /// @brief the input containers, besides the one of the objects, that these switches read, see :cpp:func:`xAH::Algorithm::declaredInputs`
+    std::string inputs() const;
   protected:
     virtual void initialize();
   };
@@ -357,6 +367,8 @@ namespace HelperClasses {
     std::vector< std::string > m_trigWPs;
     ElectronInfoSwitch(const std::string configStr) : IParticleInfoSwitch(configStr) { initialize(); };
     virtual ~ElectronInfoSwitch() {}
+    /// @brief the input containers, besides the one of the objects, that these switches read, see :cpp:func:`xAH::Algorithm::declaredInputs`
+    std::string inputs() const;
   protected:
     virtual void initialize();
   };
@@ -533,10 +545,103 @@ namespace HelperClasses {
     std::map<std::string,std::vector<std::pair<std::string,uint>>> m_jetBTag;
     JetInfoSwitch(const std::string configStr) : IParticleInfoSwitch(configStr) { initialize(); };
     virtual ~JetInfoSwitch() {}
+    /// @brief the boolean switches packed into bits, see :cpp:any:`HelperClasses::JetSwitch`
+    uint64_t mask() const;
+    /// @brief the input containers, besides the one of the objects, that these switches read, see :cpp:func:`xAH::Algorithm::declaredInputs`
+    std::string inputs() const;
   protected:
     virtual void initialize();
   };
 
+  /**
+      @rst
+          One bit per boolean switch of :cpp:class:`HelperClasses::JetInfoSwitch` (including the ones of
+          :cpp:class:`HelperClasses::IParticleInfoSwitch`), as returned by :cpp:func:`HelperClasses::JetInfoSwitch::mask`.
+
+          The jet fill functions (:cpp:func:`xAH::JetContainer::FillJet`, :cpp:func:`JetHists::execute`) are templates on such a mask.
+          For the detail strings listed in :cpp:any:`HelperClasses::JetFillConfigs` a version with the switches known at compile time
+          is instantiated, where the compiler drops the branches and the code of the disabled blocks; any other detail string uses the
+          version reading the switches at run time (``RuntimeSwitches``). Both give the same output.
+      @endrst
+   */
+  namespace JetSwitch {
+    enum : uint64_t {
+      kinematic        = 1ull << 0,
+      useTheS          = 1ull << 1,
+      trigger          = 1ull << 2,
+      substructure     = 1ull << 3,
+      bosonCount       = 1ull << 4,
+      VTags            = 1ull << 5,
+      rapidity         = 1ull << 6,
+      clean            = 1ull << 7,
+      cleanLight       = 1ull << 8,
+      cleanNoSumm      = 1ull << 9,
+      energy           = 1ull << 10,
+      energyLight      = 1ull << 11,
+      scales           = 1ull << 12,
+      constscaleEta    = 1ull << 13,
+      detectorEta      = 1ull << 14,
+      resolution       = 1ull << 15,
+      truth            = 1ull << 16,
+      truthDetails     = 1ull << 17,
+      layer            = 1ull << 18,
+      trackPV          = 1ull << 19,
+      trackAll         = 1ull << 20,
+      jvt              = 1ull << 21,
+      allTrack         = 1ull << 22,
+      allTrackDetail   = 1ull << 23,
+      allTrackPVSel    = 1ull << 24,
+      constituent      = 1ull << 25,
+      constituentAll   = 1ull << 26,
+      flavorTag        = 1ull << 27,
+      flavorTagHLT     = 1ull << 28,
+      btag_jettrk      = 1ull << 29,
+      jetFitterDetails = 1ull << 30,
+      svDetails        = 1ull << 31,
+      ipDetails        = 1ull << 32,
+      tracksInJet      = 1ull << 33,
+      hltVtxComp       = 1ull << 34,
+      onlineBS         = 1ull << 35,
+      onlineBSTool     = 1ull << 36,
+      charge           = 1ull << 37,
+      etaPhiMap        = 1ull << 38,
+      vsLumiBlock      = 1ull << 39,
+      vsActualMu       = 1ull << 40,
+      lumiB_runN       = 1ull << 41,
+      byEta            = 1ull << 42,
+      byAverageMu      = 1ull << 43,
+      area             = 1ull << 44,
+      JVC              = 1ull << 45
+    };
+  }
+
+  /// @brief the mask of the fill functions reading the switches at run time
+  constexpr uint64_t RuntimeSwitches = ~0ull;
+
+  /// @brief value of a switch in a fill function specialised on ``MASK``: a constant, unless the switches are read at run time
+  template <uint64_t MASK>
+  inline bool switchOn(uint64_t bit, bool value){ return MASK == RuntimeSwitches ? value : (MASK & bit) != 0; }
+
+  /// @brief a list of masks to specialise the fill functions on
+  template <uint64_t... MASKS>
+  struct SwitchConfigs {};
+
+  /// @brief the jet detail strings with a specialised fill function (the order of the words does not matter)
+  typedef SwitchConfigs<
+    // "kinematic"
+    JetSwitch::kinematic,
+    // "kinematic clean energy"
+    JetSwitch::kinematic | JetSwitch::clean | JetSwitch::energy,
+    // "kinematic clean energy layer trackPV JVT"
+    JetSwitch::kinematic | JetSwitch::clean | JetSwitch::energy | JetSwitch::layer | JetSwitch::trackPV | JetSwitch::jvt,
+    // "kinematic clean energy trackPV JVT flavorTag"
+    JetSwitch::kinematic | JetSwitch::clean | JetSwitch::energy | JetSwitch::trackPV | JetSwitch::jvt | JetSwitch::flavorTag,
+    // "kinematic clean energy trackPV JVT flavorTag truth"
+    JetSwitch::kinematic | JetSwitch::clean | JetSwitch::energy | JetSwitch::trackPV | JetSwitch::jvt | JetSwitch::flavorTag | JetSwitch::truth,
+    // "kinematic truth"
+    JetSwitch::kinematic | JetSwitch::truth
+  > JetFillConfigs;
+
   /**
     @rst
         The :cpp:class:`HelperClasses::InfoSwitch` struct for Truth Information.
@@ -642,6 +747,8 @@ namespace HelperClasses {
 
     TauInfoSwitch(const std::string configStr) : IParticleInfoSwitch(configStr) { initialize(); };
     virtual ~TauInfoSwitch() { }
+    /// @brief the input containers, besides the one of the objects, that these switches read, see :cpp:func:`xAH::Algorithm::declaredInputs`
+    std::string inputs() const;
   protected:
     virtual void initialize();
   };
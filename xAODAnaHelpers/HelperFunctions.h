@@ -4,6 +4,7 @@
 // for typing in template
 #include <typeinfo>
 #include <cxxabi.h>
+#include <numeric>
 // Gaudi/Athena include(s):
 #include "AthContainers/normalizedTypeinfoName.h"
 
@@ -424,6 +425,55 @@ namespace HelperFunctions {
     return *sortedCont.asDataVector();
   }
 
+  /**
+    @brief Indices of the objects of a container, ordered by decreasing pT, computed once per event and shared through the TStore
+    @param inCont   the container to order
+    @param name     the name of the container, including the systematic suffix (e.g. ``m_inContainerName+systName``)
+    @param store    the TStore, usually wk()->xaodStore(): the ordering is recorded as ``ptOrder_<name>`` and cleared with the event
+    @param nLeading only the indices of the ``nLeading`` leading objects are needed (0: all of them)
+
+    @rst
+      Unlike :cpp:func:`HelperFunctions::sort_container_pt`, no container is copied: the first caller in the event computes the
+      permutation (with a partial sort when only the leading objects are needed) and records it, the following ones reuse it::
+
+        const std::vector<unsigned int>* order = HelperFunctions::pt_order( jets, m_inContainerName+systName, m_store, 2 );
+        const xAOD::Jet* leadingJet = jets->at( order->at(0) );
+
+      The returned vector holds *at least* ``min(nLeading, inCont->size())`` indices. Returns ``nullptr`` if no TStore is given.
+    @endrst
+  */
+  template<typename T>
+    const std::vector<unsigned int>* pt_order(const T* inCont, const std::string& name, xAOD::TStore* store, unsigned int nLeading = 0){
+    if ( !inCont || !store ) return nullptr;
+
+    const unsigned int nObjects = inCont->size();
+    const unsigned int nSorted  = ( nLeading > 0 && nLeading < nObjects ) ? nLeading : nObjects;
+
+    const std::string key = "ptOrder_" + name;
+    std::vector<unsigned int>* order(nullptr);
+    if ( store->contains< std::vector<unsigned int> >( key ) ) {
+      if ( !store->retrieve( order, key ).isSuccess() ) return nullptr;
+      if ( order->size() >= nSorted ) return order;
+    } else {
+      order = new std::vector<unsigned int>();
+      if ( !store->record( order, key ).isSuccess() ) return nullptr;
+    }
+
+    // read each pT once, then sort the indices
+    std::vector<double> pts;
+    pts.reserve( nObjects );
+    for ( auto el : *inCont ) pts.push_back( el->pt() );
+
+    std::vector<unsigned int> indices( nObjects );
+    std::iota( indices.begin(), indices.end(), 0 );
+    auto byPt = [&pts]( unsigned int a, unsigned int b ) { return pts[a] > pts[b]; };
+    if ( nSorted < nObjects ) std::partial_sort( indices.begin(), indices.begin() + nSorted, indices.end(), byPt );
+    else                      std::sort( indices.begin(), indices.end(), byPt );
+
+    order->assign( indices.begin(), indices.begin() + nSorted );
+    return order;
+  }
+
   /* return true if there's a least one non-empty string (i.e., syst name) in input list */
   inline bool found_non_dummy_sys(std::vector<std::string>* sys_list) {
     if ( sys_list ) {
@@ -8,6 +8,8 @@
  */
 
 #include <ctype.h>
+#include <string>
+#include <vector>
 #include <TH1.h>
 #include <TH1F.h>
 #include <TH2F.h>
@@ -22,6 +24,29 @@
 
 class MsgStream;
 
+namespace xAH {
+
+  /** @brief Binning and axis titles of a histogram booked lazily (see :cpp:func:`HistogramManager::setLazyBooking`) */
+  struct HistBinning {
+    struct Axis {
+      std::string title;
+      int nbins = 0;
+      double low = 0., high = 0.;
+      /** @brief the bin edges for variable bins, empty for fixed bins */
+      std::vector<double> edges;
+    };
+    std::vector<Axis> axes;
+  };
+
+  /** @brief where the bins of the histograms are kept until they are written, see :cpp:func:`HistogramManager::setStorage` */
+  enum class HistStorage {
+    Dense,   ///< the ROOT arrays, with Sumw2
+    Sparse,  ///< a hash map of the filled bins
+    Counts   ///< integer counts while all the weights are 1
+  };
+
+}
+
 /**
     @brief This is used by any class extending to pre-define a set of histograms to book by default.
     @rst
@@ -58,6 +83,10 @@ class HistogramManager {
     std::vector< TH1* > m_allHists; //!
     /** @brief hold the MsgStream object */
     mutable MsgStream m_msg; //!
+    /** @brief allocate the histograms on their first fill, see HistogramManager::setLazyBooking */
+    bool m_lazyBooking = false; //!
+    /** @brief where the bins are kept, see HistogramManager::setStorage */
+    xAH::HistStorage m_storage = xAH::HistStorage::Dense; //!
 
   public:
     /**
@@ -194,6 +223,57 @@ class HistogramManager {
      */
     void record(EL::Worker* wk);
 
+    /**
+        @brief Allocate the bin contents of the histograms on their first fill instead of when they are booked
+        @param lazy      book lazily or not
+        @rst
+            Must be called before :cpp:func:`HistogramManager::initialize`. A histogram booked lazily is a ``TH1F``, ``TH2F`` or ``TH3F``
+            like any other, with its axes set, but its content and Sumw2 arrays (nearly all of its memory) are only allocated when a
+            bin is first filled or set. One that is never filled is still written out, as the same empty histogram as when booked
+            eagerly, and only holds its arrays while it is being written.
+
+            This is meant for the sets booked for each systematic by e.g. :cpp:class:`IParticleHistsAlgo`, where most histograms of
+            the rare variations are never filled. Profiles are always booked eagerly.
+        @endrst
+     */
+    void setLazyBooking(bool lazy);
+    bool lazyBooking() const { return m_lazyBooking; }
+
+    /**
+        @brief Keep the bins of the histograms in another storage than the ROOT arrays until they are written
+        @rst
+            Must be called before :cpp:func:`HistogramManager::initialize`, and applies to all the histograms but the profiles.
+
+            - ``Sparse`` keeps only the filled bins, in a hash map (about 50 B per filled bin instead of 12 B per bin), for the large
+              2D maps and 3D histograms where most bins stay empty.
+            - ``Counts`` keeps integer counts (4 B per bin, exact up to 2\ :sup:`32` entries) and no sum of squared weights as long as
+              all the fills have a weight of 1, e.g. on data. The first other weight switches the histogram to sums of weights and
+              of squared weights in double precision (16 B per bin).
+
+            Both are allocated on the first fill, like with :cpp:func:`HistogramManager::setLazyBooking`. The bins are converted to the
+            ROOT arrays only while the histogram is written, so that the output is the same ``TH1F``, ``TH2F`` or ``TH3F``, with
+            Sumw2, as with the default ``Dense`` storage.
+        @endrst
+     */
+    void setStorage(xAH::HistStorage storage);
+    /** @brief set the storage from its name: ``dense``, ``sparse`` or ``counts`` */
+    StatusCode setStorage(const std::string& storage);
+    xAH::HistStorage storage() const { return m_storage; }
+
+    /** @brief number and memory of the histograms booked, and of those with their bins allocated */
+    struct MemoryUsage {
+      unsigned int booked = 0;
+      unsigned int allocated = 0;
+      /** @brief content and Sumw2 arrays, if they were all allocated [B] */
+      double bookedBytes = 0.;
+      /** @brief content and Sumw2 arrays actually allocated [B] */
+      double allocatedBytes = 0.;
+
+      MemoryUsage& operator+=(const MemoryUsage& other);
+    };
+    /** @brief memory used by the histograms of this manager (and of the managers it owns) */
+    virtual MemoryUsage memoryUsage() const;
+
     /**
       * @brief the standard message stream for this algorithm
       */
@@ -204,6 +284,20 @@ class HistogramManager {
     MsgStream& msg (int level) const;
 
   private:
+    /**
+     * @brief whether the histograms are booked by HistogramManager::bookLazy
+     */
+    bool isBookingDeferred() const { return m_lazyBooking || m_storage != xAH::HistStorage::Dense; }
+
+    /**
+     * @brief Book a histogram whose bins are allocated on its first fill, in the storage of the manager
+     *
+     * @param name      The name of the histogram, without its title
+     * @param title     The title of the histogram
+     * @param axes      The binning and title of each of its axes
+     */
+    template<class HIST> HIST* bookLazy(const std::string& name, const std::string& title, std::vector<xAH::HistBinning::Axis>&& axes);
+
     /**
      * @brief Turn on Sumw2 for the histogram
      *
@@ -21,7 +21,12 @@ class IParticleHists : public HistogramManager
 
     bool m_debug;
     virtual StatusCode initialize();
-    StatusCode execute( const xAOD::IParticleContainer* particles, float eventWeight, const xAOD::EventInfo* eventInfo = 0 );
+    /**
+        @brief Fill the histograms of all the particles. The N leading objects are taken in the order ``leadingOrder`` (indices in the
+               container, see HelperFunctions::pt_order) if it is given, otherwise the container is assumed to be pT-sorted
+     */
+    StatusCode execute( const xAOD::IParticleContainer* particles, float eventWeight, const xAOD::EventInfo* eventInfo = 0,
+                        const std::vector<unsigned int>* leadingOrder = nullptr );
     virtual StatusCode execute( const xAOD::IParticle* particle, float eventWeight, const xAOD::EventInfo* eventInfo = 0 );
 
     template <class T_PARTICLE, class T_INFOSWITCH>
@@ -29,6 +34,9 @@ class IParticleHists : public HistogramManager
 
     //StatusCode execute( const xAH::ParticleContainer* particles, float eventWeight, const xAH::EventInfo* eventInfo = 0 );
     virtual StatusCode execute( const xAH::Particle* particle, float eventWeight, const xAH::EventInfo* eventInfo = 0);
+    /** @brief number of leading objects histogrammed on their own (``NLeading`` detail) */
+    int numLeading() const { return m_infoSwitch->m_numLeading; }
+
     using HistogramManager::book; // make other overloaded version of book() to show up in subclass
     using HistogramManager::execute; // overload
 
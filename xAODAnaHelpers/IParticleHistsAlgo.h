@@ -26,6 +26,31 @@ public:
   std::string m_histPrefix;
   /** Histogram xaxis title when using IParticleHistsAlgo directly */
   std::string m_histTitle;
+  /**
+    @rst
+      Fill the ``NLeading`` histograms with the leading objects in pT even if the input container is not pT-sorted. The ordering
+      is computed with :cpp:func:`HelperFunctions::pt_order`, i.e. once per event for each container and systematic, and is reused
+      by any other algorithm asking for it.
+    @endrst
+  */
+  bool m_sortLeading = false;
+  /**
+    @rst
+      Allocate the bins of each histogram on its first fill rather than when the set of histograms of a systematic is booked (see
+      :cpp:func:`HistogramManager::setLazyBooking`). With many systematics most histograms of the rare variations are never filled,
+      and this saves most of the memory of the job. The output is the same. The memory of the histograms, as booked and as
+      actually allocated, is printed at the end of the job.
+    @endrst
+  */
+  bool m_lazyBooking = false;
+  /**
+    @rst
+      Where the bins of the histograms are kept until they are written: ``dense`` (the ROOT arrays), ``sparse`` (only the filled bins,
+      for sets with large 2D and 3D histograms) or ``counts`` (integer counts while all the weights are 1, e.g. on data). The output
+      is the same whatever the storage, see :cpp:func:`HistogramManager::setStorage`.
+    @endrst
+  */
+  std::string m_histStorage = "dense";
 
 private:
   std::map< std::string, IParticleHists* > m_plots; //!
@@ -53,6 +78,7 @@ public:
   virtual EL::StatusCode postExecute ();
   virtual EL::StatusCode finalize ();
   virtual EL::StatusCode histFinalize ();
+  virtual std::string declaredInputs () const;
 
   /**
       @brief Fill histograms with particles in a container
@@ -92,8 +118,13 @@ public:
     if( m_inputAlgo.empty() ) {
       ANA_CHECK( HelperFunctions::retrieve(inParticles, m_inContainerName, m_event, m_store, msg()) );
 
+      const std::vector<unsigned int>* leadingOrder(nullptr);
+      if( m_sortLeading && m_plots[""]->numLeading() > 0 ) {
+        leadingOrder = HelperFunctions::pt_order( inParticles, m_inContainerName, m_store, m_plots[""]->numLeading() );
+      }
+
       // pass the photon collection
-      ANA_CHECK( static_cast<HIST_T*>(m_plots[""])->execute( inParticles, eventWeight, eventInfo ));
+      ANA_CHECK( static_cast<HIST_T*>(m_plots[""])->execute( inParticles, eventWeight, eventInfo, leadingOrder ));
     }
     else { // get the list of systematics to run over
 
@@ -105,7 +136,11 @@ public:
       for( auto systName : *systNames ) {
 	ANA_CHECK( HelperFunctions::retrieve(inParticles, m_inContainerName+systName, m_event, m_store, msg()) );
 	if( m_plots.find( systName ) == m_plots.end() ) { this->AddHists( systName ); }
-	ANA_CHECK( static_cast<HIST_T*>(m_plots[systName])->execute( inParticles, eventWeight, eventInfo ));
+	const std::vector<unsigned int>* leadingOrder(nullptr);
+	if( m_sortLeading && m_plots[systName]->numLeading() > 0 ) {
+	  leadingOrder = HelperFunctions::pt_order( inParticles, m_inContainerName+systName, m_store, m_plots[systName]->numLeading() );
+	}
+	ANA_CHECK( static_cast<HIST_T*>(m_plots[systName])->execute( inParticles, eventWeight, eventInfo, leadingOrder ));
       }
     }
 
@@ -134,6 +169,8 @@ public:
     fullname += name; // add systematic
     HIST_T* particleHists = new HIST_T( fullname, m_detailStr ); // add systematic
     particleHists->m_debug = msgLvl(MSG::DEBUG);
+    particleHists->setLazyBooking( m_lazyBooking );
+    ANA_CHECK( particleHists->setStorage( m_histStorage ));
     ANA_CHECK( particleHists->initialize());
     particleHists->record( wk() );
     m_plots[name] = particleHists;
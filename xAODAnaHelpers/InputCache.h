@@ -0,0 +1,134 @@
+#ifndef xAODAnaHelpers_InputCache_H
+#define xAODAnaHelpers_InputCache_H
+
+// c++ include(s):
+#include <string>
+#include <vector>
+
+// algorithm wrapper
+#include "xAODAnaHelpers/Algorithm.h"
+
+class TBranch;
+class TFile;
+class TFileOpenHandle;
+class TTree;
+class TTreeCache;
+
+/**
+  @rst
+    Tunes the reading of the input files, and reports how many bytes and read calls each of them took.
+
+    It is put in front of the algorithms by ``xAH_run.py`` when one of ``--cacheBranches``, ``--asyncPrefetch``, ``--prefetchNextFile``
+    or ``--readStats`` is given (the size of the TTreeCache and the length of its learning phase are set with ``--cacheSize`` and
+    ``--cacheLearnEntries``, which are EventLoop options):
+
+      - the branches of the containers in :cpp:member:`~InputCache::m_branches` (their interface, ``Aux.`` and ``AuxDyn.`` branches) are
+        added to the TTreeCache of each input file from the first entry on, instead of being found during the learning phase, so that
+        they are read in a few large requests. ``--cacheBranches auto`` takes the input containers of the configured algorithms,
+      - with :cpp:member:`~InputCache::m_asyncPrefetch`, the next block of the TTreeCache is read in the background by ROOT while the
+        current one is processed,
+      - with :cpp:member:`~InputCache::m_prefetchFiles`, the input file after the current one in that list is opened asynchronously
+        if it is remote (``TFile::AsyncOpen``, which the next ``TFile::Open`` of EventLoop picks up, or which is closed when the next
+        file turns out to be another one), and the kernel is asked to read it ahead if it is local.
+
+    At the end of the job, one line per input file gives the bytes read, the number of read calls and the fraction of the reads served
+    by the TTreeCache.
+
+    With :cpp:member:`~InputCache::m_pruneInputs` (``xAH_run.py --pruneInputs``), the branches of the containers not in
+    :cpp:member:`~InputCache::m_declaredInputs`, i.e. not declared by any algorithm of the job (:cpp:func:`xAH::Algorithm::declaredInputs`),
+    are disabled when each file is opened, and all the declared ones are put in the cache at once. A disabled branch would be read as
+    empty, so the job stops at the first event where an algorithm reads one: add the missing containers with ``--keepInputs``.
+    ``xAH_run.py --inputReport`` lists what each algorithm declares and the size of the branches that would not be read.
+
+  @endrst
+*/
+class InputCache : public xAH::Algorithm
+{
+  public:
+    /// @brief Space-separated names of the input containers whose branches are always cached
+    std::string m_branches = "";
+    /// @brief Only cache the branches of :cpp:member:`~InputCache::m_branches` (ends the learning phase of the TTreeCache at once)
+    bool m_pinOnly = false;
+    /// @brief Read the next block of the TTreeCache in the background (``TFile.AsyncPrefetching``)
+    bool m_asyncPrefetch = false;
+    /// @brief Space-separated input files in the order they are processed, to prefetch the next one
+    std::string m_prefetchFiles = "";
+    /// @brief Print the read statistics of each input file at the end of the job
+    bool m_printStats = true;
+    /// @brief Space-separated inputs of all the algorithms, in the format of :cpp:func:`xAH::Algorithm::declaredInputs`
+    std::string m_declaredInputs = "";
+    /// @brief Disable the branches not in :cpp:member:`~InputCache::m_declaredInputs`
+    bool m_pruneInputs = false;
+
+    /// @brief The top-level branches of ``tree`` not in :cpp:member:`~InputCache::m_declaredInputs`, for the report of ``xAH_run.py``
+    std::vector<std::string> undeclaredBranches( TTree* tree ) const;
+
+    /// @brief a container name (with wildcards) and optionally one of its aux variables
+    struct Input {
+      std::string container;
+      std::string variable;
+    };
+
+    /// @brief split space-separated ``Container`` or ``Container.variable`` names
+    static std::vector<Input> parseInputs( const std::string& inputs );
+    /// @brief the container and aux variable (empty for the interface and static aux branches) of a branch
+    static Input splitBranchName( const std::string& branchName );
+    /// @brief whether the branch ``branchName`` belongs to one of ``inputs``
+    static bool matches( const std::vector<Input>& inputs, const std::string& branchName );
+
+  private:
+    /// @brief what was read from one input file
+    struct FileStats {
+      std::string name;
+      unsigned long long entries = 0;
+      long long bytesRead = 0;
+      int readCalls = 0;
+      double cacheEfficiency = -1.;  // fraction of the reads served by the TTreeCache, -1 without a cache
+    };
+
+    std::vector<Input> m_pinned; //!
+    std::vector<Input> m_declared; //!
+    std::vector<TBranch*> m_prunedBranches; //!
+    std::vector<std::string> m_fileList; //!
+    std::vector<FileStats> m_fileStats; //!
+    FileStats m_current; //!
+    TFile* m_file = nullptr; //!
+    TTreeCache* m_cache = nullptr; //!
+    TFileOpenHandle* m_prefetchHandle = nullptr; //!
+    std::string m_prefetchName; //!
+
+    /// @brief add the branches matching ``inputs`` to the cache of the current tree, returns the number of branches added
+    int pinBranches( const std::vector<Input>& inputs );
+    /// @brief disable the branches of the current tree not in m_declared
+    void pruneBranches();
+    /// @brief start reading the file after ``fileName`` in m_fileList
+    void prefetchNext( const std::string& fileName );
+    /// @brief close the file opened asynchronously by prefetchNext if EventLoop did not take it
+    void releasePrefetch();
+    /// @brief save the statistics of the current file
+    void closeFileStats();
+
+  public:
+    // this is a standard constructor
+    InputCache ();
+
+    // these are the functions inherited from Algorithm
+    virtual EL::StatusCode setupJob (EL::Job& job);
+    virtual EL::StatusCode fileExecute ();
+    virtual EL::StatusCode histInitialize ();
+    virtual EL::StatusCode changeInput (bool firstFile);
+    virtual EL::StatusCode initialize ();
+    virtual EL::StatusCode execute ();
+    virtual EL::StatusCode postExecute ();
+    virtual EL::StatusCode finalize ();
+    virtual EL::StatusCode histFinalize ();
+    virtual std::string declaredInputs () const;
+
+    /// @cond
+    // this is needed to distribute the algorithm to the workers
+    ClassDef(InputCache, 1);
+    /// @endcond
+
+};
+
+#endif
@@ -39,6 +39,17 @@ namespace xAH {
 
     private:
 
+      /// @brief the body of FillJet, with the switches of ``MASK`` known at compile time (see :cpp:any:`HelperClasses::JetSwitch`)
+      template <uint64_t MASK>
+      void FillJetKernel( const xAOD::IParticle* particle, const xAOD::Vertex* pv, int pvLocation );
+
+      typedef void (JetContainer::*FillJetKernel_t)( const xAOD::IParticle*, const xAOD::Vertex*, int );
+      /// @brief the kernel specialised on ``mask`` if it is one of ``MASKS``, the one reading the switches at run time otherwise
+      template <uint64_t... MASKS>
+      static FillJetKernel_t findFillJetKernel( uint64_t mask, HelperClasses::SwitchConfigs<MASKS...> );
+
+      FillJetKernel_t m_fillJetKernel;
+
       InDet::InDetTrackSelectionTool * m_trkSelTool;
 
       //
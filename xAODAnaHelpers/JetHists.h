@@ -28,6 +28,7 @@ class JetHists : public IParticleHists
     using HistogramManager::book; // make other overloaded version of book() to show up in subclass
     using IParticleHists::execute; // overload
     virtual void record(EL::Worker* wk);
+    virtual MemoryUsage memoryUsage() const;
 
   protected:
 
@@ -39,6 +40,17 @@ class JetHists : public IParticleHists
 
   private:
 
+    /// @brief the body of execute, with the switches of ``MASK`` known at compile time (see :cpp:any:`HelperClasses::JetSwitch`)
+    template <uint64_t MASK>
+    StatusCode executeKernel( const xAOD::IParticle* particle, float eventWeight, const xAOD::EventInfo* eventInfo );
+
+    typedef StatusCode (JetHists::*ExecuteKernel_t)( const xAOD::IParticle*, float, const xAOD::EventInfo* );
+    /// @brief the kernel specialised on ``mask`` if it is one of ``MASKS``, the one reading the switches at run time otherwise
+    template <uint64_t... MASKS>
+    static ExecuteKernel_t findExecuteKernel( uint64_t mask, HelperClasses::SwitchConfigs<MASKS...> );
+
+    ExecuteKernel_t m_executeKernel; //!
+
     std::string m_titlePrefix;
     xAH::OnlineBeamSpotTool      m_onlineBSTool;  //!
 
@@ -25,6 +25,7 @@ public:
   // these are the functions inherited from Algorithm
   virtual EL::StatusCode setupJob (EL::Job& job);
   virtual EL::StatusCode execute ();
+  virtual std::string declaredInputs () const;
 
   // these are the functions not inherited from Algorithm
   EL::StatusCode AddHists( std::string name );
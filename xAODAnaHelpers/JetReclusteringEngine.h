@@ -0,0 +1,98 @@
+#ifndef xAODAnaHelpers_JetReclusteringEngine_H
+#define xAODAnaHelpers_JetReclusteringEngine_H
+
+/** @file JetReclusteringEngine.h
+ *  @brief Reclustering and trimming of jets with buffers kept across events
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+#include <string>
+#include <vector>
+
+#include <fastjet/JetDefinition.hh>
+#include <fastjet/PseudoJet.hh>
+#include <fastjet/tools/Filter.hh>
+
+#include "TLorentzVector.h"
+
+#include "xAODJet/JetContainer.h"
+
+namespace xAH {
+
+  /**
+      @rst
+          Does what :cpp:func:`HelperFunctions::jetReclustering` and :cpp:func:`HelperFunctions::jetTrimming` do, for many events and
+          many containers:
+
+            - the pseudojets, subjets and results are kept in buffers that are reused from one call to the next, so that after the first
+              events nothing is allocated but what fastjet needs for its cluster sequences,
+            - the clustering strategy is chosen for the number of inputs (``N2Plain`` for the handful of small-R jets of an event, which
+              is much faster than the default for so few inputs, fastjet's choice otherwise),
+            - the trimming is the one of :cpp:func:`HelperFunctions::jetTrimming` (the constituents are reclustered with the algorithm and
+              radius of the jet, then ``fastjet::Filter`` keeps the subjets above ``fcut`` of the jet pt), with the jet definitions and
+              the filters built once instead of for every jet, and no conversion to ``TLorentzVector`` but for the results.
+
+          The results are in the same units as those of the :cpp:class:`HelperFunctions` (GeV for the reclustered jets, MeV for the trimmed
+          ones), sorted by decreasing pt, and stay valid until the next call::
+
+              xAH::JetReclusteringEngine engine(1.0, 0.05);  // e.g. a member of the algorithm
+              for(const TLorentzVector& rc_jet: engine.recluster(jets)) { ... }
+
+      @endrst
+   */
+  class JetReclusteringEngine {
+    public:
+      /**
+          @param radius       radius of the reclustered jets
+          @param fcut         trimming cut, as a fraction of the pt of the (reclustered) jet
+          @param rc_alg       algorithm to recluster the jets with
+          @param subjetRadius radius of the subjets, for :cpp:func:`~xAH::JetReclusteringEngine::trim`
+          @param subjetAlg    algorithm to build the subjets with, for :cpp:func:`~xAH::JetReclusteringEngine::trim`
+       */
+      JetReclusteringEngine( double radius = 1.0, double fcut = 0.05, fastjet::JetAlgorithm rc_alg = fastjet::antikt_algorithm,
+                             double subjetRadius = 0.3, fastjet::JetAlgorithm subjetAlg = fastjet::kt_algorithm );
+
+      /** @brief change the parameters (keeps the buffers) */
+      void configure( double radius, double fcut, fastjet::JetAlgorithm rc_alg, double subjetRadius, fastjet::JetAlgorithm subjetAlg );
+
+      /** @brief recluster ``jets`` into large-R jets and trim them (subjets below ``fcut`` of the large-R jet pt are removed) [GeV] */
+      const std::vector<TLorentzVector>& recluster( const xAOD::JetContainer* jets );
+
+      /** @brief trim each of ``jets`` using its constituents [MeV] */
+      const std::vector<TLorentzVector>& trim( const xAOD::JetContainer* jets );
+
+      /** @brief trim one jet using its constituents [MeV] */
+      TLorentzVector trim( const xAOD::Jet* jet );
+
+    private:
+      /** @brief the definition to use for n inputs: N2Plain below ~30 inputs, where it is the fastest, fastjet's Best otherwise */
+      const fastjet::JetDefinition& definition( const fastjet::JetDefinition& small, const fastjet::JetDefinition& large, std::size_t n ) const;
+
+      /** @brief fill m_inputs with the four-vectors of jets [GeV] */
+      void fillInputs( const xAOD::JetContainer* jets );
+      /** @brief recluster and trim m_inputs into ``result`` */
+      void reclusterInputs( std::vector<TLorentzVector>& result );
+      /** @brief sort m_trimmed by decreasing pt and convert it into ``result`` */
+      void fillResult( std::vector<TLorentzVector>& result );
+
+      /** @brief trim the constituents of one jet [MeV] */
+      fastjet::PseudoJet trimmedPseudoJet( const xAOD::Jet* jet );
+
+      double m_radius, m_fcut, m_subjetRadius;
+      fastjet::JetAlgorithm m_rcAlg, m_subjetAlg;
+      fastjet::JetDefinition m_rcSmall, m_rcLarge;
+      fastjet::Filter m_trimmerSmall, m_trimmerLarge;
+
+      // definitions of the jets being trimmed, rebuilt when their algorithm or radius change
+      int m_jetAlg = -1;
+      double m_jetRadius = -1.;
+      fastjet::JetDefinition m_jetSmall, m_jetLarge;
+
+      std::vector<fastjet::PseudoJet> m_inputs;
+      std::vector<fastjet::PseudoJet> m_trimmed;
+      std::vector<TLorentzVector> m_result;
+  };
+
+}
+#endif
@@ -22,6 +22,8 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/CutflowCounter.h"
+#include "xAODAnaHelpers/CutOrderOptimizer.h"
 
 // external tools include(s):
 #include "AsgTools/AnaToolHandle.h"
@@ -38,6 +40,17 @@ class JetSelector : public xAH::Algorithm
 public:
   bool m_useCutFlow = true;
 
+  /**
+    @rst
+      When no cutflow is filled (:cpp:member:`~JetSelector::m_useCutFlow` is ``false``), measure rejection and time per call of every cut
+      during the first :cpp:member:`~JetSelector::m_nAdaptiveCutOrderEvents` events, then apply the cuts in the order minimising the time
+      spent per jet. The cuts do not decorate the jet, so the ``passSel`` decision is unchanged.
+    @endrst
+  */
+  bool m_adaptiveCutOrder = false;
+  /// @brief Number of events used to measure the cuts when :cpp:member:`~JetSelector::m_adaptiveCutOrder` is enabled
+  int  m_nAdaptiveCutOrderEvents = 100;
+
   // configuration variables
   /// @brief input container name
   std::string m_inContainerName = "";
@@ -256,13 +269,22 @@ private:
 
   TH1D* m_jet_cutflowHist_1 = nullptr;  //!
 
-  int   m_jet_cutflow_all;           //!
-  int   m_jet_cutflow_cleaning_cut;  //!
-  int   m_jet_cutflow_ptmax_cut;     //!
-  int   m_jet_cutflow_ptmin_cut;     //!
-  int   m_jet_cutflow_eta_cut;       //!
-  int   m_jet_cutflow_jvt_cut;       //!
-  int   m_jet_cutflow_btag_cut;      //!
+  /// @brief cuts in the object-level cutflow, in the order they are applied
+  enum class JetCut : unsigned int {
+    all, cleaning, ptmax, ptmin, eta, JVT, BTag,
+    // not in the cutflow
+    detEta, mass, rapidity, JVF, fJVT, HLTBTag, HLTVtx, passKeys, failKeys, truthLabel,
+    NCuts
+  };
+  /** @rst
+    per-instance counters for the object-level cutflow, flushed into :cpp:member:`~JetSelector::m_jet_cutflowHist_1` in ``finalize()``
+  @endrst */
+  xAH::CutflowCounter<JetCut> m_jet_cutflow; //!
+  /// @brief order in which the cuts are applied (see :cpp:member:`~JetSelector::m_adaptiveCutOrder`)
+  xAH::CutOrderOptimizer<JetCut> m_jet_cutOrder; //!
+
+  /// @brief apply a single cut of the chain: returns false if the jet fails it
+  bool applyCut( JetCut cut, const xAOD::Jet* jet );
 
   std::vector<CP::SystematicSet> m_systListJVT; //!
   std::vector<CP::SystematicSet> m_systListfJVT; //!
@@ -305,6 +327,7 @@ public:
   virtual EL::StatusCode postExecute ();
   virtual EL::StatusCode finalize ();
   virtual EL::StatusCode histFinalize ();
+  virtual std::string declaredInputs () const;
 
   // these are the functions not inherited from Algorithm
   virtual bool executeSelection( const xAOD::JetContainer* inJets, float mcEvtWeight, bool count, std::string outContainerName, bool isNominal );
@@ -0,0 +1,79 @@
+#ifndef xAODAnaHelpers_MemoryRegistry_H
+#define xAODAnaHelpers_MemoryRegistry_H
+
+/** @file MemoryRegistry.h
+ *  @brief Per-algorithm heap and RSS book-keeping shared by all the algorithms of a job
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+
+class TTree;
+
+namespace xAH {
+
+  /**
+      @rst
+          Job-wide registry of the memory used by each algorithm, filled by the :cpp:class:`AlgorithmTimer` probes when
+          ``xAH_run.py --memory`` is used.
+
+          The heap in use (as reported by ``malloc``) is read before and after each algorithm: the difference is the memory the algorithm
+          allocated and did not release, e.g. histograms booked in ``histInitialize()`` or, per event, the objects it recorded in the
+          TStore. In ``execute()`` this is done only every :cpp:member:`~AlgorithmTimer::m_memorySampleInterval` events, and for each
+          sampled event the RSS of the process and the memory held by the event store (heap growth from the first to the last
+          algorithm of the sequence) are also saved.
+
+          .. note:: The heap and RSS readings are only available on Linux (``/proc/self/statm`` and ``mallinfo2``), and read 0 elsewhere.
+                    The number of allocations is not counted: glibc has no supported counter (the malloc hooks were removed in 2.34), and
+                    an ``operator new`` replaced in this library is not used once the library is loaded by ROOT after ``libstdc++``.
+      @endrst
+   */
+  class MemoryRegistry {
+    public:
+      /** @brief memory allocated by one algorithm in one step */
+      struct Entry {
+        std::string algorithm;
+        std::string step;
+        unsigned long long samples = 0;
+        double totalHeap = 0.;  // [B]
+        double maxHeap   = 0.;  // [B]
+      };
+
+      /** @brief memory usage of the process in one sampled event */
+      struct EventSample {
+        unsigned long long event = 0;
+        double rss       = 0.;  // [B]
+        double heap      = 0.;  // [B]
+        double storeHeap = 0.;  // [B]
+      };
+
+      /** @brief resident set size of the process [B] */
+      static double rss();
+      /** @brief heap memory in use [B] */
+      static double heapInUse();
+
+      /** @brief the entry for ``algorithm`` and ``step`` (created if needed; the pointer stays valid for the whole job) */
+      static Entry* entry( const std::string& algorithm, const std::string& step );
+      /** @brief add one sample of the heap allocated by an algorithm */
+      static void add( Entry* entry, double heapDelta );
+      /** @brief add the memory usage of one sampled event */
+      static void addEvent( const EventSample& sample ) { s_events.push_back( sample ); }
+
+      /** @brief table with one line per algorithm/step, in the order they were first seen, and a summary of the sampled events */
+      static std::string summary();
+      /** @brief fill ``tree`` with one entry per algorithm/step */
+      static void fillTree( TTree* tree );
+      /** @brief fill ``tree`` with one entry per sampled event */
+      static void fillEventTree( TTree* tree );
+
+    private:
+      static std::map<std::string, Entry> s_entries;
+      static std::vector<const Entry*> s_ordered;
+      static std::vector<EventSample> s_events;
+  };
+
+}
+#endif
@@ -1,6 +1,9 @@
 #ifndef xAODAnaHelpers_MinixAOD_H
 #define xAODAnaHelpers_MinixAOD_H
 
+// c++ include(s):
+#include <map>
+
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
 
@@ -12,6 +15,10 @@
 #include <xAODCutFlow/CutBookkeeperContainer.h>
 #include <xAODCutFlow/CutBookkeeperAuxContainer.h>
 
+class TBranch;
+namespace SG { class IConstAuxStore; }
+class TTree;
+
 /**
   @brief Produce xAOD outputs
   @rst
@@ -71,6 +78,25 @@ public:
    */
   std::string m_simpleCopyKeys = "";
 
+  /**
+    @brief copy the :cpp:member:`MinixAOD::m_simpleCopyKeys` containers branch by branch instead of through ``TEvent::copy()``
+
+    @rst
+      For skims writing out input containers untouched. The branches of these containers (interface, auxiliary and dynamic auxiliary
+      branches) are read from the input file straight into the buffers of the corresponding branches of the output tree, so the
+      objects are never converted to their transient form, no auxiliary store is set up and nothing goes through the ``TEvent``
+      bookkeeping. The baskets still have to be decompressed, since only the selected entries are written out.
+
+      The branches are matched in every input file. The ones missing from a file are written with their default value for its events,
+      and the ones that only appear once events have been written out are not copied (with a warning).
+
+      .. note:: The branches are read through a second instance of the input tree, so containers also used by the algorithms of the job are read twice.
+                Use it for the containers that are only written out.
+
+    @endrst
+   */
+  bool m_fastSkim = false;
+
   /**
     @brief names of containers in the TStore to copy over
 
@@ -144,6 +170,39 @@ public:
    */
   std::string m_vectorCopyKeys = "";
 
+  /**
+    @brief auxiliary variables to write out for some of the containers, all the others are dropped
+
+    @rst
+      For each container, a comma-separated list of variable names, where ``*`` and ``?`` are wildcards::
+
+        "m_auxIncludes": "SCAntiKt4EMTopoJets|pt,eta,phi,m,Jvt* SCMuons|pt,eta,phi,charge,muonType"
+
+      Always specify your string in a space-delimited format where pairs are split up by ``container name|variable list``.
+      This works for all the containers (and standalone objects like ``EventInfo``) written out, whichever option they come from, and the
+      variables that are dropped are never written to the output. Only the dynamic variables can be dropped, the static ones of the
+      auxiliary container are always written. The number of (uncompressed) bytes saved this way is printed for each container at the end of the job.
+
+      .. note:: The variables of a container are matched against the lists in the first event, so a dynamic variable that only appears in later events is dropped.
+                With :cpp:member:`MinixAOD::m_fastSkim`, only the dynamic variables of the :cpp:member:`MinixAOD::m_simpleCopyKeys` containers can be dropped.
+
+    @endrst
+   */
+  std::string m_auxIncludes = "";
+
+  /**
+    @brief auxiliary variables to drop for some of the containers
+
+    @rst
+      Same format as :cpp:member:`MinixAOD::m_auxIncludes`, e.g. to drop the decorations of the selectors and the systematic variations::
+
+        "m_auxExcludes": "SCAntiKt4EMTopoJets|passSel*,*_SYS_*"
+
+      A variable is written out if it matches the includes of its container (if any) and none of its excludes.
+    @endrst
+   */
+  std::string m_auxExcludes = "";
+
 private:
   /// A vector of containers that are in TEvent that just need to be written to the output
   std::vector<std::string> m_simpleCopyKeys_vec; //!
@@ -154,9 +213,53 @@ private:
   /// A vector of (name of vector of container names, parent name) pairs for shallow-copied objects (like systematics) -- if parent is empty, deep-copy it
   std::vector<std::pair<std::string, std::string>> m_vectorCopyKeys_vec; //!
 
+  /// (container name, variable patterns) to keep and to drop
+  std::map<std::string, std::vector<std::string>> m_auxIncludes_map; //!
+  std::map<std::string, std::vector<std::string>> m_auxExcludes_map; //!
+
+  /// What is dropped from a container, worked out in the first event
+  struct AuxSlimming {
+    bool configured = false;
+    unsigned int numKept = 0;
+    std::vector<std::string> dropped;
+    /// size in memory of the dropped (dynamic) variables of one element
+    std::size_t droppedElementSize = 0;
+    double bytesDropped = 0;
+  };
+  std::map<std::string, AuxSlimming> m_auxSlimming; //!
+
+  /// @brief fill ``lists`` from the ``container|variable,...`` items of the option ``optionName``
+  EL::StatusCode parseAuxLists( const std::string& optionName, const std::string& option, std::map<std::string, std::vector<std::string>>& lists );
+  /// @brief the auxiliary store of the container or standalone object ``key``, in TEvent or TStore
+  EL::StatusCode retrieveAuxStore( const std::string& key, const SG::IConstAuxStore*& auxStore );
+  /// @brief set the aux item list of ``key`` in the output, the first time it is seen
+  EL::StatusCode configureAuxSlimming( const std::string& key, AuxSlimming& slimming );
+
   /// A vector of containers (and aux-pairs) in TStore to record in TEvent
   std::vector<std::string> m_copyFromStoreToEventKeys_vec; //!
 
+  /// A branch copied as is from the input to the output with m_fastSkim: both point to the same buffer
+  struct RawBranch {
+    TBranch* input = nullptr;
+    TBranch* output = nullptr;
+    /// the object, for branches of a class (containers, vectors)
+    void* object = nullptr;
+    std::string className = "";
+    /// the buffer, for branches of a basic type
+    std::vector<char> buffer;
+  };
+  /// Branches copied with m_fastSkim, by name
+  std::map<std::string, RawBranch> m_rawBranches; //!
+  /// Second instance of the input event tree, to read the m_fastSkim branches independently of TEvent
+  TTree* m_rawInputTree = nullptr; //!
+  /// Size of its TTreeCache
+  Long64_t m_rawCacheSize = 10*1024*1024; //!
+  /// The output event tree of TEvent, the m_fastSkim branches are added to it
+  TTree* m_rawOutputTree = nullptr; //!
+
+  /// @brief connect the m_fastSkim branches of the current input file, creating the output branches for the first file
+  EL::StatusCode connectRawBranches();
+
   /// Pointer for the File MetaData Tool
   xAODMaker::FileMetaDataTool          *m_fileMetaDataTool = nullptr;    //!
   /// Pointer for the TriggerMenu MetaData Tool
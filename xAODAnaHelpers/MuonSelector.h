@@ -11,6 +11,7 @@
 // EDM include(s):
 #include "xAODMuon/MuonContainer.h"
 #include "xAODTracking/Vertex.h"
+#include "xAODEventInfo/EventInfo.h"
 
 // ROOT include(s):
 #include "TH1D.h"
@@ -24,6 +25,8 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/CutflowCounter.h"
+#include "xAODAnaHelpers/CutOrderOptimizer.h"
 
 // forward-declare for now until IsolationSelectionTool interface is updated
 namespace CP {
@@ -40,6 +43,19 @@ public:
   // cutflow
   bool m_useCutFlow = true;
 
+  /**
+    @rst
+      When no cutflow is filled (:cpp:member:`~MuonSelector::m_useCutFlow` is ``false``), measure rejection and time per call of every cut
+      during the first :cpp:member:`~MuonSelector::m_nAdaptiveCutOrderEvents` events, then apply the cuts in the order minimising the time
+      spent per muon. ``passSel`` is unchanged. The cuts do not decorate the muon: the quality and track decorations (``isTightQ``, ...,
+      ``z0sintheta``, ``d0sig``) are set on every muon before the cuts, and the isolation decisions computed by the cuts are decorated after
+      them, on the selected muons only.
+    @endrst
+  */
+  bool m_adaptiveCutOrder = false;
+  /// @brief Number of events used to measure the cuts when :cpp:member:`~MuonSelector::m_adaptiveCutOrder` is enabled
+  int  m_nAdaptiveCutOrderEvents = 100;
+
   // configuration variables
   /** input container name */
   std::string    m_inContainerName = "";
@@ -124,16 +140,32 @@ private:
   TH1D* m_mu_cutflowHist_1 = nullptr;                 //!
   TH1D* m_mu_cutflowHist_2 = nullptr;                 //!
 
-  int   m_mu_cutflow_all;		    //!
-  int   m_mu_cutflow_eta_and_quaility_cut;  //!
-  int   m_mu_cutflow_ptmax_cut;  	    //!
-  int   m_mu_cutflow_ptmin_cut;  	    //!
-  int   m_mu_cutflow_type_cut;		    //!
-  int   m_mu_cutflow_z0sintheta_cut;	    //!
-  int   m_mu_cutflow_d0_cut;		    //!
-  int   m_mu_cutflow_d0sig_cut;  	    //!
-  int   m_mu_cutflow_iso_cut;		    //!
-  int   m_mu_cutflow_cosmic_cut;		    //!
+  /// @brief cuts in the object-level cutflow, in the order they are applied
+  enum class MuonCut : unsigned int {
+    all, etaAndQuality, ptmax, ptmin, type, z0sintheta, d0, d0sig, iso, cosmic,
+    NCuts
+  };
+  /** @rst
+    per-instance counters for the object-level cutflow, flushed into :cpp:member:`~MuonSelector::m_mu_cutflowHist_1` (or ``_2``) in ``finalize()``
+  @endrst */
+  xAH::CutflowCounter<MuonCut> m_mu_cutflow; //!
+  /// @brief order in which the cuts are applied (see :cpp:member:`~MuonSelector::m_adaptiveCutOrder`)
+  xAH::CutOrderOptimizer<MuonCut> m_mu_cutOrder; //!
+
+  /// @brief apply a single cut of the chain: returns false if the muon fails it. It does not decorate the muon
+  bool applyCut( MuonCut cut, const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex );
+  /// @brief compute and decorate the quality and track variables read by the cuts
+  void decorateTrackVariables( const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex, const xAOD::EventInfo* eventInfo );
+
+  /// @brief track variables of the muon being selected, set by decorateTrackVariables()
+  struct TrackVariables {
+    bool  hasTrack = false;
+    float z0sintheta = 1e8;
+    float d0sig = 0.;
+  };
+  TrackVariables m_mu_track; //!
+  /// @brief isolation decisions computed by the cuts for the muon being selected, decorated if it passes all of them
+  std::vector< std::pair<std::string, char> > m_mu_toolDecisions; //!
 
   std::vector<std::string> m_IsoKeys;       //!
 
@@ -176,11 +208,12 @@ public:
   virtual EL::StatusCode postExecute ();
   virtual EL::StatusCode finalize ();
   virtual EL::StatusCode histFinalize ();
+  virtual std::string declaredInputs () const;
 
   // added functions not from Algorithm
   bool executeSelection( const xAOD::MuonContainer* inMuons, float mcEvtWeight, bool countPass,
-                         ConstDataVector<xAOD::MuonContainer>* selectedMuons );
-  virtual int passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex );
+                         ConstDataVector<xAOD::MuonContainer>* selectedMuons, const xAOD::EventInfo* eventInfo );
+  virtual int passCuts( const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex, const xAOD::EventInfo* eventInfo );
 
   /// @cond
   // this is needed to distribute the algorithm to the workers
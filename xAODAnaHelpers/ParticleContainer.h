@@ -4,14 +4,18 @@
 #include <TTree.h>
 #include <TLorentzVector.h>
 
+#include <algorithm>
 #include <vector>
 #include <string>
+#include <cmath>
 
 #include <xAODAnaHelpers/HelperClasses.h>
 #include <xAODAnaHelpers/HelperFunctions.h>
 
 #include <xAODAnaHelpers/Particle.h>
 #include <xAODBase/IParticle.h>
+#include <AthContainers/AuxVectorData.h>
+#include <AthContainers/OwnershipPolicy.h>
 
 namespace xAH {
 
@@ -117,7 +121,8 @@ namespace xAH {
       {
 	m_n++;
 
-	if( m_infoSwitch.m_kinematic ){
+	// the kinematics may have been filled already for the whole container by FillParticles()
+	if( m_infoSwitch.m_kinematic && m_pt->size() < static_cast<std::size_t>(m_n) ){
 	  m_pt  -> push_back ( particle->pt() / m_units );
 	  m_eta -> push_back( particle->eta() );
 	  m_phi -> push_back( particle->phi() );
@@ -126,6 +131,90 @@ namespace xAH {
 	}
       }
 
+      /**
+	 @rst
+	   Fill the kinematic branches for all the objects of ``container`` at once, before calling the per-object fill for each of them
+	   (in the same order): :cpp:func:`~xAH::ParticleContainer::FillParticle` then skips the kinematics already filled.
+
+	   If the four-momentum is stored as ``pt``, ``eta``, ``phi`` and ``m`` aux columns (electrons, photons, jets, taus), the columns are
+	   copied and scaled in tight loops over contiguous floats. For view containers (the ``ConstDataVector`` written by the selectors), the
+	   columns of the container holding the elements are read at the index of each element, provided they all come from the same one.
+	   Otherwise (elements of several containers, four-momenta computed on the fly like for muons, tracks, clusters or truth particles)
+	   nothing is done here, and the kinematics are filled object by object as usual.
+	 @endrst
+      */
+      template<typename T_CONTAINER> void FillParticles(const T_CONTAINER* container)
+      {
+	if( !m_infoSwitch.m_kinematic || !container || container->empty() ) return;
+	if( m_pt->size() != static_cast<std::size_t>(m_n) ) return;
+
+	// the columns are those of the container itself, or for a view those of the container of its elements, read at their index
+	const std::size_t n = container->size();
+	const SG::AuxVectorData* store = container;
+	std::vector<std::size_t> index;
+	if( container->ownPolicy() != SG::OWN_ELEMENTS ) {
+	  store = container->front()->container();
+	  if( !store ) return;
+	  index.reserve( n );
+	  for( const auto particle : *container ) {
+	    if( particle->container() != store ) return;
+	    index.push_back( particle->index() );
+	  }
+	}
+	if( !store->hasStore() ) return;
+
+	static const SG::AuxElement::ConstAccessor<float> ptAcc ("pt");
+	static const SG::AuxElement::ConstAccessor<float> etaAcc("eta");
+	static const SG::AuxElement::ConstAccessor<float> phiAcc("phi");
+	static const SG::AuxElement::ConstAccessor<float> mAcc  ("m");
+	if( !store->isAvailable<float>("pt")  || !store->isAvailable<float>("eta") ||
+	    !store->isAvailable<float>("phi") || !store->isAvailable<float>("m") ) return;
+
+	const float* pt  = ptAcc .getDataArray( *store );
+	const float* eta = etaAcc.getDataArray( *store );
+	const float* phi = phiAcc.getDataArray( *store );
+	const float* m   = mAcc  .getDataArray( *store );
+	const std::size_t* idx = index.empty() ? nullptr : index.data();
+
+	// same arithmetic (in double precision) as the per-object path
+	const double units = m_units;
+	const std::size_t offset = m_pt->size();
+	m_pt ->resize( offset + n );
+	m_eta->resize( offset + n );
+	m_phi->resize( offset + n );
+	float* ptOut  = m_pt ->data() + offset;
+	float* etaOut = m_eta->data() + offset;
+	float* phiOut = m_phi->data() + offset;
+	if( idx ) {
+	  for( std::size_t i = 0; i < n; ++i ) {
+	    ptOut[i]  = static_cast<double>(pt[idx[i]]) / units;
+	    etaOut[i] = eta[idx[i]];
+	    phiOut[i] = phi[idx[i]];
+	  }
+	} else {
+	  for( std::size_t i = 0; i < n; ++i ) ptOut[i] = static_cast<double>(pt[i]) / units;
+	  std::copy( eta, eta + n, etaOut );
+	  std::copy( phi, phi + n, phiOut );
+	}
+
+	if( m_useMass ) {
+	  m_M->resize( offset + n );
+	  float* mOut = m_M->data() + offset;
+	  for( std::size_t i = 0; i < n; ++i ) mOut[i] = static_cast<double>(m[idx ? idx[i] : i]) / units;
+	} else {
+	  // E of a (pt, eta, phi, m) four-vector, as in ROOT::Math::PtEtaPhiM4D
+	  m_E->resize( offset + n );
+	  float* eOut = m_E->data() + offset;
+	  for( std::size_t i = 0; i < n; ++i ) {
+	    const std::size_t k = idx ? idx[i] : i;
+	    const double p  = static_cast<double>(pt[k]) * std::cosh( static_cast<double>(eta[k]) );
+	    const double mi = m[k];
+	    const double e2 = p * p + ( ( mi >= 0 ) ? mi * mi : -mi * mi );
+	    eOut[i] = ( ( e2 > 0 ) ? std::sqrt( e2 ) : 0. ) / units;
+	  }
+	}
+      }
+
       void updateEntry()
       {
         m_particles.clear();
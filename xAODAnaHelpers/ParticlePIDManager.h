@@ -22,6 +22,7 @@
 
 // C++ include(s)
 #include <string>
+#include <vector>
 
 ANA_MSG_HEADER(msgPIDManager)
 
@@ -48,10 +49,22 @@ class ElectronLHPIDManager
     /* returns a string containing only the WPs >= selected WP */
     const std::set<std::string>  getValidWPs() { return m_validWPs; };
 
+    /* returns the WPs with a configured tool, ordered from the loosest to the tightest */
+    const std::vector<std::string>& getValidWPsByTightness() { return m_validWPsByTightness; };
+    /* returns the position of the selected WP in getValidWPsByTightness() */
+    unsigned int getSelectedWPIndex() { return m_selectedWPIndex; };
+
+    /* evaluate the tools from the loosest to the tightest WP, stopping at the first failure: the menus are nested, so the tighter WPs
+       are failed too. Returns the number of WPs passed, i.e. the electron passes the i-th WP of getValidWPsByTightness() if i < returned value */
+    unsigned int acceptNested( const xAOD::Electron* electron );
+
   private:
 
     std::string m_selectedWP;
     bool        m_debug;
+    std::vector<std::string> m_validWPsByTightness;
+    std::vector<AsgElectronLikelihoodTool*> m_validWPToolsByTightness;
+    unsigned int m_selectedWPIndex;
     std::multimap<std::string, AsgElectronLikelihoodTool*> m_allWPTools;
     std::multimap<std::string, AsgElectronLikelihoodTool*> m_validWPTools;
     std::set<std::string> m_allWPAuxDecors;
@@ -88,10 +101,24 @@ class ElectronCutBasedPIDManager
     /* returns a string containing only the WPs >= selected WP */
     const std::set<std::string>  getValidWPs() { return m_validWPs; };
 
+    /* returns the WPs with a configured tool, ordered from the loosest to the tightest */
+    const std::vector<std::string>& getValidWPsByTightness() { return m_validWPsByTightness; };
+    /* returns the tools of getValidWPsByTightness(), in the same order */
+    const std::vector<AsgElectronIsEMSelector*>& getValidWPToolsByTightness() { return m_validWPToolsByTightness; };
+    /* returns the position of the selected WP in getValidWPsByTightness() */
+    unsigned int getSelectedWPIndex() { return m_selectedWPIndex; };
+
+    /* evaluate the tools from the loosest to the tightest WP, stopping at the first failure: the menus are nested, so the tighter WPs
+       are failed too. Returns the number of WPs passed, i.e. the electron passes the i-th WP of getValidWPsByTightness() if i < returned value */
+    unsigned int acceptNested( const xAOD::Electron* electron );
+
   private:
 
     std::string m_selectedWP;
     bool        m_debug;
+    std::vector<std::string> m_validWPsByTightness;
+    std::vector<AsgElectronIsEMSelector*> m_validWPToolsByTightness;
+    unsigned int m_selectedWPIndex;
 
     std::multimap<std::string, AsgElectronIsEMSelector*> m_allWPTools;
     std::multimap<std::string, AsgElectronIsEMSelector*> m_validWPTools;
@@ -3,6 +3,7 @@
 
 // algorithm wrapper
 #include <xAODAnaHelpers/Algorithm.h>
+#include <xAODAnaHelpers/CutflowCounter.h>
 #include <xAODTracking/VertexContainer.h>
 #include <xAODEgamma/PhotonContainer.h>
 
@@ -78,14 +79,15 @@ private:
 
   TH1D* m_ph_cutflowHist_1 = nullptr;            //!
 
-  int   m_ph_cutflow_all;              //!
-  int   m_ph_cutflow_author_cut;       //!
-  int   m_ph_cutflow_OQ_cut;           //!
-  int   m_ph_cutflow_PID_cut;          //!
-  int   m_ph_cutflow_ptmax_cut;        //!
-  int   m_ph_cutflow_ptmin_cut;        //!
-  int   m_ph_cutflow_eta_cut;          //!
-  int   m_ph_cutflow_iso_cut;          //!
+  /// @brief cuts in the object-level cutflow, in the order they are applied
+  enum class PhotonCut : unsigned int {
+    all, author, OQ, PID, ptmax, ptmin, eta, iso,
+    NCuts
+  };
+  /** @rst
+    per-instance counters for the object-level cutflow, flushed into :cpp:member:`~PhotonSelector::m_ph_cutflowHist_1` in ``finalize()``
+  @endrst */
+  xAH::CutflowCounter<PhotonCut> m_ph_cutflow; //!
 
 
   std::vector<std::string> m_IsoKeys;  //!
@@ -112,6 +114,7 @@ public:
   virtual EL::StatusCode postExecute ();
   virtual EL::StatusCode finalize ();
   virtual EL::StatusCode histFinalize ();
+  virtual std::string declaredInputs () const;
 
   /* these are the functions not inherited from Algorithm */
 
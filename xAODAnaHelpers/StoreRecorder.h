@@ -0,0 +1,115 @@
+#ifndef xAODAnaHelpers_StoreRecorder_H
+#define xAODAnaHelpers_StoreRecorder_H
+
+// algorithm wrapper
+#include "xAODAnaHelpers/Algorithm.h"
+
+/**
+  @brief Snapshot the TStore contents of the first N events in an xAOD file, to be replayed with :cpp:class:`StoreReplayer`
+  @rst
+
+    Put this algorithm at the end of the upstream part of a job (e.g. after the calibrators and the selectors) to save, for each event,
+    deep copies of the listed TStore containers -- calibrated shallow copies, selected ``ConstDataVector`` views or deep copies alike --
+    together with the vectors of systematic names the downstream algorithms loop over, and the ``EventInfo`` (with its decorations) from the input.
+
+    The output file can then be used as the input of a job made of :cpp:class:`StoreReplayer` followed by the single algorithm to profile
+    (e.g. ``METConstructor`` or ``OverlapRemover``): none of the upstream algorithms or their CP tools need to run again.
+
+    For example, to record the jets and muons of all the jet and muon systematics::
+
+        c.algorithm("StoreRecorder", { "m_name"            : "recordInputs",
+                                       "m_nEventsToRecord" : 2000,
+                                       "m_storeKeys"       : "SelectedElectrons",
+                                       "m_systKeys"        : "JetCalibrator_Syst|SignalJets MuonCalibrator_Syst|SignalMuons" } )
+
+    The deep copies keep the element links of the objects, which point to the input containers. The input containers the
+    ``originalObjectLink`` of the recorded objects point to (e.g. ``AntiKt4EMTopoJets`` for the calibrated jets) are copied over
+    automatically, so that the shallow copies can be matched to their original objects in the replay. The other links have to be resolved
+    by listing their containers in :cpp:member:`~StoreRecorder::m_simpleCopyKeys`: to replay ``METConstructor``, also copy its
+    ``m_coreName``, ``m_mapName`` and ``m_referenceMETContainer``, the primary vertices and the tracks and clusters the MET association
+    map links to, e.g.::
+
+        "m_simpleCopyKeys" : "EventInfo PrimaryVertices InDetTrackParticles CaloCalTopoClusters MET_Core_AntiKt4EMTopo METAssoc_AntiKt4EMTopo MET_Reference_AntiKt4EMTopo"
+
+    .. note:: The file is written through the ``TEvent`` of the job, so there can not be a :cpp:class:`MinixAOD` in the same job.
+
+  @endrst
+
+ */
+class StoreRecorder : public xAH::Algorithm
+{
+public:
+  /// @brief name of the output stream (and file) the events are recorded to
+  std::string m_outputFileName = "xAH_storeRecord";
+
+  /// @brief number of events to record (all of them if negative). The job keeps running, but nothing else is written
+  int m_nEventsToRecord = 1000;
+
+  /// @brief space-delimited names of containers to copy over from the input file (with their decorations)
+  std::string m_simpleCopyKeys = "EventInfo";
+
+  /// @brief space-delimited names of containers in the TStore to record
+  std::string m_storeKeys = "";
+
+  /**
+    @brief space-delimited ``systematics vector name|container name`` pairs
+
+    @rst
+      Each vector of systematic names is recorded, as well as the containers named ``container name + systematic name`` for all
+      its systematics (the empty name being the nominal)::
+
+          "m_systKeys": "JetCalibrator_Syst|SignalJets MuonCalibrator_Syst|SignalMuons"
+
+    @endrst
+   */
+  std::string m_systKeys = "";
+
+  /// @brief names of the per-event vectors listing what was recorded, read back by :cpp:class:`StoreReplayer`
+  static const std::string RecordedContainersKey;
+  static const std::string RecordedVectorsKey;
+
+private:
+  std::vector<std::string> m_simpleCopyKeys_vec; //!
+  std::vector<std::string> m_storeKeys_vec; //!
+  /// (name of vector of systematic names, container name) pairs
+  std::vector<std::pair<std::string, std::string>> m_systKeys_vec; //!
+
+  int m_numRecorded = 0; //!
+
+  /// @brief input containers the ``originalObjectLink`` of the objects recorded in this event point to
+  std::vector<std::string> m_linkedKeys; //!
+
+  /// @brief deep-copy the TStore container ``key`` into the output ``TEvent``, under the same name
+  template <typename T1, typename T2, typename T3>
+  EL::StatusCode recordDeepCopy( const std::string& key );
+
+  /// @brief add to :cpp:member:`~StoreRecorder::m_linkedKeys` the containers the ``originalObjectLink`` of the objects of ``cont`` point to
+  template <typename T1>
+  void collectOriginalLinks( const T1* cont );
+
+  /// @brief deep-copy ``key`` whatever its type, returns FAILURE if it is not one of the supported containers
+  EL::StatusCode recordContainer( const std::string& key );
+
+public:
+  // this is a standard constructor
+  StoreRecorder ();
+
+  // these are the functions inherited from Algorithm
+  virtual EL::StatusCode setupJob (EL::Job& job);
+  virtual EL::StatusCode fileExecute ();
+  virtual EL::StatusCode histInitialize ();
+  virtual EL::StatusCode changeInput (bool firstFile);
+  virtual EL::StatusCode initialize ();
+  virtual EL::StatusCode execute ();
+  virtual EL::StatusCode postExecute ();
+  virtual EL::StatusCode finalize ();
+  virtual EL::StatusCode histFinalize ();
+
+  /// @cond
+  // this is needed to distribute the algorithm to the workers
+  ClassDef(StoreRecorder, 1);
+  /// @endcond
+
+};
+
+#endif
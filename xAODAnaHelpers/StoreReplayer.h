@@ -0,0 +1,63 @@
+#ifndef xAODAnaHelpers_StoreReplayer_H
+#define xAODAnaHelpers_StoreReplayer_H
+
+// algorithm wrapper
+#include "xAODAnaHelpers/Algorithm.h"
+
+/**
+  @brief Put the containers recorded by :cpp:class:`StoreRecorder` back in the TStore
+  @rst
+
+    Run on the file written by :cpp:class:`StoreRecorder`, as the first algorithm of the job. In each event, every recorded container
+    is put in the TStore under its original name as a shallow copy of the one read from the file (so that the downstream algorithms
+    can decorate and modify it as usual), and every recorded vector of systematic names is put back in the TStore. The ``EventInfo``
+    and anything else copied from the original input is read from the file as usual.
+
+    The downstream algorithm then runs on exactly the same input as in the original job, without any of the upstream algorithms::
+
+        c.algorithm("StoreReplayer",  { "m_name" : "replayInputs" } )
+        c.algorithm("OverlapRemover", { ... } )
+
+    and ``xAH_run.py --timing`` or an external profiler only sees that one algorithm. Use ``--nevents`` to control the length of the job.
+
+    The ``originalObjectLink`` of the replayed objects must resolve: the job fails if the container they point to is not in the input
+    (see :cpp:class:`StoreRecorder` for the element links and the containers ``METConstructor`` needs).
+
+  @endrst
+
+ */
+class StoreReplayer : public xAH::Algorithm
+{
+private:
+  int m_numReplayed = 0; //!
+
+  /// @brief shallow-copy the input container ``key`` into the TStore under the same name
+  template <typename T1>
+  EL::StatusCode replayShallowCopy( const std::string& key );
+
+  /// @brief shallow-copy ``key`` whatever its type, returns FAILURE if it is not one of the supported containers
+  EL::StatusCode replayContainer( const std::string& key );
+
+public:
+  // this is a standard constructor
+  StoreReplayer ();
+
+  // these are the functions inherited from Algorithm
+  virtual EL::StatusCode setupJob (EL::Job& job);
+  virtual EL::StatusCode fileExecute ();
+  virtual EL::StatusCode histInitialize ();
+  virtual EL::StatusCode changeInput (bool firstFile);
+  virtual EL::StatusCode initialize ();
+  virtual EL::StatusCode execute ();
+  virtual EL::StatusCode postExecute ();
+  virtual EL::StatusCode finalize ();
+  virtual EL::StatusCode histFinalize ();
+
+  /// @cond
+  // this is needed to distribute the algorithm to the workers
+  ClassDef(StoreReplayer, 1);
+  /// @endcond
+
+};
+
+#endif
@@ -20,6 +20,7 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/CutflowCounter.h"
 
 class TauSelector : public xAH::Algorithm
 {
@@ -98,11 +99,18 @@ private:
   bool  m_isUsedBefore;     //!
 
   // object cutflow
-  TH1D* m_tau_cutflowHist_1;                //!
-  TH1D* m_tau_cutflowHist_2;                //!
-
-  int   m_tau_cutflow_all;		    //!
-  int   m_tau_cutflow_selected;             //!
+  TH1D* m_tau_cutflowHist_1 = nullptr;      //!
+  TH1D* m_tau_cutflowHist_2 = nullptr;      //!
+
+  /// @brief cuts in the object-level cutflow, in the order they are applied
+  enum class TauCut : unsigned int {
+    all, selected,
+    NCuts
+  };
+  /** @rst
+    per-instance counters for the object-level cutflow, flushed into :cpp:member:`~TauSelector::m_tau_cutflowHist_1` (or ``_2``) in ``finalize()``
+  @endrst */
+  xAH::CutflowCounter<TauCut> m_tau_cutflow; //!
 
   // tools
   std::vector<std::string>            m_singleTauTrigChainsList; //!  /* contains all the HLT trigger chains tokens extracted from m_singleTauTrigChains */
@@ -137,6 +145,7 @@ public:
   virtual EL::StatusCode postExecute ();
   virtual EL::StatusCode finalize ();
   virtual EL::StatusCode histFinalize ();
+  virtual std::string declaredInputs () const;
 
   // added functions not from Algorithm
   bool executeSelection( const xAOD::TauJetContainer* inTaus, float mcEvtWeight, bool countPass,
@@ -0,0 +1,120 @@
+#ifndef xAODAnaHelpers_TimingRegistry_H
+#define xAODAnaHelpers_TimingRegistry_H
+
+/** @file TimingRegistry.h
+ *  @brief Per-algorithm latency book-keeping shared by all the algorithms of a job
+ *  @author See AUTHORS.md
+ *  @bug No known bugs
+ */
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+class TTree;
+
+namespace xAH {
+
+  /**
+      @rst
+          Distribution of the time spent in one step (``execute``, ``postExecute`` or one systematic) of one algorithm.
+
+          The times are counted in fixed logarithmic bins (20 per decade, from 100 ns to 1000 s), so that adding one measurement is
+          cheap and the quantiles can be extracted at the end of the job with a relative precision of about 6%.
+      @endrst
+   */
+  class LatencyStats {
+    public:
+      /** @brief add one measurement [s] */
+      void add( double seconds );
+
+      /** @brief number of measurements */
+      unsigned long long entries() const { return m_entries; }
+      /** @brief total time [s] */
+      double total() const { return m_total; }
+      /** @brief mean time [s] */
+      double mean() const { return ( m_entries ) ? m_total / m_entries : 0.; }
+      /** @brief quantile ``q`` (between 0 and 1) of the times [s], interpolated within the bin */
+      double quantile( double q ) const;
+
+    private:
+      static constexpr int    NBinsPerDecade = 20;
+      static constexpr int    NBins          = 10 * NBinsPerDecade;
+      static constexpr double MinTime        = 1e-7;
+
+      std::array<unsigned long long, NBins + 2> m_counts{}; // underflow, bins, overflow
+      unsigned long long m_entries = 0;
+      double m_total = 0.;
+  };
+
+  /**
+      @rst
+          Job-wide registry of the :cpp:class:`xAH::LatencyStats`, keyed by algorithm name, step and systematic.
+
+          The times are filled by the :cpp:class:`AlgorithmTimer` probes, which ``xAH_run.py --timing`` puts around every algorithm
+          of the job, and by :cpp:func:`xAH::Algorithm::timeSystematic` inside the systematic loops. Nothing is recorded unless
+          :cpp:func:`xAH::TimingRegistry::enable` has been called, which the first probe does in ``initialize()``.
+      @endrst
+   */
+  class TimingRegistry {
+    public:
+      typedef std::chrono::steady_clock clock;
+
+      /** @brief start recording */
+      static void enable() { s_enabled = true; }
+      /** @brief true if the times are being recorded */
+      static bool enabled() { return s_enabled; }
+
+      /** @brief the distribution for ``algorithm``, ``step`` and ``systematic`` (created if needed; the pointer stays valid for the whole job) */
+      static LatencyStats* stats( const std::string& algorithm, const std::string& step, const std::string& systematic = "" );
+
+      /** @brief time spent in the timing probes themselves */
+      static LatencyStats& overhead() { return s_overhead; }
+
+      /** @brief table with one line per algorithm/step/systematic, in the order they were first seen */
+      static std::string summary();
+      /** @brief fill ``tree`` with one entry per algorithm/step/systematic */
+      static void fillTree( TTree* tree );
+      /** @brief write the same content as :cpp:func:`xAH::TimingRegistry::fillTree` in a JSON file */
+      static bool writeJSON( const std::string& fileName );
+
+    private:
+      struct Entry {
+        std::string algorithm;
+        std::string step;
+        std::string systematic;
+        LatencyStats stats;
+      };
+
+      static bool s_enabled;
+      static std::map<std::string, Entry> s_entries;
+      static std::vector<const Entry*> s_ordered;
+      static LatencyStats s_overhead;
+  };
+
+  /**
+      @rst
+          Add the time elapsed between its construction and its destruction to a :cpp:class:`xAH::LatencyStats` (if not ``nullptr``).
+          See :cpp:func:`xAH::Algorithm::timeSystematic`.
+      @endrst
+   */
+  class ScopedTimer {
+    public:
+      explicit ScopedTimer( LatencyStats* stats ) :
+        m_stats( stats ), m_start( stats ? TimingRegistry::clock::now() : TimingRegistry::clock::time_point() ) {}
+      ScopedTimer( ScopedTimer&& other ) : m_stats( other.m_stats ), m_start( other.m_start ) { other.m_stats = nullptr; }
+      ScopedTimer( const ScopedTimer& ) = delete;
+      ScopedTimer& operator=( const ScopedTimer& ) = delete;
+      ~ScopedTimer() {
+        if ( m_stats ) m_stats->add( std::chrono::duration<double>( TimingRegistry::clock::now() - m_start ).count() );
+      }
+
+    private:
+      LatencyStats* m_stats;
+      TimingRegistry::clock::time_point m_start;
+  };
+
+}
+#endif
@@ -1,9 +1,14 @@
 #ifndef xAODAnaHelpers_TrackSelector_H
 #define xAODAnaHelpers_TrackSelector_H
 
+// c++ include(s):
+#include <memory>
+#include <vector>
+
 // ROOT include(s):
 #include "TH1D.h"
 
+#include "AthContainers/AuxElement.h"
 #include "xAODTracking/VertexContainer.h"
 #include "xAODTracking/TrackParticleContainer.h"
 
@@ -65,12 +70,40 @@ public:
 
   /// @brief do track selection on track within jets
   bool m_doTracksInJets = false;
+  /**
+    @brief select the tracks of each jet all at once rather than one at a time with PassCuts
+    @rst
+        The parameters used by the configured cuts are gathered for all the tracks of a jet into one array per parameter, then each cut
+        is applied to the whole array. The selection is the same as that of :cpp:func:`TrackSelector::PassCuts`: turn this off in a
+        class overriding ``PassCuts``.
+    @endrst
+  */
+  bool m_batchTracksInJets = true;
 
 private:
 
   std::vector<std::string> m_passKeys;
   std::vector<std::string> m_failKeys;
 
+  /// @brief the parameters of the tracks of one jet, one array per parameter (only those needed by the configured cuts are filled)
+  struct TrackBatch {
+    std::vector<double>   pt, eta;
+    std::vector<float>    d0, z0, sinTheta, chi2, ndof;
+    std::vector<uint8_t>  nBL, nPixHoles;
+    std::vector<uint16_t> nSi;
+    std::vector<char>     pass;
+  };
+  TrackBatch m_batch; //!
+  std::vector<const xAOD::TrackParticle*> m_selectedTracks; //!
+
+  // the decorations of the jets read and written by executeTracksInJets
+  std::unique_ptr< SG::AuxElement::ConstAccessor< std::vector<const xAOD::TrackParticle*> > > m_inTracksAcc; //!
+  std::unique_ptr< SG::AuxElement::ConstAccessor< const xAOD::Vertex* > >                    m_inVtxAcc; //!
+  std::unique_ptr< SG::AuxElement::Decorator< std::vector<const xAOD::TrackParticle*> > >     m_outTracksDecor; //!
+  std::unique_ptr< SG::AuxElement::Decorator< const xAOD::Vertex* > >                         m_outVtxDecor; //!
+  std::vector< SG::AuxElement::ConstAccessor< char > > m_passAccs; //!
+  std::vector< SG::AuxElement::ConstAccessor< char > > m_failAccs; //!
+
   int m_numEvent;         //!
   int m_numObject;        //!
   int m_numEventPass;     //!
@@ -105,11 +138,15 @@ public:
   virtual EL::StatusCode postExecute ();
   virtual EL::StatusCode finalize ();
   virtual EL::StatusCode histFinalize ();
+  virtual std::string declaredInputs () const;
 
   // added functions not from Algorithm
   // why does this need to be virtual?
   virtual int PassCuts( const xAOD::TrackParticle* jet, const xAOD::Vertex *pvx );
 
+  /// @brief apply the cuts of PassCuts to all of ``tracks``, the decision for each is left in ``m_batch.pass``
+  void PassCutsBatch( const std::vector<const xAOD::TrackParticle*>& tracks, const xAOD::Vertex *pvx );
+
   /// @cond
   // this is needed to distribute the algorithm to the workers
   ClassDef(TrackSelector, 1);
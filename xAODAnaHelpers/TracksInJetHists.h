@@ -21,6 +21,7 @@ class TracksInJetHists : public HistogramManager
     using HistogramManager::book; // make other overloaded versions of book() to show up in subclass
     using HistogramManager::execute; // overload
     virtual void record(EL::Worker* wk);
+    virtual MemoryUsage memoryUsage() const;
 
   protected:
 
@@ -107,6 +107,7 @@ public:
   virtual EL::StatusCode postExecute ();                    //!
   virtual EL::StatusCode finalize ();                       //!
   virtual EL::StatusCode histFinalize ();                   //!
+  virtual std::string declaredInputs () const;
 
   // Help tree creator function
   virtual HelpTreeBase* createTree(xAOD::TEvent *event, TTree* tree, TFile* file, const float units, bool debug, xAOD::TStore* store); //!
@@ -93,6 +93,7 @@ public:
   virtual EL::StatusCode setupJob (EL::Job& job);
   virtual EL::StatusCode initialize ();
   virtual EL::StatusCode execute ();
+  virtual std::string declaredInputs () const;
 
   /* these are the functions not inherited from Algorithm */
   EL::StatusCode executeMatching( const xAOD::IParticleContainer* inParticles );
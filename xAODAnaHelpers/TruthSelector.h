@@ -10,6 +10,7 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/CutflowCounter.h"
 
 // external tools include(s):
 #include "xAODBTaggingEfficiency/BTaggingSelectionTool.h"
@@ -71,10 +72,15 @@ private:
 
   TH1D* m_truth_cutflowHist_1 = nullptr;  //!
 
-  int   m_truth_cutflow_all;           //!
-  int   m_truth_cutflow_ptmax_cut;     //!
-  int   m_truth_cutflow_ptmin_cut;     //!
-  int   m_truth_cutflow_eta_cut;       //!
+  /// @brief cuts in the object-level cutflow, in the order they are applied
+  enum class TruthCut : unsigned int {
+    all, ptmax, ptmin, eta,
+    NCuts
+  };
+  /** @rst
+    per-instance counters for the object-level cutflow, flushed into :cpp:member:`~TruthSelector::m_truth_cutflowHist_1` in ``finalize()``
+  @endrst */
+  xAH::CutflowCounter<TruthCut> m_truth_cutflow; //!
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
@@ -96,6 +102,7 @@ public:
   virtual EL::StatusCode postExecute ();
   virtual EL::StatusCode finalize ();
   virtual EL::StatusCode histFinalize ();
+  virtual std::string declaredInputs () const;
 
   // these are the functions not inherited from Algorithm
   virtual bool executeSelection( const xAOD::TruthParticleContainer* inTruthParts, float mcEvtWeight, bool count, std::string outContainerName );